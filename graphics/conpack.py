@@ -44,6 +44,34 @@ def convert_image(width, height, data, color):
 
 	return f_data
 
+# palette index used for masks, it is never lit
+mask_color = 14
+
+# shade 0 (black) to 3 (white) of every palette entry, from its luminance
+def palette_shades(colours):
+	shades = []
+	for index, rgb in enumerate(colours):
+		if index == mask_color:
+			shades.append(0)
+			continue
+		lum = (299 * rgb[0] + 587 * rgb[1] + 114 * rgb[2]) / 1000
+		shades.append((lum * 3 + 127) / 255)
+	return shades
+
+# splits a 2bit image into the screen and the shade plane of
+# ARDUBOY_GRAYSCALE, both as lists of 0 and 1 like a palette image
+#   shade:  0     1     2     3
+#   screen: 0     0     1     1
+#   plane:  0     1     1     0
+def split_planes(data, shades):
+	screen = []
+	plane = []
+	for c in data:
+		s = shades[c]
+		screen.append(1 if s >= 2 else 0)
+		plane.append(1 if s == 1 or s == 2 else 0)
+	return (screen, plane)
+
 def write_image_as_comment(width, height, data, frame, f, color):
 	f.write("/* [%u]" % frame)
 	for h in range(height):
@@ -264,9 +292,15 @@ if __name__ == "__main__":
 
 			size = ((height + 7) / 8) * width + 2
 
+			gray = "_gray" in img_name
 			if "_mask" in img_name:
-				color = 14
+				color = mask_color
 				print "%-40s" % (filename + "[mask]"),
+			elif gray:
+				# every frame becomes two, see split_planes()
+				color = 1
+				size *= 2
+				print "%-40s" % (filename + "[gray]"),
 			else:
 				color = 15
 				print "%-40s" % (filename),
@@ -279,7 +313,7 @@ if __name__ == "__main__":
 
 			total_size += size
 
-			images[img_name] = {"info": (filename, size, fh, fw)}
+			images[img_name] = {"info": (filename, size, fh, fw, color)}
 			images[img_name]["raw"] = {}
 			images[img_name]["target"] = {}
 			images[img_name]["packed"] = {}
@@ -290,10 +324,20 @@ if __name__ == "__main__":
 				foffset = frame_nr * fw
 				# copy each image and reshape to linear list
 				img = numpy.reshape(a[:,foffset:foffset+fw], fw*fh).tolist()
-				images[img_name]["raw"][frame_nr] = img
-				frame = convert_image(fw, fh, img, color)
-				update_dictionary(frame, cfile, data_dictionary)
-				images[img_name]["target"][frame_nr] = frame
+				if gray:
+					planes = split_planes(img, palette_shades(colours))
+				else:
+					planes = [img]
+				for p, plane in enumerate(planes):
+					nr = frame_nr * len(planes) + p
+					images[img_name]["raw"][nr] = plane
+					frame = convert_image(fw, fh, plane, color)
+					# gray images are only used by the host build of
+					# ARDUBOY_GRAYSCALE, keep them from changing the
+					# table and with it the size of all others
+					if not gray:
+						update_dictionary(frame, cfile, data_dictionary)
+					images[img_name]["target"][nr] = frame
 
 		sorted_dict = sorted(data_dictionary.items(), key=itemgetter(1), reverse = True)
 		dict_len = len(data_dictionary.keys())
@@ -350,7 +394,7 @@ if __name__ == "__main__":
 
 			packed_total_size += 2 + len(frame_offsets) * 2
 			for k2, v2 in v["raw"].iteritems():
-				write_image_as_comment(w, h, v2, k2, cfile, color)
+				write_image_as_comment(w, h, v2, k2, cfile, v["info"][4])
 
 				try:
 					print_hex_array(v["packed"][k2], cfile)
@@ -20,6 +20,7 @@ assets="mainscreen game_background enemy_little_girl water_bomb_air
 	bomb_explode
 	bomb_explode_mask
 	icon_a
+	game_background_gray
 "
 
 # assets that have a mask layer
@@ -45,7 +46,8 @@ do
 done
 fi
 
-# read all json files and convert them to C code
+# read all json files and convert them to C code, assets named *_gray are
+# converted to the two planes of ARDUBOY_GRAYSCALE
 ./conpack.py
 
 # copy C code images to source directory
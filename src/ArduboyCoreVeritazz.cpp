@@ -4,6 +4,84 @@
 volatile uint8_t *ArduboyCoreVeritazz::csport, *ArduboyCoreVeritazz::dcport;
 uint8_t ArduboyCoreVeritazz::cspinmask, ArduboyCoreVeritazz::dcpinmask;
 
+#ifndef HOST_TEST
+// the one panel of the AVR, see PANEL_STATIC
+uint8_t ArduboyCoreVeritazz::flashLeft;
+uint8_t ArduboyCoreVeritazz::shakeLeft, ArduboyCoreVeritazz::shakeFrames,
+  ArduboyCoreVeritazz::shakeAmplitude;
+uint8_t ArduboyCoreVeritazz::fadeLeft, ArduboyCoreVeritazz::fadeFrames,
+  ArduboyCoreVeritazz::fadeFrom, ArduboyCoreVeritazz::fadeTo;
+uint8_t ArduboyCoreVeritazz::scrollLeft;
+uint8_t ArduboyCoreVeritazz::contrast = OLED_CONTRAST_DEFAULT;
+bool ArduboyCoreVeritazz::displayOff;
+#ifdef ARDUBOY_ASYNC_DISPLAY
+unsigned long ArduboyCoreVeritazz::syncBytes;
+uint8_t ArduboyCoreVeritazz::txQueue[DISPLAY_QUEUE_SIZE];
+ArduboyCoreVeritazz::TransferSpan ArduboyCoreVeritazz::txSpans[DISPLAY_QUEUE_SPANS];
+volatile uint16_t ArduboyCoreVeritazz::txEnd;
+volatile uint8_t ArduboyCoreVeritazz::txSpanCount;
+volatile uint16_t ArduboyCoreVeritazz::txPos;
+volatile uint8_t ArduboyCoreVeritazz::txSpan;
+volatile uint8_t ArduboyCoreVeritazz::txSpanLeft;
+volatile bool ArduboyCoreVeritazz::txBusy;
+#endif
+#endif
+
+#ifdef HOST_TEST
+// the host talks to an emulated SSD1306 instead of the SPI bus, commandMode
+// stands in for the D/C pin
+extern void oled_transfer(const uint8_t *data, uint16_t size, bool command);
+// and the harness reads the keys
+extern uint8_t get_inputs(void);
+
+void ArduboyCoreVeritazz::spiTransfer(uint8_t data)
+{
+  oled_transfer(&data, 1, commandMode);
+}
+#else
+void ArduboyCoreVeritazz::spiTransfer(uint8_t data)
+{
+  SPI.transfer(data);
+}
+#endif
+
+#if defined(ARDUBOY_ASYNC_DISPLAY) && !defined(HOST_TEST)
+// sends the next byte of the queue, the byte before is completely sent at
+// this point, so it is safe to switch between command and data mode.  After
+// the last one the bus goes back to F_CPU/2 for synchronous transfers.
+void ArduboyCoreVeritazz::serviceTransfer()
+{
+  uint8_t left = txSpanLeft;
+
+  if (!left) {
+    uint8_t span = txSpan;
+
+    if (span == txSpanCount) {
+      // everybody else expects the OLED in data mode
+      SPCR &= ~(_BV(SPIE) | _BV(SPR0));
+      SPSR |= _BV(SPI2X);
+      LCDDataMode();
+      txBusy = false;
+      return;
+    }
+    if (txSpans[span].command)
+      LCDCommandMode();
+    else
+      LCDDataMode();
+    left = txSpans[span].length;
+    txSpan = span + 1;
+  }
+  SPDR = txQueue[txPos++];
+  txSpanLeft = left - 1;
+}
+
+ISR(SPI_STC_vect)
+{
+  ArduboyCoreVeritazz::serviceTransfer();
+}
+#endif
+
+#ifndef HOST_TEST
 const uint8_t PROGMEM pinBootProgram[] = {
   // buttons
   PIN_LEFT_BUTTON, INPUT_PULLUP,
@@ -23,6 +101,7 @@ const uint8_t PROGMEM pinBootProgram[] = {
   RST, OUTPUT,
   0
 };
+#endif
 
 const uint8_t PROGMEM lcdBootProgram[] = {
   // boot defaults are commented out but left here incase they
@@ -61,7 +140,7 @@ const uint8_t PROGMEM lcdBootProgram[] = {
   // 0xDA, 0x12,
 
   // Set Contrast v = 0xCF
-  0x81, 0xCF,
+  OLED_SET_CONTRAST, OLED_CONTRAST_DEFAULT,
 
   // Set Precharge = 0xF1
   0xD9, 0xF1,
@@ -89,7 +168,12 @@ const uint8_t PROGMEM lcdBootProgram[] = {
 };
 
 
-ArduboyCoreVeritazz::ArduboyCoreVeritazz() {}
+ArduboyCoreVeritazz::ArduboyCoreVeritazz()
+{
+#ifdef HOST_TEST
+  contrast = OLED_CONTRAST_DEFAULT;
+#endif
+}
 
 void ArduboyCoreVeritazz::boot()
 {
@@ -109,6 +193,8 @@ void ArduboyCoreVeritazz::boot()
   #endif
 
   bootPowerSaving();
+#else
+  bootOLED();
 #endif
 }
 
@@ -129,6 +215,7 @@ void ArduboyCoreVeritazz::setCPUSpeed8MHz()
 }
 #endif
 
+#ifndef HOST_TEST
 void ArduboyCoreVeritazz::bootPins()
 {
   uint8_t pin, mode;
@@ -147,9 +234,11 @@ void ArduboyCoreVeritazz::bootPins()
   delay(10);          // wait 10ms
   digitalWrite(RST, HIGH);  // bring out of reset
 }
+#endif
 
 void ArduboyCoreVeritazz::bootOLED()
 {
+#ifndef HOST_TEST
   // setup the ports we need to talk to the OLED
   csport = portOutputRegister(digitalPinToPort(CS));
   cspinmask = digitalPinToBitMask(CS);
@@ -157,31 +246,41 @@ void ArduboyCoreVeritazz::bootOLED()
   dcpinmask = digitalPinToBitMask(DC);
 
   SPI.setClockDivider(SPI_CLOCK_DIV2);
+#endif
 
   LCDCommandMode();
   // run our customized boot-up command sequence against the
   // OLED to initialize it properly for Arduboy
   for (int8_t i=0; i < sizeof(lcdBootProgram); i++) {
-    SPI.transfer(pgm_read_byte(lcdBootProgram + i));
+    spiTransfer(pgm_read_byte(lcdBootProgram + i));
   }
   LCDDataMode();
 }
 
 void ArduboyCoreVeritazz::LCDDataMode()
 {
+#ifndef HOST_TEST
   *dcport |= dcpinmask;
   *csport &= ~cspinmask;
+#else
+  commandMode = false;
+#endif
 }
 
 void ArduboyCoreVeritazz::LCDCommandMode()
 {
+#ifndef HOST_TEST
   *csport |= cspinmask;
   *dcport &= ~dcpinmask;
   *csport &= ~cspinmask;
+#else
+  commandMode = true;
+#endif
 }
 
 
 
+#ifndef HOST_TEST
 void ArduboyCoreVeritazz::safeMode()
 {
   blank(); // too avoid random gibberish
@@ -189,6 +288,7 @@ void ArduboyCoreVeritazz::safeMode()
     asm volatile("nop \n");
   }
 }
+#endif
 
 
 /* Power Management */
@@ -198,9 +298,13 @@ void ArduboyCoreVeritazz::idle()
 #ifndef HOST_TEST
   set_sleep_mode(SLEEP_MODE_IDLE);
   sleep_mode();
+#else
+  // like the timer 0 interrupt, wake up on the next millisecond
+  sleep_until(millis() + 1);
 #endif
 }
 
+#ifndef HOST_TEST
 void ArduboyCoreVeritazz::bootPowerSaving()
 {
   power_adc_disable();
@@ -213,6 +317,7 @@ void ArduboyCoreVeritazz::bootPowerSaving()
   // we need USB, for now (to allow triggered reboots to reprogram)
   // power_usb_disable()
 }
+#endif
 
 uint8_t ArduboyCoreVeritazz::width() { return WIDTH; }
 
@@ -223,29 +328,42 @@ uint8_t ArduboyCoreVeritazz::height() { return HEIGHT; }
 
 void ArduboyCoreVeritazz::paint8Pixels(uint8_t pixels)
 {
-  SPI.transfer(pixels);
+  waitTransfer();
+  spiTransfer(pixels);
 }
 
 void ArduboyCoreVeritazz::paintScreen(const unsigned char *image)
 {
+  waitTransfer();
   for (int i = 0; i < (HEIGHT*WIDTH)/8; i++)
   {
-    SPI.transfer(pgm_read_byte(image + i));
+    spiTransfer(pgm_read_byte(image + i));
   }
 }
 
+void ArduboyCoreVeritazz::paintScreen(unsigned char image[])
+{
+  paintScreen(image, (HEIGHT * WIDTH) / 8);
+}
+
+#ifdef HOST_TEST
+void ArduboyCoreVeritazz::spiSend(const uint8_t *image, uint16_t size)
+{
+  oled_transfer(image, size, commandMode);
+}
+#else
 // paint from a memory buffer, this should be FAST as it's likely what
 // will be used by any buffer based subclass
-void ArduboyCoreVeritazz::paintScreen(unsigned char image[])
+void ArduboyCoreVeritazz::spiSend(const uint8_t *image, uint16_t size)
 {
   uint8_t c;
-  int i = 0;
+  uint16_t i = 0;
 
   SPDR = image[i++]; // set the first SPI data byte to get things started
 
   // the code to iterate the loop and get the next byte from the buffer is
   // executed while the previous byte is being sent out by the SPI controller
-  while (i < (HEIGHT * WIDTH) / 8)
+  while (i < size)
   {
     // get the next byte. It's put in a local variable so it can be sent as
     // as soon as possible after the sending of the previous byte has completed
@@ -259,22 +377,246 @@ void ArduboyCoreVeritazz::paintScreen(unsigned char image[])
   }
   while (!(SPSR & _BV(SPIF))) { } // wait for the last byte to be sent
 }
+#endif
+
+void ArduboyCoreVeritazz::paintScreen(unsigned char image[], uint16_t size)
+{
+#ifdef ARDUBOY_ASYNC_DISPLAY
+  queueTransfer(image, size, false);
+#else
+  spiSend(image, size);
+#endif
+}
+
+#ifdef ARDUBOY_GRAYSCALE
+void ArduboyCoreVeritazz::paintPlanes(const uint8_t *a, const uint8_t *b)
+{
+#ifdef HOST_TEST
+  uint8_t image[(HEIGHT*WIDTH)/8];
+
+  for (uint16_t i = 0; i < sizeof(image); i++)
+    image[i] = a[i] ^ b[i];
+  spiSend(image, sizeof(image));
+#else
+  uint8_t c;
+  uint16_t i;
+
+  // same as spiSend(), the XOR is done while the last byte goes out
+  SPDR = a[0] ^ b[0];
+  for (i = 1; i < (HEIGHT*WIDTH)/8; i++)
+  {
+    c = a[i] ^ b[i];
+    while (!(SPSR & _BV(SPIF))) { }
+    SPDR = c;
+  }
+  while (!(SPSR & _BV(SPIF))) { }
+#endif
+}
+#endif
 
 void ArduboyCoreVeritazz::blank()
 {
-#ifndef HOST_TEST
+  waitTransfer();
   for (int i = 0; i < (HEIGHT*WIDTH)/8; i++)
-    SPI.transfer(0x00);
-#endif
+    spiTransfer(0x00);
 }
 
 void ArduboyCoreVeritazz::sendLCDCommand(uint8_t command)
 {
+  waitTransfer();
+  LCDCommandMode();
+  spiTransfer(command);
+  LCDDataMode();
+}
+
+/* Effects */
+
+void ArduboyCoreVeritazz::flash(uint8_t frames)
+{
+  if (!flashLeft)
+    invert(true);
+  if (frames > flashLeft)
+    flashLeft = frames;
+}
+
+void ArduboyCoreVeritazz::shake(uint8_t frames, uint8_t amplitude)
+{
+  shakeLeft = shakeFrames = frames;
+  shakeAmplitude = amplitude;
+}
+
+void ArduboyCoreVeritazz::fade(uint8_t level, uint8_t frames)
+{
+  if (displayOff) {
+    sendLCDCommand(OLED_DISPLAY_ON);
+    displayOff = false;
+  }
+  fadeFrom = contrast;
+  fadeTo = level;
+  fadeLeft = fadeFrames = frames ? frames : 1;
+}
+
+void ArduboyCoreVeritazz::hardwareScroll
+(uint8_t page0, uint8_t page1, bool left, uint8_t interval, uint8_t frames)
+{
+  if (!frames)
+    return;
+  sendLCDCommand(OLED_SCROLL_STOP);
+  sendLCDCommand(left ? OLED_SCROLL_LEFT : OLED_SCROLL_RIGHT);
+  sendLCDCommand(0x00);
+  sendLCDCommand(page0);
+  sendLCDCommand(interval);
+  sendLCDCommand(page1);
+  sendLCDCommand(0x00);
+  sendLCDCommand(0xFF);
+  sendLCDCommand(OLED_SCROLL_START);
+  scrollLeft = frames;
+}
+
+uint8_t ArduboyCoreVeritazz::updateEffects()
+{
+  uint8_t flags = 0;
+
+  if (flashLeft && !--flashLeft)
+    invert(false);
+
+  if (shakeLeft) {
+    // alternate between moving up and down, less and less
+    uint8_t offset = (uint16_t)shakeAmplitude * --shakeLeft / shakeFrames;
+
+    if (offset && (shakeLeft & 1))
+      offset = HEIGHT - offset;
+    sendLCDCommand(OLED_SET_DISPLAY_OFFSET);
+    sendLCDCommand(offset);
+  }
+
+  if (fadeLeft) {
+    fadeLeft--;
+    contrast = fadeTo + ((int16_t)fadeFrom - fadeTo) * fadeLeft / fadeFrames;
+    sendLCDCommand(OLED_SET_CONTRAST);
+    sendLCDCommand(contrast);
+    if (!fadeLeft && !contrast) {
+      sendLCDCommand(OLED_DISPLAY_OFF);
+      displayOff = true;
+    }
+  }
+
+  if (scrollLeft) {
+    if (--scrollLeft) {
+      flags |= EFFECTS_SCROLLING;
+    } else {
+      sendLCDCommand(OLED_SCROLL_STOP);
+      flags |= EFFECTS_RAM_CHANGED;
+    }
+  }
+
+  if (flashLeft || shakeLeft || fadeLeft || scrollLeft)
+    flags |= EFFECTS_ACTIVE;
+  return flags;
+}
+
+void ArduboyCoreVeritazz::setWindow
+(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1)
+{
+  uint8_t cmd[] = {
+    OLED_SET_COLUMN_ADDRESS, col0, col1,
+    OLED_SET_PAGE_ADDRESS, page0, page1
+  };
+
+#ifdef ARDUBOY_ASYNC_DISPLAY
+  queueTransfer(cmd, sizeof(cmd), true);
+#else
   LCDCommandMode();
-  SPI.transfer(command);
+  spiSend(cmd, sizeof(cmd));
   LCDDataMode();
+#endif
+}
+
+void ArduboyCoreVeritazz::startTransfer()
+{
+#ifdef ARDUBOY_ASYNC_DISPLAY
+  if (txBusy || txPos == txEnd)
+    return;
+#ifndef HOST_TEST
+  // the queue is complete before the interrupt may look at it
+  asm volatile("" ::: "memory");
+  txBusy = true;
+  // at F_CPU/2 a byte is sent in 16 cycles, less than entering and leaving
+  // the interrupt takes, and the sketch would hardly get a cycle in between.
+  // At F_CPU/16 a byte takes 128 cycles and about two thirds of them are
+  // left to the sketch.  Reading SPSR and then writing SPDR also clears a
+  // SPIF left over from synchronous transfers, the interrupt would fire
+  // right away otherwise.
+  SPSR &= ~_BV(SPI2X);
+  SPCR |= _BV(SPR0);
+  serviceTransfer();
+  SPCR |= _BV(SPIE);
+#else
+  // the emulated OLED takes it all at once
+  for (uint8_t i = 0; i < txSpanCount; i++) {
+    oled_transfer(txQueue + txPos, txSpans[i].length, txSpans[i].command);
+    txPos += txSpans[i].length;
+  }
+#endif
+#endif
+}
+
+bool ArduboyCoreVeritazz::transferBusy()
+{
+#ifdef ARDUBOY_ASYNC_DISPLAY
+  return txBusy;
+#else
+  return false;
+#endif
 }
 
+void ArduboyCoreVeritazz::waitTransfer()
+{
+#ifdef ARDUBOY_ASYNC_DISPLAY
+  while (txBusy) { }
+#endif
+}
+
+#ifdef ARDUBOY_ASYNC_DISPLAY
+void ArduboyCoreVeritazz::queueTransfer
+(const uint8_t *data, uint16_t size, bool command)
+{
+  uint8_t spans = (size + 254) / 255;
+
+  // the queue is only touched while the interrupt is idle, usually the
+  // last frame is long sent when the next one is queued
+  waitTransfer();
+  if (txPos == txEnd) {
+    txPos = txEnd = 0;
+    txSpan = txSpanCount = 0;
+  }
+
+  if (size > DISPLAY_QUEUE_SIZE - txEnd ||
+      spans > DISPLAY_QUEUE_SPANS - txSpanCount) {
+    // keep the order, first what is queued, then these bytes
+    startTransfer();
+    waitTransfer();
+    syncBytes += size;
+    if (command)
+      LCDCommandMode();
+    spiSend(data, size);
+    LCDDataMode();
+    return;
+  }
+
+  memcpy(txQueue + txEnd, data, size);
+  txEnd += size;
+  while (size) {
+    uint8_t length = size > 255 ? 255 : size;
+
+    txSpans[txSpanCount].length = length;
+    txSpans[txSpanCount].command = command;
+    txSpanCount++;
+    size -= length;
+  }
+}
+#endif
+
 // invert the display or set to normal
 // when inverted, a pixel set to 0 will be on
 void ArduboyCoreVeritazz::invert(bool inverse)
@@ -305,7 +647,9 @@ void ArduboyCoreVeritazz::flipHorizontal(bool flipped)
 
 void ArduboyCoreVeritazz::setRGBled(uint8_t red, uint8_t green, uint8_t blue)
 {
-#ifdef ARDUBOY_10 // RGB, all the pretty colors
+#ifdef HOST_TEST
+  // no LED on the host
+#elif defined(ARDUBOY_10) // RGB, all the pretty colors
   // inversion is necessary because these are common annode LEDs
   analogWrite(RED_LED, 255 - red);
   analogWrite(GREEN_LED, 255 - green);
@@ -329,7 +673,9 @@ uint8_t ArduboyCoreVeritazz::buttonsState()
   uint8_t buttons;
 
   // using ports here is ~100 bytes smaller than digitalRead()
-#ifdef AB_DEVKIT
+#ifdef HOST_TEST
+  buttons = get_inputs();
+#elif defined(AB_DEVKIT)
   // down, left, up
   buttons = ((~PINB) & B01110000);
   // right button
@@ -10,6 +10,7 @@
 #else
 
 #include <time.h>
+#include <errno.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -17,11 +18,33 @@
 
 #define PROGMEM
 #define pgm_read_word(a)		*((uint16_t *)(a))
+#define pgm_read_dword(a)		*((uint32_t *)(a))
 #define pgm_read_byte(a)		*((uint8_t *)(a))
 #define _BV(bit)			(1 << (bit))
 #define min(a, b)			((a) < (b)? (a): (b))
 #define max(a, b)			((a) > (b)? (a): (b))
 
+#ifdef HOST_HEADLESS
+/* the harness owns the clock, time only passes while the game waits */
+extern __thread unsigned long host_millis;
+
+static inline unsigned long millis(void)
+{
+	return host_millis;
+}
+
+/* waiting jumps to the deadline */
+static inline void sleep_until(unsigned long ms)
+{
+	if (host_millis < ms)
+		host_millis = ms;
+}
+
+static inline void delay(unsigned int ms)
+{
+	host_millis += ms;
+}
+#else
 static inline unsigned long millis(void)
 {
 	struct timespec ts;
@@ -29,14 +52,32 @@ static inline unsigned long millis(void)
 	return ((ts.tv_sec * 1000) + (ts.tv_nsec / 1000000));
 }
 
+/* sleeps until millis() reaches ms instead of spinning */
+static inline void sleep_until(unsigned long ms)
+{
+	struct timespec ts;
+
+	ts.tv_sec = ms / 1000;
+	ts.tv_nsec = (ms % 1000) * 1000000L;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+		;
+}
+
 static inline void delay(unsigned int ms)
 {
-	unsigned long cur;
-	unsigned long end = millis() + ms;
-	do {
-		cur = millis();
-	} while (cur < end);
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	ts.tv_sec += ms / 1000;
+	ts.tv_nsec += (ms % 1000) * 1000000L;
+	if (ts.tv_nsec >= 1000000000L) {
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+		;
 }
+#endif
 
 #endif
 
@@ -157,6 +198,67 @@ static inline void delay(unsigned int ms)
 #define OLED_HORIZ_FLIPPED 0xA0 // reversed segment re-map
 #define OLED_HORIZ_NORMAL 0xA1 // normal segment re-map
 
+#define OLED_SET_COLUMN_ADDRESS 0x21 // followed by start and end column
+#define OLED_SET_PAGE_ADDRESS 0x22 // followed by start and end page
+
+#define OLED_SET_CONTRAST 0x81 // followed by the contrast
+#define OLED_CONTRAST_DEFAULT 0xCF // contrast set by boot()
+#define OLED_DISPLAY_OFF 0xAE
+#define OLED_DISPLAY_ON 0xAF
+#define OLED_SET_DISPLAY_OFFSET 0xD3 // followed by the first COM line, 0-63
+
+#define OLED_SCROLL_RIGHT 0x26 // followed by 0, page0, interval, page1, 0, 0xFF
+#define OLED_SCROLL_LEFT 0x27  // same as OLED_SCROLL_RIGHT
+#define OLED_SCROLL_STOP 0x2E
+#define OLED_SCROLL_START 0x2F
+
+// Hardware scroll intervals, in frames of the OLED itself
+#define OLED_SCROLL_2_FRAMES 0x07
+#define OLED_SCROLL_3_FRAMES 0x04
+#define OLED_SCROLL_4_FRAMES 0x05
+#define OLED_SCROLL_5_FRAMES 0x00
+#define OLED_SCROLL_25_FRAMES 0x06
+#define OLED_SCROLL_64_FRAMES 0x01
+#define OLED_SCROLL_128_FRAMES 0x02
+#define OLED_SCROLL_256_FRAMES 0x03
+
+// Flags returned by updateEffects()
+#define EFFECTS_ACTIVE 0x01       // an effect is running
+#define EFFECTS_SCROLLING 0x02    // the display RAM must not be written
+#define EFFECTS_RAM_CHANGED 0x04  // the display RAM was moved by a scroll
+
+// Asynchronous display transfer
+//
+// With ARDUBOY_ASYNC_DISPLAY paintScreen() and setWindow() copy their bytes
+// into a queue which the SPI transfer complete interrupt sends, one byte per
+// interrupt, so display() returns right away and the sketch runs while the
+// bytes go out.  The AVR has no DMA, so the bus is slowed down to F_CPU/16
+// during the transfer to leave the sketch time between the interrupts, and
+// the USART in SPI mode cannot help, it is not wired to the OLED.  The
+// queue is much smaller than a second frame buffer, so only the changed
+// parts of the screen are sent (ARDUBOY_PARTIAL_UPDATE is turned on).
+// Whatever does not fit into the queue is sent synchronously once the
+// queue has drained.
+#ifdef ARDUBOY_ASYNC_DISPLAY
+#ifndef ARDUBOY_PARTIAL_UPDATE
+#define ARDUBOY_PARTIAL_UPDATE
+#endif
+#ifndef DISPLAY_QUEUE_SIZE
+#define DISPLAY_QUEUE_SIZE 256
+#endif
+#define DISPLAY_QUEUE_SPANS 32
+#endif
+
+// The state of the panel, the effects, the D/C pin of the host and the
+// transfer queue, is static on the AVR with its one panel.  On the host
+// every game context holds a panel of its own, there the state and the
+// functions using it are members of the instance.
+#ifdef HOST_TEST
+#define PANEL_STATIC
+#else
+#define PANEL_STATIC static
+#endif
+
 // -----
 
 #define WIDTH 128
@@ -184,7 +286,7 @@ public:
      */
     void static idle();
 
-    void static LCDDataMode(); //< put the display in data mode
+    void PANEL_STATIC LCDDataMode(); //< put the display in data mode
 
     /// put the display in command mode
     /**
@@ -194,7 +296,7 @@ public:
      * - https://www.adafruit.com/datasheets/SSD1306.pdf
      * - http://www.eimodule.com/download/SSD1306-OLED-Controller.pdf
      */
-    void static LCDCommandMode();
+    void PANEL_STATIC LCDCommandMode();
 
     uint8_t static width();    //< return display width
     uint8_t static height();   // < return display height
@@ -247,46 +349,127 @@ public:
     // ........                     X.X.....
     // ........ (end of page 1)     X.X..... (end of page 1)
     // ........ (page 2)            ........ (page 2)
-    void static paint8Pixels(uint8_t pixels);
+    void PANEL_STATIC paint8Pixels(uint8_t pixels);
 
     /// paints an entire image directly to hardware (from PROGMEM)
     /*
      * Each byte will be 8 vertical pixels, painted in the same order as
      * explained above in paint8Pixels.
      */
-    void static paintScreen(const unsigned char *image);
+    void PANEL_STATIC paintScreen(const unsigned char *image);
 
     /// paints an entire image directly to hardware (from RAM)
     /*
      * Each byte will be 8 vertical pixels, painted in the same order as
      * explained above in paint8Pixels.
      */
-    void static paintScreen(unsigned char image[]);
+    void PANEL_STATIC paintScreen(unsigned char image[]);
+
+    /// paints size bytes from a memory buffer to hardware
+    /*
+     * Continues where the previous transfer stopped, so a screen can be
+     * streamed in several parts, e.g. one page at a time.
+     */
+    void PANEL_STATIC paintScreen(unsigned char image[], uint16_t size);
+
+#ifdef ARDUBOY_GRAYSCALE
+    /// paints the XOR of two full screen buffers to hardware
+    /*
+     * Sends the second grayscale plane without touching either buffer.
+     */
+    void PANEL_STATIC paintPlanes(const uint8_t *a, const uint8_t *b);
+#endif
 
     /// paints a blank (black) screen to hardware
-    void static blank();
+    void PANEL_STATIC blank();
 
     /// invert the display or set to normal
     /**
      * when inverted, a pixel set to 0 will be on
      */
-    void static invert(bool inverse);
+    void PANEL_STATIC invert(bool inverse);
 
     /// turn all display pixels on, or display the buffer contents
     /**
      * when set to all pixels on, the display buffer will be
      * ignored but not altered
      */
-    void static allPixelsOn(bool on);
+    void PANEL_STATIC allPixelsOn(bool on);
 
     /// flip the display vertically or set to normal
-    void static flipVertical(bool flipped);
+    void PANEL_STATIC flipVertical(bool flipped);
 
     /// flip the display horizontally or set to normal
-    void static flipHorizontal(bool flipped);
+    void PANEL_STATIC flipHorizontal(bool flipped);
 
     /// send a single byte command to the OLED
-    void static sendLCDCommand(uint8_t command);
+    void PANEL_STATIC sendLCDCommand(uint8_t command);
+
+    /// Effects
+    /**
+     * The effects below are done by the display controller, so they cost no
+     * drawing at all.  They are started at any time and advanced by
+     * updateEffects() once per frame, ArduboyVeritazz::display() does that.
+     */
+
+    /// inverts the screen for the given number of frames
+    void PANEL_STATIC flash(uint8_t frames);
+
+    /// moves the screen up and down, calming down over the given frames
+    void PANEL_STATIC shake(uint8_t frames, uint8_t amplitude);
+
+    /// changes the contrast to level over the given frames
+    /**
+     * Even at contrast 0 the OLED still shows something, so a fade to 0 turns
+     * the display off at the end and the next fade turns it on again.
+     */
+    void PANEL_STATIC fade(uint8_t level, uint8_t frames);
+
+    /// scrolls pages page0 to page1 by one column every interval
+    /**
+     * interval is one of OLED_SCROLL_*_FRAMES.  The controller moves the
+     * display RAM itself and it must not be written to while scrolling, so
+     * the screen is frozen for the given number of frames.  Afterwards the
+     * RAM holds the scrolled content.
+     */
+    void PANEL_STATIC hardwareScroll(uint8_t page0, uint8_t page1, bool left,
+                               uint8_t interval, uint8_t frames);
+
+    /// advances the running effects by one frame, returns EFFECTS_* flags
+    uint8_t PANEL_STATIC updateEffects();
+
+    /// restrict where following paint calls go to
+    /**
+     * Data sent afterwards fills columns col0 to col1 of pages page0 to
+     * page1, wrapping at the end of each page like the full screen does.
+     */
+    void PANEL_STATIC setWindow(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1);
+
+    /// starts sending the bytes queued since the last transfer
+    /**
+     * Only does something with ARDUBOY_ASYNC_DISPLAY, otherwise all
+     * transfers are done by the time the paint functions return.
+     */
+    void PANEL_STATIC startTransfer();
+
+    /// true while queued bytes are still being sent
+    bool PANEL_STATIC transferBusy();
+
+    /// waits until all queued bytes are sent
+    /**
+     * Everything that talks to the OLED directly calls this first.
+     */
+    void PANEL_STATIC waitTransfer();
+
+#ifdef ARDUBOY_ASYNC_DISPLAY
+    /// bytes sent synchronously because they did not fit into the queue
+    PANEL_STATIC unsigned long syncBytes;
+
+#ifndef HOST_TEST
+    /// sends the next byte of the queue, from the SPI interrupt
+    void static serviceTransfer();
+#endif
+#endif
 
     /// set the light output of the RGB LEB
     void setRGBled(uint8_t red, uint8_t green, uint8_t blue);
@@ -299,7 +482,7 @@ public:
      * - kicks CPU down to 8Mhz if needed
      * - allows Safe mode to be entered
      */
-    void static boot();
+    void PANEL_STATIC boot();
 
 protected:
 
@@ -318,10 +501,55 @@ protected:
 
     // internals
     void static inline setCPUSpeed8MHz() __attribute__((always_inline));
-    void static inline bootOLED() __attribute__((always_inline));
+    void PANEL_STATIC inline bootOLED() __attribute__((always_inline));
     void static inline bootPins() __attribute__((always_inline));
     void static inline bootPowerSaving() __attribute__((always_inline));
 
+#ifdef ARDUBOY_ASYNC_DISPLAY
+    /// appends bytes to the transfer queue, sends them now if it is full
+    void PANEL_STATIC queueTransfer(const uint8_t *data, uint16_t size, bool command);
+#endif
+
+    // one byte or size bytes to the OLED, as command or data by the D/C pin
+    void PANEL_STATIC inline spiTransfer(uint8_t data);
+    void PANEL_STATIC spiSend(const uint8_t *image, uint16_t size);
+
+    // frames left and total of the running effects, 0 if not running
+    PANEL_STATIC uint8_t flashLeft;
+    PANEL_STATIC uint8_t shakeLeft, shakeFrames, shakeAmplitude;
+    PANEL_STATIC uint8_t fadeLeft, fadeFrames, fadeFrom, fadeTo;
+    PANEL_STATIC uint8_t scrollLeft;
+    PANEL_STATIC uint8_t contrast;
+    PANEL_STATIC bool displayOff;
+
+#ifdef HOST_TEST
+    // stands in for the D/C pin
+    bool commandMode;
+#endif
+
+#ifdef ARDUBOY_ASYNC_DISPLAY
+    // a run of command or data bytes in the transfer queue
+    struct TransferSpan
+    {
+      uint8_t length;
+      bool command;
+    };
+
+    // shared with the SPI interrupt, it only runs while txBusy is set and
+    // the queue is only changed while it is not.  The counters are volatile,
+    // the bytes and spans are not: they are only written while the
+    // interrupt is idle and startTransfer() has a compiler barrier before
+    // it sets txBusy.
+    PANEL_STATIC uint8_t txQueue[DISPLAY_QUEUE_SIZE];
+    PANEL_STATIC TransferSpan txSpans[DISPLAY_QUEUE_SPANS];
+    PANEL_STATIC volatile uint16_t txEnd;          // bytes queued
+    PANEL_STATIC volatile uint8_t txSpanCount;     // spans queued
+    PANEL_STATIC volatile uint16_t txPos;          // next byte to send
+    PANEL_STATIC volatile uint8_t txSpan;          // next span to send
+    PANEL_STATIC volatile uint8_t txSpanLeft;      // bytes left of the current one
+    PANEL_STATIC volatile bool txBusy;
+#endif
+
 
 private:
     volatile static uint8_t *csport, *dcport;
@@ -7,6 +7,36 @@ ArduboyVeritazz::ArduboyVeritazz()
   frameCount = 0;
   nextFrameStart = 0;
   post_render = false;
+  frameHeld = false;
+  drawContext = NULL;
+
+  // drawing goes to the screen unless told otherwise
+#ifdef ARDUBOY_STRIP_RENDERING
+  initSurface(&screen, sBuffer, WIDTH, 1);
+  drawListCount = 0;
+  drawListPeak = 0;
+  drawListOverflows = 0;
+  replaying = false;
+#else
+  initSurface(&screen, sBuffer, WIDTH, HEIGHT/8);
+#endif
+  target = &screen;
+#ifdef ARDUBOY_GRAYSCALE
+  initSurface(&shade, shadeBuffer, WIDTH, HEIGHT/8);
+  shadePending = false;
+  clearPending = false;
+#endif
+
+#ifdef ARDUBOY_PARTIAL_UPDATE
+  screen.dirty = dirtyPages;
+  for (uint8_t page = 0; page < HEIGHT/8; page++) {
+    dirtyPages[page].first = dirtyPages[page].litFirst = 0;
+    dirtyPages[page].last = dirtyPages[page].litLast = WIDTH - 1;
+  }
+  sweepSegment = 0;
+  bytesSent = 0;
+  hashesValid = false;
+#endif
 
   // init not necessary, will be reset after first use
   // lastFrameStart
@@ -50,7 +80,6 @@ uint8_t ArduboyVeritazz::everyXFrames(uint8_t frames)
 uint8_t ArduboyVeritazz::nextFrame()
 {
   long now = millis();
-  uint8_t remaining;
 
   // post render
   if (post_render) {
@@ -59,13 +88,33 @@ uint8_t ArduboyVeritazz::nextFrame()
     post_render = false;
   }
 
+#ifdef ARDUBOY_GRAYSCALE
+  // the last third of a frame shows the shade plane, a late frame still
+  // gets it before the next one starts
+  if (shadePending && (now - shadeStart >= eachFrameMillis*2/3 ||
+                       now >= nextFrameStart)) {
+    paintPlanes(sBuffer, shadeBuffer);
+    shadePending = false;
+  }
+#endif
+
   // if it's not time for the next frame yet
   if (now < nextFrameStart) {
-    remaining = nextFrameStart - now;
+#ifdef HOST_TEST
+    // sleep through to the frame, or to the shade plane if it comes first
+    long wake = nextFrameStart;
+#ifdef ARDUBOY_GRAYSCALE
+    if (shadePending && shadeStart + eachFrameMillis*2/3 < wake)
+      wake = shadeStart + eachFrameMillis*2/3;
+#endif
+    sleep_until(wake);
+#else
+    uint8_t remaining = nextFrameStart - now;
     // if we have more than 1ms to spare, lets sleep
     // we should be woken up by timer0 every 1ms, so this should be ok
     if (remaining > 1)
       idle();
+#endif
 
     return false;
   }
@@ -132,13 +181,45 @@ uint16_t ArduboyVeritazz::rawADC(uint8_t adc_bits)
 
 void ArduboyVeritazz::clear()
 {
+#ifdef ARDUBOY_GRAYSCALE
+  if (target == &screen) {
+    clearPending = true;
+    return;
+  }
+#endif
   fillScreen(BLACK);
 }
 
+#ifdef ARDUBOY_GRAYSCALE
+void ArduboyVeritazz::finishClear()
+{
+  Surface *t = target;
+
+  clearPending = false;
+  memset(shadeBuffer, 0, sizeof(shadeBuffer));
+  target = &screen;
+  fillScreen(BLACK);
+  target = t;
+}
+#endif
+
 void ArduboyVeritazz::drawPixel(int x, int y, uint8_t color)
 {
+  Surface *s = drawTarget();
+
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    DrawCommand *c = record(DRAW_OP_PIXEL, x, y);
+    if (c) {
+      c->rect.color = color;
+    }
+    return;
+  }
+#endif
+
   #ifdef PIXEL_SAFE_MODE
-  if (x < 0 || x > (WIDTH-1) || y < 0 || y > (HEIGHT-1))
+  if (x < s->clipX || x >= s->clipX + s->clipW ||
+      y < s->clipY || y >= s->clipY + s->clipH)
   {
     return;
   }
@@ -147,19 +228,22 @@ void ArduboyVeritazz::drawPixel(int x, int y, uint8_t color)
   uint8_t row = (uint8_t)y / 8;
   if (color)
   {
-    sBuffer[(row*WIDTH) + (uint8_t)x] |=   _BV((uint8_t)y % 8);
+    s->buffer[(row*s->width) + (uint8_t)x] |=   _BV((uint8_t)y % 8);
   }
   else
   {
-    sBuffer[(row*WIDTH) + (uint8_t)x] &= ~ _BV((uint8_t)y % 8);
+    s->buffer[(row*s->width) + (uint8_t)x] &= ~ _BV((uint8_t)y % 8);
   }
+  markDirty(s, row, x, x, color);
 }
 
 uint8_t ArduboyVeritazz::getPixel(uint8_t x, uint8_t y)
 {
   uint8_t row = y / 8;
   uint8_t bit_position = y % 8;
-  return (sBuffer[(row*WIDTH) + x] & _BV(bit_position)) >> bit_position;
+  Surface *s = drawTarget();
+
+  return (s->buffer[(row*s->width) + x] & _BV(bit_position)) >> bit_position;
 }
 
 void ArduboyVeritazz::drawCircle(int16_t x0, int16_t y0, uint8_t r, uint8_t color)
@@ -342,6 +426,18 @@ void ArduboyVeritazz::drawLine
 void ArduboyVeritazz::drawRect
 (int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t color)
 {
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    DrawCommand *c = record(DRAW_OP_RECT, x, y);
+    if (c) {
+      c->rect.w = w;
+      c->rect.h = h;
+      c->rect.color = color;
+    }
+    return;
+  }
+#endif
+
   drawFastHLine(x, y, w, color);
   drawFastHLine(x, y+h-1, w, color);
   drawFastVLine(x, y, h, color);
@@ -351,8 +447,19 @@ void ArduboyVeritazz::drawRect
 void ArduboyVeritazz::drawFastVLine
 (int16_t x, int16_t y, uint8_t h, uint8_t color)
 {
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    DrawCommand *c = record(DRAW_OP_VLINE, x, y);
+    if (c) {
+      c->rect.h = h;
+      c->rect.color = color;
+    }
+    return;
+  }
+#endif
+
   int end = y+h;
-  for (int a = max(0,y); a < min(end,HEIGHT); a++)
+  for (int a = max(target->clipY,y); a < min(end,target->clipY+target->clipH); a++)
   {
     drawPixel(x,a,color);
   }
@@ -361,29 +468,44 @@ void ArduboyVeritazz::drawFastVLine
 void ArduboyVeritazz::drawFastHLine
 (int16_t x, int16_t y, uint8_t w, uint8_t color)
 {
+  Surface *s = drawTarget();
+  int16_t xe = x + w;
+
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    DrawCommand *c = record(DRAW_OP_HLINE, x, y);
+    if (c) {
+      c->rect.w = w;
+      c->rect.color = color;
+    }
+    return;
+  }
+#endif
+
   // Do bounds/limit checks
-  if (y < 0 || y >= HEIGHT) {
+  if (y < s->clipY || y >= s->clipY + s->clipH) {
     return;
   }
 
-  // make sure we don't try to draw below 0
-  if (x < 0) {
-    w += x;
-    x = 0;
+  // make sure we don't try to draw left of the clip rectangle
+  if (x < s->clipX) {
+    x = s->clipX;
   }
 
-  // make sure we don't go off the edge of the display
-  if ((x + w) > WIDTH) {
-    w = (WIDTH - x);
+  // make sure we don't go off the right edge of it
+  if (xe > s->clipX + s->clipW) {
+    xe = s->clipX + s->clipW;
   }
 
   // if our width is now negative, punt
-  if (w <= 0) {
+  if (xe <= x) {
     return;
   }
+  w = xe - x;
+  markDirty(s, y/8, x, xe - 1, color);
 
   // buffer pointer plus row offset + x offset
-  register uint8_t *pBuf = sBuffer + ((y/8) * WIDTH) + x;
+  register uint8_t *pBuf = s->buffer + ((y/8) * s->width) + x;
 
   // pixel mask
   register uint8_t mask = 1 << (y&7);
@@ -408,6 +530,18 @@ void ArduboyVeritazz::drawFastHLine
 void ArduboyVeritazz::fillRect
 (int16_t x, int16_t y, uint8_t w, uint8_t h, uint8_t color)
 {
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    DrawCommand *c = record(DRAW_OP_FILL_RECT, x, y);
+    if (c) {
+      c->rect.w = w;
+      c->rect.h = h;
+      c->rect.color = color;
+    }
+    return;
+  }
+#endif
+
   // stupidest version - update in subclasses if desired!
   for (int16_t i=x; i<x+w; i++)
   {
@@ -417,6 +551,28 @@ void ArduboyVeritazz::fillRect
 
 void ArduboyVeritazz::fillScreen(uint8_t color)
 {
+  Surface *s = drawTarget();
+
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    // whatever was recorded so far is covered now
+    drawListCount = 0;
+    if (color)
+      record(DRAW_OP_FILL_SCREEN, 0, 0);
+    return;
+  }
+#endif
+
+  // a clipped surface only gets its clip rectangle filled
+  if (s->clipX || s->clipY || s->clipW != s->width || s->clipH != s->pages * 8) {
+    fillRect(s->clipX, s->clipY, s->clipW, s->clipH, color);
+    return;
+  }
+
+  markFilled(s, color);
+  if (color) color = 0xFF;  //change any nonzero argument to b11111111 and insert into screen array.
+#ifndef ARDUBOY_STRIP_RENDERING
+  if (s->buffer == sBuffer) {
 #ifndef HOST_TEST
   // C version :
   //
@@ -453,9 +609,12 @@ void ArduboyVeritazz::fillScreen(uint8_t color)
     : "r30", "r31", "r27"
   );
 #else
-  if (color) color = 0xFF;  //change any nonzero argument to b11111111 and insert into screen array.
   memset(sBuffer, color, WIDTH * HEIGHT / 8);
 #endif
+    return;
+  }
+#endif
+  memset(s->buffer, color, s->width * s->pages);
 }
 
 void ArduboyVeritazz::drawRoundRect
@@ -599,47 +758,164 @@ void ArduboyVeritazz::drawBitmap
 (int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h,
  uint8_t color)
 {
-  // no need to dar at all of we're offscreen
-  if (x+w < 0 || x > WIDTH-1 || y+h < 0 || y > HEIGHT-1)
+  Surface *s = drawTarget();
+
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    DrawCommand *c = record(DRAW_OP_BITMAP, x, y);
+    if (c) {
+      c->bitmap.data = bitmap;
+      c->bitmap.w = w;
+      c->bitmap.h = h;
+      c->bitmap.color = color;
+    }
     return;
-
-  int yOffset = abs(y) % 8;
-  int sRow = y / 8;
-  if (y < 0) {
-    sRow--;
-    yOffset = 8 - yOffset;
   }
+#endif
+
+  // no need to dar at all of we're outside of the clip rectangle
+  if (x+w <= s->clipX || x >= s->clipX+s->clipW ||
+      y+h <= s->clipY || y >= s->clipY+s->clipH)
+    return;
+
   int rows = h/8;
   if (h%8!=0) rows++;
   for (int a = 0; a < rows; a++) {
-    int bRow = sRow + a;
-    if (bRow > (HEIGHT/8)-1) break;
-    if (bRow > -2) {
-      for (int iCol = 0; iCol<w; iCol++) {
-        if (iCol + x > (WIDTH-1)) break;
-        if (iCol + x >= 0) {
-          if (bRow >= 0) {
-            if      (color == WHITE) this->sBuffer[ (bRow*WIDTH) + x + iCol ] |= pgm_read_byte(bitmap+(a*w)+iCol) << yOffset;
-            else if (color == BLACK) this->sBuffer[ (bRow*WIDTH) + x + iCol ] &= ~(pgm_read_byte(bitmap+(a*w)+iCol) << yOffset);
-            else                     this->sBuffer[ (bRow*WIDTH) + x + iCol ] ^= pgm_read_byte(bitmap+(a*w)+iCol) << yOffset;
-          }
-          if (yOffset && bRow<(HEIGHT/8)-1 && bRow > -2) {
-            if      (color == WHITE) this->sBuffer[ ((bRow+1)*WIDTH) + x + iCol ] |= pgm_read_byte(bitmap+(a*w)+iCol) >> (8-yOffset);
-            else if (color == BLACK) this->sBuffer[ ((bRow+1)*WIDTH) + x + iCol ] &= ~(pgm_read_byte(bitmap+(a*w)+iCol) >> (8-yOffset));
-            else                     this->sBuffer[ ((bRow+1)*WIDTH) + x + iCol ] ^= pgm_read_byte(bitmap+(a*w)+iCol) >> (8-yOffset);
-          }
-        }
-      }
+    drawColumns(s, x, y + a*8, bitmap + a*w, w, color, 1, 0);
+  }
+}
+
+uint8_t ArduboyVeritazz::clipMask(const Surface *s, int16_t page)
+{
+  int16_t top, bottom;
+  uint8_t mask = 0xff;
+
+  if (page < 0 || page >= s->pages)
+    return 0;
+
+  // clip rectangle relative to the first pixel of the page
+  top = s->clipY - page*8;
+  bottom = s->clipY + s->clipH - page*8;
+  if (top >= 8 || bottom <= 0)
+    return 0;
+
+  if (top > 0)
+    mask <<= top;
+  if (bottom < 8)
+    mask &= 0xff >> (8 - bottom);
+  return mask;
+}
+
+void ArduboyVeritazz::drawColumns
+(Surface *s, int16_t x, int16_t y, const uint8_t *data, uint8_t w,
+ uint8_t color, uint8_t progmem, uint8_t mirror)
+{
+  int16_t sCol = max(x, s->clipX);
+  int16_t eCol = min(x + w, s->clipX + s->clipW);
+  int16_t page;
+  uint8_t yOffset, mask, b, i;
+
+  if (sCol >= eCol)
+    return;
+
+  // the data spans the page of its top pixel and, if not page aligned,
+  // the part shifted out of it into the following page
+  page = (y >= 0) ? y/8 : -((7 - y)/8);
+  yOffset = y - page*8;
+
+  for (uint8_t lower = 0; lower < 2; lower++, page++) {
+    if (lower && !yOffset)
+      break;
+    mask = clipMask(s, page);
+    if (!mask)
+      continue;
+    markDirty(s, page, sCol, eCol - 1, color);
+
+    register uint8_t *pBuf = s->buffer + (page * s->width) + sCol;
+    for (int16_t iCol = sCol; iCol < eCol; iCol++) {
+      i = iCol - x;
+      if (mirror)
+        i = w - i - 1;
+      b = progmem ? pgm_read_byte(data + i) : data[i];
+      if (lower)
+        b >>= 8 - yOffset;
+      else
+        b <<= yOffset;
+      b &= mask;
+
+      if      (color == WHITE) *pBuf |= b;
+      else if (color == BLACK) *pBuf &= ~b;
+      else                     *pBuf ^= b;
+      pBuf++;
     }
   }
 }
 
+void ArduboyVeritazz::blit
+(Surface *dst, int16_t x, int16_t y, const Surface *src, uint8_t color)
+{
+  for (uint8_t p = 0; p < src->pages; p++) {
+    drawColumns(dst, x, y + p*8, src->buffer + p*src->width, src->width,
+                color, 0, 0);
+  }
+}
+
+void ArduboyVeritazz::drawSurface
+(int16_t x, int16_t y, const Surface *src, uint8_t color)
+{
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    DrawCommand *c = record(DRAW_OP_SURFACE, x, y);
+    if (c) {
+      c->surface.src = src;
+      c->surface.color = color;
+    }
+    return;
+  }
+#endif
+
+  blit(drawTarget(), x, y, src, color);
+}
+
+void ArduboyVeritazz::drawDeferred
+(DrawFn fn, const void *arg, int16_t x, int16_t y, uint8_t opt)
+{
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    DrawCommand *c = record(DRAW_OP_CALL, x, y);
+    if (c) {
+      c->call.fn = fn;
+      c->call.arg = arg;
+      c->call.opt = opt;
+    }
+    return;
+  }
+#endif
+
+  fn(drawContext, arg, x, y, opt);
+}
 
 void ArduboyVeritazz::drawSlowXYBitmap
 (int16_t x, int16_t y, const uint8_t *bitmap, uint8_t w, uint8_t h, uint8_t color)
 {
-  // no need to dar at all of we're offscreen
-  if (x+w < 0 || x > WIDTH-1 || y+h < 0 || y > HEIGHT-1)
+  Surface *s = drawTarget();
+
+#ifdef ARDUBOY_STRIP_RENDERING
+  if (deferred()) {
+    DrawCommand *c = record(DRAW_OP_SLOW_BITMAP, x, y);
+    if (c) {
+      c->bitmap.data = bitmap;
+      c->bitmap.w = w;
+      c->bitmap.h = h;
+      c->bitmap.color = color;
+    }
+    return;
+  }
+#endif
+
+  // no need to dar at all of we're outside of the clip rectangle
+  if (x+w <= s->clipX || x >= s->clipX+s->clipW ||
+      y+h <= s->clipY || y >= s->clipY+s->clipH)
     return;
 
   int16_t xi, yi, byteWidth = (w + 7) / 8;
@@ -656,20 +932,323 @@ void ArduboyVeritazz::drawSlowXYBitmap
 extern void update_screen();
 #endif
 
+void ArduboyVeritazz::holdFrame()
+{
+  frameHeld = true;
+}
+
 void ArduboyVeritazz::display()
 {
-#ifndef HOST_TEST
-  this->paintScreen(sBuffer);
+  uint8_t effects = updateEffects();
+
+#ifdef ARDUBOY_PARTIAL_UPDATE
+  if (effects & EFFECTS_RAM_CHANGED)
+    forceFullUpdate();
+#endif
+#ifdef ARDUBOY_GRAYSCALE
+  // a held frame still has to alternate the planes, those of the last
+  // complete frame, as a clear() since is only done once something is drawn
+  if (frameHeld)
+    frameHeld = false;
+  else if (clearPending)
+    finishClear();
+#endif
+  if (frameHeld || (effects & EFFECTS_SCROLLING)) {
+    frameHeld = false;
+#ifdef ARDUBOY_PARTIAL_UPDATE
+    bytesSent = 0;
+#endif
+#if defined(ARDUBOY_STRIP_RENDERING) && defined(HOST_TEST)
+    // getBuffer() has what was drawn, as it has with a frame buffer
+    renderStrips(false);
+#endif
+    return;
+  }
+
+#ifdef ARDUBOY_STRIP_RENDERING
+  renderStrips(true);
+#ifdef HOST_TEST
+  update_screen();
+#endif
+#else
+#ifdef ARDUBOY_PARTIAL_UPDATE
+  displayPartial();
+  startTransfer();
 #else
+  this->paintScreen(sBuffer);
+#endif
+#ifdef ARDUBOY_GRAYSCALE
+  shadeStart = millis();
+  shadePending = true;
+#endif
+#ifdef HOST_TEST
   update_screen();
 #endif
+#endif
+}
+
+#ifdef ARDUBOY_PARTIAL_UPDATE
+// CRC-32 four bits at a time, from a 64 byte table instead of the usual
+// 1024 bytes.  A segment has 128 bits, in which CRC-32 catches every change
+// of up to five bits.  Anything else gets through once in 2^32 changes,
+// against once in 2^16 for the h * 33 + byte this replaced.
+static const uint32_t crcNibbles[16] PROGMEM = {
+  0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+  0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+  0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+  0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+};
+
+static uint32_t hashSegment(const uint8_t *p)
+{
+  uint32_t h = 0xffffffff;
+
+  for (uint8_t i = 0; i < DIRTY_SEGMENT_WIDTH; i++) {
+    h ^= *p++;
+    h = (h >> 4) ^ pgm_read_dword(&crcNibbles[h & 15]);
+    h = (h >> 4) ^ pgm_read_dword(&crcNibbles[h & 15]);
+  }
+  return h;
+}
+
+void ArduboyVeritazz::displayPartial()
+{
+  uint8_t changed[HEIGHT/8];
+  uint8_t all = 0xff;
+
+  // find the segments that differ from what the OLED shows
+  for (uint8_t page = 0; page < HEIGHT/8; page++) {
+    DirtyRange *d = &dirtyPages[page];
+    uint8_t *p = sBuffer + page*WIDTH;
+
+    changed[page] = 0;
+    for (uint8_t seg = 0; seg < DIRTY_SEGMENTS; seg++) {
+      uint8_t c0 = seg * DIRTY_SEGMENT_WIDTH;
+      bool sweep = (page * DIRTY_SEGMENTS + seg) == sweepSegment;
+      uint32_t h;
+
+      if (hashesValid && !sweep &&
+          (d->first > d->last || d->first >= c0 + DIRTY_SEGMENT_WIDTH ||
+           d->last < c0))
+        continue;
+      h = hashSegment(p + c0);
+      if (hashesValid && !sweep && h == segmentHashes[page][seg])
+        continue;
+      segmentHashes[page][seg] = h;
+      changed[page] |= _BV(seg);
+    }
+    all &= changed[page];
+    d->first = 0xff;
+    d->last = 0;
+  }
+  hashesValid = true;
+  if (++sweepSegment == (HEIGHT/8) * DIRTY_SEGMENTS)
+    sweepSegment = 0;
+
+  // everything changed, no need for windows
+  if (all == 0xff) {
+    this->paintScreen(sBuffer);
+    bytesSent = (HEIGHT*WIDTH)/8;
+    return;
+  }
+
+  // send each run of changed segments in its own window
+  bytesSent = 0;
+  for (uint8_t page = 0; page < HEIGHT/8; page++) {
+    uint8_t seg = 0;
+
+    while (seg < DIRTY_SEGMENTS) {
+      uint8_t start, len;
+
+      if (!(changed[page] & _BV(seg))) {
+        seg++;
+        continue;
+      }
+      start = seg * DIRTY_SEGMENT_WIDTH;
+      while (seg < DIRTY_SEGMENTS && (changed[page] & _BV(seg)))
+        seg++;
+      len = seg * DIRTY_SEGMENT_WIDTH - start;
+      setWindow(start, start + len - 1, page, page);
+      paintScreen(sBuffer + page*WIDTH + start, len);
+      bytesSent += 6 + len;
+    }
+  }
+
+  // leave the OLED addressing the whole screen for everybody else
+  if (bytesSent) {
+    setWindow(0, WIDTH - 1, 0, HEIGHT/8 - 1);
+    bytesSent += 6;
+  }
+}
+
+void ArduboyVeritazz::forceFullUpdate()
+{
+  hashesValid = false;
+}
+#endif
+
+void ArduboyVeritazz::markFilled(Surface *s, uint8_t color)
+{
+#ifdef ARDUBOY_PARTIAL_UPDATE
+  if (!s->dirty)
+    return;
+  for (uint8_t page = 0; page < s->pages; page++) {
+    DirtyRange *d = &s->dirty[page];
+
+    if (color == BLACK) {
+      // only where something was lit is the clear a change
+      if (d->litFirst < d->first)
+        d->first = d->litFirst;
+      if (d->litLast > d->last && d->litFirst <= d->litLast)
+        d->last = d->litLast;
+      d->litFirst = 0xff;
+      d->litLast = 0;
+    } else {
+      d->first = d->litFirst = 0;
+      d->last = d->litLast = s->width - 1;
+    }
+  }
+#endif
+}
+
+#ifdef ARDUBOY_STRIP_RENDERING
+void ArduboyVeritazz::renderStrips(bool send)
+{
+  Surface *t = target;
+
+  // render the recorded frame one page at a time and stream it out
+  target = &screen;
+  replaying = true;
+  for (uint8_t page = 0; page < HEIGHT/8; page++) {
+    memset(sBuffer, 0, WIDTH);
+    for (uint8_t i = 0; i < drawListCount; i++)
+      replay(&drawList[i], page*8);
+    if (send)
+      this->paintScreen(sBuffer, WIDTH);
+#ifdef HOST_TEST
+    memcpy(hostScreen + page*WIDTH, sBuffer, WIDTH);
+#endif
+  }
+  replaying = false;
+  target = t;
+}
+
+DrawCommand *ArduboyVeritazz::record(uint8_t op, int16_t x, int16_t y)
+{
+  DrawCommand *c;
+
+  if (drawListCount == DRAW_LIST_SIZE) {
+    drawListOverflows++;
+    return NULL;
+  }
+
+  c = &drawList[drawListCount++];
+  if (drawListCount > drawListPeak)
+    drawListPeak = drawListCount;
+  c->op = op;
+  c->x = x;
+  c->y = y;
+  return c;
 }
 
+void ArduboyVeritazz::replay(const DrawCommand *c, int16_t dy)
+{
+  int16_t y = c->y - dy;
+
+  switch (c->op) {
+  case DRAW_OP_PIXEL:
+    drawPixel(c->x, y, c->rect.color);
+    break;
+  case DRAW_OP_HLINE:
+    drawFastHLine(c->x, y, c->rect.w, c->rect.color);
+    break;
+  case DRAW_OP_VLINE:
+    drawFastVLine(c->x, y, c->rect.h, c->rect.color);
+    break;
+  case DRAW_OP_RECT:
+    drawRect(c->x, y, c->rect.w, c->rect.h, c->rect.color);
+    break;
+  case DRAW_OP_FILL_RECT:
+    fillRect(c->x, y, c->rect.w, c->rect.h, c->rect.color);
+    break;
+  case DRAW_OP_FILL_SCREEN:
+    fillScreen(WHITE);
+    break;
+  case DRAW_OP_BITMAP:
+    drawBitmap(c->x, y, c->bitmap.data, c->bitmap.w, c->bitmap.h, c->bitmap.color);
+    break;
+  case DRAW_OP_SLOW_BITMAP:
+    drawSlowXYBitmap(c->x, y, c->bitmap.data, c->bitmap.w, c->bitmap.h, c->bitmap.color);
+    break;
+  case DRAW_OP_SURFACE:
+    blit(target, c->x, y, c->surface.src, c->surface.color);
+    break;
+  case DRAW_OP_CALL:
+    c->call.fn(drawContext, c->call.arg, c->x, y, c->call.opt);
+    break;
+  }
+}
+#endif
+
 unsigned char* ArduboyVeritazz::getBuffer()
 {
+#if defined(ARDUBOY_STRIP_RENDERING) && defined(HOST_TEST)
+  return hostScreen;
+#else
   return sBuffer;
+#endif
 }
 
+/* Surfaces */
+
+void ArduboyVeritazz::initSurface
+(Surface *s, uint8_t *buffer, uint8_t width, uint8_t pages)
+{
+  s->buffer = buffer;
+  s->width = width;
+  s->pages = pages;
+  s->clipX = 0;
+  s->clipY = 0;
+  s->clipW = width;
+  s->clipH = pages * 8;
+}
+
+void ArduboyVeritazz::setClip
+(Surface *s, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  int16_t xe = min(x + w, s->width);
+  int16_t ye = min(y + h, s->pages * 8);
+
+  x = max(x, 0);
+  y = max(y, 0);
+  s->clipX = x;
+  s->clipY = y;
+  s->clipW = xe > x ? xe - x : 0;
+  s->clipH = ye > y ? ye - y : 0;
+}
+
+void ArduboyVeritazz::setTarget(Surface *s)
+{
+  target = s ? s : &screen;
+}
+
+Surface *ArduboyVeritazz::getTarget()
+{
+  return target;
+}
+
+Surface *ArduboyVeritazz::getScreen()
+{
+  return &screen;
+}
+
+#ifdef ARDUBOY_GRAYSCALE
+Surface *ArduboyVeritazz::getShade()
+{
+  return &shade;
+}
+#endif
+
 void ArduboyVeritazz::swap(int16_t& a, int16_t& b)
 {
   int temp = a;
@@ -677,6 +1256,37 @@ void ArduboyVeritazz::swap(int16_t& a, int16_t& b)
   b = temp;
 }
 
+#ifdef HOST_TEST
+void ArduboyVeritazz::saveFrameState(FrameState *s)
+{
+  memset(s, 0, sizeof(*s));
+  s->lastFrameStart = lastFrameStart;
+  s->nextFrameStart = nextFrameStart;
+  s->frameCount = frameCount;
+  s->frameRate = frameRate;
+  s->eachFrameMillis = eachFrameMillis;
+  s->postRender = post_render;
+  s->frameHeld = frameHeld;
+  s->lastFrameDurationMs = lastFrameDurationMs;
+  s->currentButtons = currentButtonState;
+  s->previousButtons = previousButtonState;
+}
+
+void ArduboyVeritazz::loadFrameState(const FrameState *s)
+{
+  lastFrameStart = s->lastFrameStart;
+  nextFrameStart = s->nextFrameStart;
+  frameCount = s->frameCount;
+  frameRate = s->frameRate;
+  eachFrameMillis = s->eachFrameMillis;
+  post_render = s->postRender;
+  frameHeld = s->frameHeld;
+  lastFrameDurationMs = s->lastFrameDurationMs;
+  currentButtonState = s->currentButtons;
+  previousButtonState = s->previousButtons;
+}
+#endif
+
 /* simple_buttons */
 
 void ArduboyVeritazz::poll()
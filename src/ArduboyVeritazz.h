@@ -25,6 +25,169 @@
 #define WHITE 1 //< lit pixel
 #define BLACK 0 //< unlit pixel
 
+// Partial display updates
+//
+// With ARDUBOY_PARTIAL_UPDATE defined every primitive records which columns
+// of which pages it touched.  display() then only looks at those ranges,
+// plus what the last clear wiped out, and compares them in segments of
+// DIRTY_SEGMENT_WIDTH columns against a hash of what was sent last time.
+// Only segments that changed are sent, using the column/page address window
+// of the SSD1306.  The hashes are CRC-32s and take 256 bytes instead of the
+// 1024 bytes a copy of the last frame would, which Fatsche has no room for.
+// A change a CRC misses stays on the OLED until the segment changes again,
+// at worst until the segment comes round: one segment per frame is always
+// sent, so every segment is refreshed at least every 64 frames.
+#ifdef ARDUBOY_PARTIAL_UPDATE
+#ifdef ARDUBOY_STRIP_RENDERING
+#error "ARDUBOY_PARTIAL_UPDATE needs the frame buffer, it does not work with ARDUBOY_STRIP_RENDERING"
+#endif
+#define DIRTY_SEGMENT_WIDTH 16
+#define DIRTY_SEGMENTS (WIDTH / DIRTY_SEGMENT_WIDTH)
+
+/// columns of a page that changed or may hold lit pixels, empty if first > last
+struct DirtyRange
+{
+  uint8_t first;      //< columns drawn to since the last display()
+  uint8_t last;
+  uint8_t litFirst;   //< columns that may hold lit pixels
+  uint8_t litLast;
+};
+#endif
+
+// Grayscale
+//
+// With ARDUBOY_GRAYSCALE defined a second page-format buffer, the shade
+// plane, lies next to the screen.  display() sends the screen as usual and
+// nextFrame() sends the screen XORed with the shade plane once two thirds of
+// the frame time are over, so a pixel set in the shade plane is shown for
+// one third of the frame instead of two thirds, or the other way round.
+// That gives four shades:
+//
+//   screen shade
+//     0      0    black
+//     0      1    dark gray, lit a third of the time
+//     1      1    light gray, lit two thirds of the time
+//     1      0    white
+//
+// Drawing into the screen alone still gives plain black and white, clear()
+// wipes both planes.  It does so only once something is drawn: a held frame
+// keeps alternating the planes of the last complete frame, even when the
+// sketch cleared the screen before it decided to hold it.  Assets named
+// *_gray are split into both planes by conpack.py and drawn with __flag_gray.
+//
+// The shade plane costs another 1024 bytes of RAM.  With the screen that is
+// 2048 of the 2560 bytes of the ATmega32u4, and no AVR build has shown yet
+// that Fatsche, the core and the stack fit into the remaining 512, so the
+// mode is only available in the host build for now.
+#ifdef ARDUBOY_GRAYSCALE
+#ifndef HOST_TEST
+#error "ARDUBOY_GRAYSCALE is host only, the AVR has no RAM budget for the shade plane yet"
+#endif
+#ifdef ARDUBOY_STRIP_RENDERING
+#error "ARDUBOY_GRAYSCALE needs the frame buffer, it does not work with ARDUBOY_STRIP_RENDERING"
+#endif
+#ifdef ARDUBOY_PARTIAL_UPDATE
+#error "ARDUBOY_GRAYSCALE sends two different planes every frame, it does not work with ARDUBOY_PARTIAL_UPDATE"
+#endif
+#endif
+
+/// view onto a bitmap stored in the display page format
+/**
+ * Each byte holds 8 vertical pixels, a page is a row of `width` bytes and
+ * the buffer holds `pages` of them, exactly like the SSD1306 GDDRAM.  All
+ * drawing primitives render into the current target surface and only touch
+ * pixels inside its clip rectangle.  The screen is just the surface that
+ * wraps sBuffer.
+ */
+struct Surface
+{
+  uint8_t *buffer;  //< pages * width bytes of page-format pixels
+  uint8_t width;    //< width in pixels (bytes per page)
+  uint8_t pages;    //< height in pages of 8 pixels
+  uint8_t clipX;    //< clip rectangle, drawing outside of it is discarded
+  uint8_t clipY;
+  uint8_t clipW;
+  uint8_t clipH;
+#ifdef ARDUBOY_PARTIAL_UPDATE
+  DirtyRange *dirty; //< optional, one range per page
+#endif
+};
+
+// Strip rendering
+//
+// With ARDUBOY_STRIP_RENDERING defined there is no full frame buffer.
+// Everything drawn to the screen is recorded into a draw list and replayed
+// by display() once for every page of the display into a single page strip
+// which is then streamed to the OLED.  This trades the 1024 byte frame
+// buffer for WIDTH bytes of strip plus the draw list.  On AVR a DrawCommand
+// takes 12 bytes, so the default list of 34 commands frees 488 bytes.
+//
+// The OLED cannot be read back, so a frame that does not fit into the list
+// cannot be sent in several passes either: a later pass would wipe what an
+// earlier one drew to the same pages.  The list has to hold the busiest
+// frame of the sketch, which drawDeferred() keeps short; commands beyond
+// it are dropped and counted in drawListOverflows.  The default is the
+// most a frame of Fatsche can record, the regression sessions of the host
+// peak at 30.
+#ifndef DRAW_LIST_SIZE
+#define DRAW_LIST_SIZE 34
+#endif
+
+/// draw function recorded by drawDeferred(), context is that of setDrawContext()
+typedef void (*DrawFn)(void *context, const void *arg, int16_t x, int16_t y,
+                       uint8_t opt);
+
+enum draw_ops
+{
+  DRAW_OP_PIXEL,
+  DRAW_OP_HLINE,
+  DRAW_OP_VLINE,
+  DRAW_OP_RECT,
+  DRAW_OP_FILL_RECT,
+  DRAW_OP_FILL_SCREEN,
+  DRAW_OP_BITMAP,
+  DRAW_OP_SLOW_BITMAP,
+  DRAW_OP_SURFACE,
+  DRAW_OP_CALL,
+  DRAW_OP_IMAGE,        //< packed image, replayed by VeritazzExtra
+};
+
+/// one recorded drawing operation of the strip renderer
+struct DrawCommand
+{
+  uint8_t op;
+  int16_t x;
+  int16_t y;
+  union {
+    struct {
+      uint8_t w;
+      uint8_t h;
+      uint8_t color;
+    } rect;
+    struct {
+      const uint8_t *data;
+      uint8_t w;
+      uint8_t h;
+      uint8_t color;
+    } bitmap;
+    struct {
+      const Surface *src;
+      uint8_t color;
+    } surface;
+    struct {
+      DrawFn fn;
+      const void *arg;
+      uint8_t opt;
+    } call;
+    struct {
+      const uint8_t *img;
+      const uint8_t *mask;
+      uint8_t nr;
+      uint16_t flags;
+    } image;
+  };
+};
+
 #ifndef HOST_TEST
 // compare Vcc to 1.1 bandgap
 #define ADC_VOLTAGE (_BV(REFS0) | _BV(MUX4) | _BV(MUX3) | _BV(MUX2) | _BV(MUX1))
@@ -73,6 +236,14 @@ public:
    */
   void display();
 
+  /// Keeps what the screen shows instead of sending the next frame.
+  /**
+   * For frames that would look exactly like the last one.  The next display()
+   * returns right away, so a sketch that neither clears nor draws such a
+   * frame saves both the rendering and the transfer.
+   */
+  void holdFrame();
+
   /// Sets a single pixel on the screen buffer to white or black.
   void drawPixel(int x, int y, uint8_t color);
 
@@ -140,6 +311,54 @@ public:
 
   unsigned char* getBuffer();
 
+  /// Wraps a page-format buffer of width x (pages * 8) pixels.
+  /**
+   * The clip rectangle is reset to cover the whole surface.
+   */
+  static void initSurface(Surface *s, uint8_t *buffer, uint8_t width, uint8_t pages);
+
+  /// Restricts drawing into a surface to the given rectangle.
+  static void setClip(Surface *s, int16_t x, int16_t y, int16_t w, int16_t h);
+
+  /// Selects the surface all drawing primitives render into.
+  /**
+   * Passing NULL selects the screen again.
+   */
+  void setTarget(Surface *s);
+  Surface *getTarget();
+  Surface *getScreen();
+#ifdef ARDUBOY_GRAYSCALE
+  /// the shade plane, see ARDUBOY_GRAYSCALE
+  Surface *getShade();
+#endif
+
+  /// Blits a page-format surface into another one.
+  /**
+   * The whole source surface is copied to x/y of the destination, honouring
+   * the clip rectangle of the destination.  Color selects how source pixels
+   * are combined: WHITE sets, BLACK clears and INVERT toggles them.
+   */
+  static void blit(Surface *dst, int16_t x, int16_t y, const Surface *src, uint8_t color);
+
+  /// Blits a surface into the current target.
+  /**
+   * With strip rendering the source surface is only read by display(), so
+   * it has to stay untouched until then.
+   */
+  void drawSurface(int16_t x, int16_t y, const Surface *src, uint8_t color);
+
+  /// Sets the context every function of drawDeferred() is called with.
+  void setDrawContext(void *context) { drawContext = context; }
+
+  /// Draws with a function of the sketch.
+  /**
+   * fn is called with the draw context, arg, x, y and opt and has to do all
+   * of its drawing relative to x/y.  Normally this happens right away, with strip rendering
+   * the call is recorded as a single command and repeated for every strip,
+   * which keeps things like text from flooding the draw list.
+   */
+  void drawDeferred(DrawFn fn, const void *arg, int16_t x, int16_t y, uint8_t opt);
+
 
   /// Seeds the random number generator with entropy from the temperature, voltage reading, and microseconds since boot.
   /**
@@ -170,8 +389,35 @@ public:
   long lastFrameStart;
   long nextFrameStart;
   uint8_t post_render;
+  uint8_t frameHeld;
   uint8_t lastFrameDurationMs;
 
+#ifdef HOST_TEST
+  /// what carries over from one frame to the next, for snapshots on the host
+  /**
+   * The frame times are those of millis(), whoever restores them moves them
+   * to a clock of their own.
+   */
+  struct FrameState {
+    long lastFrameStart;
+    long nextFrameStart;
+    uint16_t frameCount;
+    uint8_t frameRate;
+    uint8_t eachFrameMillis;
+    uint8_t postRender;
+    uint8_t frameHeld;
+    uint8_t lastFrameDurationMs;
+    uint8_t currentButtons;
+    uint8_t previousButtons;
+  };
+
+  /// saves the frame timing and the buttons
+  void saveFrameState(FrameState *s);
+
+  /// restores what saveFrameState() saved
+  void loadFrameState(const FrameState *s);
+#endif
+
   /// useful for getting raw approximate voltage values
   uint16_t rawADC(uint8_t adc_bits);
 
@@ -204,7 +450,119 @@ private:
 	uint8_t previousButtonState = 0;
 
 protected:
+  /// combines a row of page-format column bytes into a surface
+  /**
+   * The w bytes of data are placed at pixel position x/y, y does not need
+   * to be page aligned.  Pixels outside of the clip rectangle of the surface
+   * are left untouched.  If progmem is set data is read from flash, with
+   * mirror set the columns are placed in reverse order.
+   */
+  static void drawColumns(Surface *s, int16_t x, int16_t y, const uint8_t *data,
+                          uint8_t w, uint8_t color, uint8_t progmem, uint8_t mirror);
+
+  /// returns the bits of a page that lie inside the clip rectangle
+  static uint8_t clipMask(const Surface *s, int16_t page);
+
+  /// notes that columns x0 to x1 of a page were drawn to with color
+  static inline void markDirty(Surface *s, uint8_t page, uint8_t x0, uint8_t x1, uint8_t color)
+  {
+#ifdef ARDUBOY_PARTIAL_UPDATE
+    DirtyRange *d;
+
+    if (!s->dirty)
+      return;
+    d = &s->dirty[page];
+    if (x0 < d->first)
+      d->first = x0;
+    if (x1 > d->last)
+      d->last = x1;
+    if (color == BLACK)
+      return;
+    if (x0 < d->litFirst)
+      d->litFirst = x0;
+    if (x1 > d->litLast)
+      d->litLast = x1;
+#endif
+  }
+
+  /// notes that a whole surface was filled with color
+  static void markFilled(Surface *s, uint8_t color);
+
+  /// the target, to draw to it
+  Surface *drawTarget()
+  {
+#ifdef ARDUBOY_GRAYSCALE
+    if (clearPending && (target == &screen || target == &shade))
+      finishClear();
+#endif
+    return target;
+  }
+
+  Surface screen;
+  Surface *target;
+  void *drawContext;            //< passed to the functions of drawDeferred()
+
+#ifdef ARDUBOY_STRIP_RENDERING
+public:
+  uint8_t drawListPeak;         //< most commands recorded in a frame
+  uint16_t drawListOverflows;   //< commands dropped for lack of space
+
+protected:
+  /// true if drawing to the target has to be recorded
+  bool deferred() { return target == &screen && !replaying; }
+
+  /// appends a command to the draw list, NULL if it is full
+  DrawCommand *record(uint8_t op, int16_t x, int16_t y);
+
+  /// executes a recorded command moved up by dy pixels
+  virtual void replay(const DrawCommand *c, int16_t dy);
+
+  /// replays the draw list into the strip, page by page, and sends them
+  void renderStrips(bool send);
+
+  unsigned char sBuffer[WIDTH];
+  DrawCommand drawList[DRAW_LIST_SIZE];
+  uint8_t drawListCount;
+  bool replaying;
+#ifdef HOST_TEST
+  // the host has no OLED to stream the strips to
+  unsigned char hostScreen[(HEIGHT*WIDTH)/8];
+#endif
+#else
   unsigned char sBuffer[(HEIGHT*WIDTH)/8];
+#endif
+
+#ifdef ARDUBOY_GRAYSCALE
+protected:
+  Surface shade;
+  unsigned char shadeBuffer[(HEIGHT*WIDTH)/8];
+  long shadeStart;              //< when display() sent the screen plane
+  bool shadePending;            //< the shade plane is still to be sent
+  bool clearPending;            //< clear() was called, nothing drawn since
+
+  /// wipes both planes for a clear() that was put off
+  void finishClear();
+#endif
+
+#ifdef ARDUBOY_PARTIAL_UPDATE
+public:
+  uint16_t bytesSent;           //< bytes sent to the OLED by the last display()
+
+  /// sends the whole screen with the next display()
+  /**
+   * Needed after anything else wrote to the OLED, e.g. blank().
+   */
+  void forceFullUpdate();
+
+protected:
+  /// sends the changed parts of the screen
+  void displayPartial();
+
+  DirtyRange dirtyPages[HEIGHT/8];
+  uint32_t segmentHashes[HEIGHT/8][DIRTY_SEGMENTS];
+  uint8_t sweepSegment;
+  bool hashesValid;
+#endif
 
 
 protected:
@@ -1,14 +1,14 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include "images.h"
-#include "VeritazzExtra.h"
-
-VeritazzExtra arduboy(l1_table);
+#include "Fatsche.h"
 
 #ifndef HOST_TEST
 #include <Arduino.h>
 #include <avr/pgmspace.h>
 #include <avr/eeprom.h>
+#else
+#include <new>
 #endif
 
 /*---------------------------------------------------------------------------
@@ -51,7 +51,8 @@ VeritazzExtra arduboy(l1_table);
 #define CHAR_3                      13
 #define CHAR_4                      14
 
-static void draw_number(int8_t x, uint8_t y, int32_t n, uint32_t divider, uint8_t flags);
+static void draw_number(struct game_context *g, int8_t x, int16_t y, int32_t n,
+			uint32_t divider, uint8_t flags);
 
 /*---------------------------------------------------------------------------
  * program states
@@ -75,7 +76,9 @@ enum timers {
 	TIMER_MAX,
 };
 
-typedef void (*timeout_fn)(void);
+struct game_context;
+
+typedef void (*timeout_fn)(struct game_context *g);
 
 struct timer {
 	uint16_t active:1;
@@ -83,220 +86,6 @@ struct timer {
 	timeout_fn fn;
 };
 
-static struct timer timers[TIMER_MAX];
-
-static void init_timers(void)
-{
-	memset(timers, 0, sizeof(timers));
-}
-
-static void run_timers(void)
-{
-	uint8_t t = 0;
-
-	do {
-		if (!timers[t].active)
-			continue;
-		if (timers[t].timeout == 0) {
-			timers[t].active = 0;
-			if (timers[t].fn)
-				timers[t].fn();
-		}
-		timers[t].timeout--;
-	} while (++t < TIMER_MAX);
-}
-
-static void setup_timer(uint8_t id, timeout_fn fn)
-{
-	timers[id].fn = fn;
-}
-
-static void start_timer(uint8_t id, uint16_t timeout)
-{
-	timers[id].timeout = timeout;
-	timers[id].active = 1;
-}
-
-static void stop_timer(uint8_t id)
-{
-	timers[id].active = 0;
-}
-
-/*---------------------------------------------------------------------------
- * general purpose timers
- *---------------------------------------------------------------------------*/
-static uint8_t gp_timer_ticks = 0;
-static void gp_timer_count_fn(void)
-{
-	gp_timer_ticks++;
-	start_timer(TIMER_GP, FPS / 2);
-}
-
-/*---------------------------------------------------------------------------
- * graphic functions
- *---------------------------------------------------------------------------*/
-#define blit_image(a, b, c, d, e)		arduboy.drawImage(a, b, c, d, e)
-#define blit_image_frame(a, b, c, d, e, f)	arduboy.drawImageFrame(a, b, c, d, e, f)
-
-static void
-draw_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
-{
-	arduboy.drawRect(x, y, w, h, WHITE);
-}
-
-static void
-draw_hline(uint8_t x, uint8_t y, uint8_t w)
-{
-	arduboy.drawFastHLine(x, y, w, WHITE);
-}
-
-static void
-draw_vline(uint8_t x, uint8_t y, uint8_t h)
-{
-	arduboy.drawFastVLine(x, y, h, WHITE);
-}
-
-/*---------------------------------------------------------------------------
- * misc functions
- *---------------------------------------------------------------------------*/
-static uint8_t random8(uint8_t max)
-{
-#ifdef HOST_TEST
-	return random() % max;
-#else
-	return random(max);
-#endif
-}
-
-static int32_t read_highscore(void)
-{
-#ifndef HOST_TEST
-	int32_t score = 0;
-	score |= (int32_t)EEPROM.read(EEPROM_STORAGE_SPACE_START);
-	score |= (int32_t)EEPROM.read(EEPROM_STORAGE_SPACE_START + 1) << 8;
-	score |= (int32_t)EEPROM.read(EEPROM_STORAGE_SPACE_START + 2) << 16;
-	score |= (int32_t)EEPROM.read(EEPROM_STORAGE_SPACE_START + 3) << 24;
-	return score;
-#else
-	return 0;
-#endif
-}
-
-static void write_highscore(int32_t score)
-{
-#ifndef HOST_TEST
-	EEPROM.write(EEPROM_STORAGE_SPACE_START, score & 0xff);
-	EEPROM.write(EEPROM_STORAGE_SPACE_START + 1, (score >> 8) & 0xff);
-	EEPROM.write(EEPROM_STORAGE_SPACE_START + 2, (score >> 16) & 0xff);
-	EEPROM.write(EEPROM_STORAGE_SPACE_START + 3, (score >> 24) & 0xff);
-#endif
-}
-
-/*---------------------------------------------------------------------------
- * inputs
- *---------------------------------------------------------------------------*/
-#ifdef HOST_TEST
-static uint8_t input_current = 0;
-
-/* input states */
-enum KEYS {
-	KEY_UP = 1,
-	KEY_DOWN = 2,
-	KEY_LEFT = 4,
-	KEY_RIGHT = 8,
-	KEY_A = 16,
-	KEY_B = 32,
-};
-
-static void
-update_inputs(void)
-{
-	input_current = get_inputs();
-}
-
-uint8_t a(void)
-{
-	return !!(input_current & KEY_A);
-}
-uint8_t b(void)
-{
-	return !!(input_current & KEY_B);
-}
-uint8_t up(void)
-{
-	return !!(input_current & KEY_UP);
-}
-uint8_t down(void)
-{
-	return !!(input_current & KEY_DOWN);
-}
-uint8_t left(void)
-{
-	return !!(input_current & KEY_LEFT);
-}
-uint8_t right(void)
-{
-	return !!(input_current & KEY_RIGHT);
-}
-#define pressedA()           a()
-#define pressedB()           b()
-#define pressedUp()          up()
-#define pressedDown()        down()
-#define pressedLeft()        left()
-#define pressedRight()       right()
-#else
-uint8_t a(void)
-{
-	return arduboy.a();
-}
-uint8_t b(void)
-{
-	return arduboy.b();
-}
-uint8_t up(void)
-{
-	return arduboy.up();
-}
-uint8_t down(void)
-{
-	return arduboy.down();
-}
-uint8_t left(void)
-{
-	return arduboy.left();
-}
-uint8_t right(void)
-{
-	return arduboy.right();
-}
-
-uint8_t pressedA(void)
-{
-	return arduboy.pressedA();
-}
-uint8_t pressedB(void)
-{
-	return arduboy.pressedB();
-}
-uint8_t pressedUp(void)
-{
-	return arduboy.pressedUp();
-}
-uint8_t pressedDown(void)
-{
-	return arduboy.pressedDown();
-}
-uint8_t pressedLeft(void)
-{
-	return arduboy.pressedLeft();
-}
-uint8_t pressedRight(void)
-{
-	return arduboy.pressedRight();
-}
-
-#endif
-
 /*---------------------------------------------------------------------------
  * data types
  *---------------------------------------------------------------------------*/
@@ -428,9 +217,23 @@ struct flying_number {
 	int8_t number;
 };
 
+struct bumping_img {
+	uint8_t x;
+	int16_t y;
+	int16_t velocity;
+	int16_t gravity;
+	uint8_t i:7;
+	uint8_t update:1;
+};
+
+#define NR_BUMPING_IMGS                8
+
 struct game_data {
-	struct menu menu;
-	uint8_t dummy[sizeof(struct flying_number) * MAX_FLYING_NUMBERS - sizeof(struct menu)];
+	/* the menu is gone once the bumping texts are shown */
+	union {
+		struct menu menu;
+		struct bumping_img bump[NR_BUMPING_IMGS];
+	};
 	uint8_t boss_time;
 	uint8_t stage_time;
 	uint8_t stage_nr;
@@ -446,148 +249,494 @@ struct game_data {
 	uint8_t pause;
 };
 
-static struct game_data gd;
-
 /*---------------------------------------------------------------------------
- * timing
+ * game context
  *---------------------------------------------------------------------------*/
+/*
+ * Screens which only change with the blinking A icon are identified by their
+ * state and the blink phase, all others are redrawn every frame.
+ */
+#define FRAME_DYNAMIC 0xffff
+
+/* everything a running game changes, apart from the library */
+struct game_state {
+	struct game_data gd;
+	struct timer timers[TIMER_MAX];
+	struct flying_number flying_numbers[MAX_FLYING_NUMBERS];
+	uint8_t gp_timer_ticks;
+	uint8_t lamp_frame;
+	int16_t bump_ye;		/* where bumping images land */
+	uint8_t main_state;		/* state of the program */
+	/* cleared by begin_frame() if the screen looks like the last one */
+	uint8_t draw_frame;
+	uint16_t last_key;		/* of the last frame drawn */
+	/* frames left until the screen fades in again */
+	uint8_t transition;
+};
+
+struct game_context {
+	VeritazzExtra arduboy;
+	struct game_state state;
+#ifdef HOST_TEST
+	/* simulations may run frames without drawing them, see set_render() */
+	uint8_t render_frame;
+	uint8_t render_skipped;
+	uint32_t rng;
+	void *user;			/* for the harness, see game_set_user() */
+#ifdef HOST_HEADLESS
+	unsigned long millis;		/* the clock while not selected */
+#endif
+#endif
+
+	game_context();
+};
 
-static uint8_t next_frame(void)
-{
-	if (arduboy.nextFrame()) {
 #ifdef HOST_TEST
-		update_inputs();
+/* the game setup() and loop() of the thread run, see game_select() */
+static __thread struct game_context *game;
 #else
-		arduboy.poll();
+/* a single game at a fixed address, just like plain statics */
+static struct game_context the_game;
+static struct game_context *const game = &the_game;
 #endif
-		arduboy.clear();
-		if (!gd.pause)
-			run_timers();
-		return 1;
-	}
-	return 0;
-}
 
-static void finish_frame(void)
+game_context::game_context() : arduboy(l1_table)
 {
-	arduboy.display();
+	/* deferred draw functions get the game back, see draw_text() */
+	arduboy.setDrawContext(this);
+	memset(&state, 0, sizeof(state));
+	state.main_state = PROGRAM_MAIN_MENU;
+	state.draw_frame = 1;
+	state.last_key = FRAME_DYNAMIC;
+#ifdef HOST_TEST
+	render_frame = 1;
+	render_skipped = 0;
+	rng = 1;
+#ifdef HOST_HEADLESS
+	millis = 0;
+#endif
+#endif
 }
 
-/*---------------------------------------------------------------------------
- * setup
- *---------------------------------------------------------------------------*/
-void
-setup(void)
+#ifdef HOST_TEST
+struct game_context *game_create(uint32_t seed)
 {
-	arduboy.initRandomSeed();
-	arduboy.setFrameRate(FPS);
-	arduboy.begin();
-	init_timers();
+	/* the library counts on zeroed memory like that of a static */
+	void *p = calloc(1, sizeof(struct game_context));
+	struct game_context *g;
+
+	if (!p)
+		return NULL;
+	g = new (p) game_context();
+	/* xorshift never leaves 0 */
+	g->rng = seed ? seed : 1;
+	return g;
 }
 
-/*---------------------------------------------------------------------------
- * bump tables
- *---------------------------------------------------------------------------*/
+void game_destroy(struct game_context *g)
+{
+	if (game == g)
+		game_select(NULL);
+	g->~game_context();
+	free(g);
+}
 
-struct bumping_img {
-	uint8_t x;
-	int16_t y;
-	int16_t velocity;
-	int16_t gravity;
-	uint8_t i:7;
-	uint8_t update:1;
-};
+void game_select(struct game_context *g)
+{
+#ifdef HOST_HEADLESS
+	/* every game keeps its own clock */
+	if (game)
+		game->millis = host_millis;
+	host_millis = g ? g->millis : 0;
+#endif
+	game = g;
+}
 
-static int16_t ye;
-static const int8_t velocities[] PROGMEM = {
-	 8,
-	-3,
-	 4,
-	-2,
-	 2,
-	-1,
-	 1,
-	 0,
-};
+struct game_context *game_selected(void)
+{
+	return game;
+}
 
-static void init_bump(struct bumping_img *bi, uint8_t x, int8_t y, int16_t gravity)
+VeritazzExtra *game_arduboy(struct game_context *g)
 {
-	bi->x = x;
-	bi->y = y << 8;
-	bi->velocity = (int16_t)pgm_read_byte(&velocities[0]) << 8;
-	bi->gravity = gravity;
-	bi->i = 0;
-	bi->update = 1;
+	return &g->arduboy;
 }
 
-static void init_img_bump(int8_t y)
+void game_set_user(struct game_context *g, void *user)
 {
-	ye = y << 8;
+	g->user = user;
 }
 
-static uint8_t img_bump(struct bumping_img *bi, const uint8_t *img, uint8_t frame)
+void *game_user(struct game_context *g)
 {
-	int16_t yn;
-	int8_t velocity = pgm_read_byte(&velocities[bi->i]);
+	return g->user;
+}
 
-	if (bi->update) {
-		blit_image_frame(bi->x,
-				 (int8_t)(bi->y >> 8),
-				 img,
-				 img,
-				 frame,
-				 __flag_white);
-		bi->update = 0;
-	}
+void set_render(uint8_t on)
+{
+	game->render_frame = on;
+}
+#endif
 
-	if (bi->i == 7) {
-		bi->update = 1;
-		return 1;
-	}
-	if (bi->y == ye && (velocity > 0)) {
-		bi->i++;
-		bi->velocity = (int16_t)velocity << 8;
-	} else if (((int8_t)(bi->velocity >> 8)) >= 0 && (velocity < 0)) {
-		bi->i++;
-		bi->velocity = (int16_t)velocity << 8;
-	}
+/* whether this frame of g is drawn, the Arduboy draws every frame */
+static inline uint8_t rendering(struct game_context *g)
+{
+#ifdef HOST_TEST
+	return g->render_frame;
+#else
+	return 1;
+#endif
+}
 
-	yn = bi->y + bi->velocity;
-	if (((yn >> 8) != (bi->y >> 8)) || ((yn >> 8) != (ye >> 8)))
-		bi->update = 1;
-	if (yn > ye)
-		bi->y = ye;
-	else
-		bi->y = yn;
-	bi->velocity += bi->gravity;
-	return 0;
+/*---------------------------------------------------------------------------
+ * timer handling
+ *---------------------------------------------------------------------------*/
+static void init_timers(struct game_context *g)
+{
+	memset(g->state.timers, 0, sizeof(g->state.timers));
 }
 
-static void init_8_char_img_bump(void)
+static void run_timers(struct game_context *g)
 {
-	struct bumping_img *bi = (struct bumping_img *)&gd;
+	uint8_t t = 0;
 
-	init_bump(&bi[0], 5, 0, 128);
-	init_bump(&bi[1], 5 + 14, -20, 100);
-	init_bump(&bi[2], 5 + 2 * 14, -10, 64);
-	init_bump(&bi[3], 5 + 3 * 14, -5, 80);
-	init_bump(&bi[4], 10 + 4 * 14, -7, 70);
-	init_bump(&bi[5], 10 + 5 * 14, -30, 110);
-	init_bump(&bi[6], 10 + 6 * 14, -15, 90);
-	init_bump(&bi[7], 10 + 7 * 14, -12, 120);
+	do {
+		if (!g->state.timers[t].active)
+			continue;
+		if (g->state.timers[t].timeout == 0) {
+			g->state.timers[t].active = 0;
+			if (g->state.timers[t].fn)
+				g->state.timers[t].fn(g);
+		}
+		g->state.timers[t].timeout--;
+	} while (++t < TIMER_MAX);
 }
 
-static void init_stage_text(void)
+static void setup_timer(struct game_context *g, uint8_t id, timeout_fn fn)
 {
-	struct bumping_img *bi = (struct bumping_img *)&gd;
+	g->state.timers[id].fn = fn;
+}
 
-	init_bump(&bi[0], 20, 0, 128);
-	init_bump(&bi[1], 20 + 14, -20, 100);
+static void start_timer(struct game_context *g, uint8_t id, uint16_t timeout)
+{
+	g->state.timers[id].timeout = timeout;
+	g->state.timers[id].active = 1;
+}
+
+static void stop_timer(struct game_context *g, uint8_t id)
+{
+	g->state.timers[id].active = 0;
+}
+
+/*---------------------------------------------------------------------------
+ * general purpose timers
+ *---------------------------------------------------------------------------*/
+static void gp_timer_count_fn(struct game_context *g)
+{
+	g->state.gp_timer_ticks++;
+	start_timer(g, TIMER_GP, FPS / 2);
+}
+
+/*---------------------------------------------------------------------------
+ * graphic functions
+ *---------------------------------------------------------------------------*/
+#define blit_image(g, a, b, c, d, e)				\
+	do {							\
+		if (rendering(g))				\
+			(g)->arduboy.drawImage(a, b, c, d, e);	\
+	} while (0)
+#define blit_image_frame(g, a, b, c, d, e, f)				\
+	do {								\
+		if (rendering(g))					\
+			(g)->arduboy.drawImageFrame(a, b, c, d, e, f);	\
+	} while (0)
+
+#ifdef ARDUBOY_GRAYSCALE
+/* light gray lines and dark gray windows let the sprites stand out */
+#define BACKGROUND_IMG				game_background_gray_img
+#define BACKGROUND_FLAGS			(__flag_white | __flag_gray)
+#else
+#define BACKGROUND_IMG				game_background_img
+#define BACKGROUND_FLAGS			__flag_white
+#endif
+
+static void
+draw_rect(struct game_context *g, uint8_t x, int16_t y, uint8_t w, uint8_t h)
+{
+	if (rendering(g))
+		g->arduboy.drawRect(x, y, w, h, WHITE);
+}
+
+static void
+draw_hline(struct game_context *g, uint8_t x, int16_t y, uint8_t w)
+{
+	if (rendering(g))
+		g->arduboy.drawFastHLine(x, y, w, WHITE);
+}
+
+static void
+draw_vline(struct game_context *g, uint8_t x, int16_t y, uint8_t h)
+{
+	if (rendering(g))
+		g->arduboy.drawFastVLine(x, y, h, WHITE);
+}
+
+/*---------------------------------------------------------------------------
+ * misc functions
+ *---------------------------------------------------------------------------*/
+static uint8_t random8(struct game_context *g, uint8_t max)
+{
+#ifdef HOST_TEST
+	/* xorshift, every game has its own */
+	g->rng ^= g->rng << 13;
+	g->rng ^= g->rng >> 17;
+	g->rng ^= g->rng << 5;
+	return g->rng % max;
+#else
+	return random(max);
+#endif
+}
+
+static int32_t read_highscore(void)
+{
+#ifndef HOST_TEST
+	int32_t score = 0;
+	score |= (int32_t)EEPROM.read(EEPROM_STORAGE_SPACE_START);
+	score |= (int32_t)EEPROM.read(EEPROM_STORAGE_SPACE_START + 1) << 8;
+	score |= (int32_t)EEPROM.read(EEPROM_STORAGE_SPACE_START + 2) << 16;
+	score |= (int32_t)EEPROM.read(EEPROM_STORAGE_SPACE_START + 3) << 24;
+	return score;
+#else
+	return 0;
+#endif
+}
+
+static void write_highscore(int32_t score)
+{
+#ifndef HOST_TEST
+	EEPROM.write(EEPROM_STORAGE_SPACE_START, score & 0xff);
+	EEPROM.write(EEPROM_STORAGE_SPACE_START + 1, (score >> 8) & 0xff);
+	EEPROM.write(EEPROM_STORAGE_SPACE_START + 2, (score >> 16) & 0xff);
+	EEPROM.write(EEPROM_STORAGE_SPACE_START + 3, (score >> 24) & 0xff);
+#endif
+}
+
+/*---------------------------------------------------------------------------
+ * inputs
+ *---------------------------------------------------------------------------*/
+uint8_t a(struct game_context *g)
+{
+	return g->arduboy.a();
+}
+uint8_t b(struct game_context *g)
+{
+	return g->arduboy.b();
+}
+uint8_t up(struct game_context *g)
+{
+	return g->arduboy.up();
+}
+uint8_t down(struct game_context *g)
+{
+	return g->arduboy.down();
+}
+uint8_t left(struct game_context *g)
+{
+	return g->arduboy.left();
+}
+uint8_t right(struct game_context *g)
+{
+	return g->arduboy.right();
+}
+
+uint8_t pressedA(struct game_context *g)
+{
+	return g->arduboy.pressedA();
+}
+uint8_t pressedB(struct game_context *g)
+{
+	return g->arduboy.pressedB();
+}
+uint8_t pressedUp(struct game_context *g)
+{
+	return g->arduboy.pressedUp();
+}
+uint8_t pressedDown(struct game_context *g)
+{
+	return g->arduboy.pressedDown();
+}
+uint8_t pressedLeft(struct game_context *g)
+{
+	return g->arduboy.pressedLeft();
+}
+uint8_t pressedRight(struct game_context *g)
+{
+	return g->arduboy.pressedRight();
+}
+
+
+/*---------------------------------------------------------------------------
+ * timing
+ *---------------------------------------------------------------------------*/
+
+#define TRANSITION_FRAMES           MS_TO_FRAMES(250)
+
+/* fades the last frame out and the next one in, nothing moves meanwhile */
+static void start_transition(struct game_context *g)
+{
+	g->arduboy.holdFrame();
+	g->arduboy.fade(0, TRANSITION_FRAMES);
+	g->state.transition = TRANSITION_FRAMES;
+}
+
+/* the library's part of next_frame(), 0 if no frame of the game is due */
+static uint8_t start_frame(struct game_context *g)
+{
+	if (!g->arduboy.nextFrame())
+		return 0;
+	g->arduboy.poll();
+	if (g->state.transition) {
+		if (!--g->state.transition)
+			g->arduboy.fade(OLED_CONTRAST_DEFAULT,
+				     TRANSITION_FRAMES);
+		g->arduboy.holdFrame();
+		g->arduboy.display();
+		return 0;
+	}
+	return 1;
+}
+
+static uint8_t next_frame(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
+
+	if (!start_frame(g))
+		return 0;
+	if (!gd->pause)
+		run_timers(g);
+	return 1;
+}
+
+static void finish_frame(struct game_context *g)
+{
+#ifdef HOST_TEST
+	/* nothing was drawn, but fades and the like still step */
+	if (!rendering(g))
+		g->arduboy.holdFrame();
+#endif
+	g->arduboy.display();
+}
+
+/*---------------------------------------------------------------------------
+ * setup
+ *---------------------------------------------------------------------------*/
+void
+setup(void)
+{
+	struct game_context *g = game;
+
+	g->arduboy.initRandomSeed();
+	g->arduboy.setFrameRate(FPS);
+	g->arduboy.begin();
+	init_timers(g);
+}
+
+/*---------------------------------------------------------------------------
+ * bump tables
+ *---------------------------------------------------------------------------*/
+
+static const int8_t velocities[] PROGMEM = {
+	 8,
+	-3,
+	 4,
+	-2,
+	 2,
+	-1,
+	 1,
+	 0,
+};
+
+static void init_bump(struct bumping_img *bi, uint8_t x, int8_t y, int16_t gravity)
+{
+	bi->x = x;
+	bi->y = y << 8;
+	bi->velocity = (int16_t)pgm_read_byte(&velocities[0]) << 8;
+	bi->gravity = gravity;
+	bi->i = 0;
+	bi->update = 1;
+}
+
+static void init_img_bump(struct game_context *g, int8_t y)
+{
+	g->state.bump_ye = y << 8;
+}
+
+static uint8_t img_bump(struct game_context *g, struct bumping_img *bi,
+			const uint8_t *img, uint8_t frame)
+{
+	int16_t yn;
+	int8_t velocity = pgm_read_byte(&velocities[bi->i]);
+
+	if (bi->update) {
+		blit_image_frame(g, bi->x,
+				 (int8_t)(bi->y >> 8),
+				 img,
+				 img,
+				 frame,
+				 __flag_white);
+		bi->update = 0;
+	}
+
+	if (bi->i == 7) {
+		bi->update = 1;
+		return 1;
+	}
+	if (bi->y == g->state.bump_ye && (velocity > 0)) {
+		bi->i++;
+		bi->velocity = (int16_t)velocity << 8;
+	} else if (((int8_t)(bi->velocity >> 8)) >= 0 && (velocity < 0)) {
+		bi->i++;
+		bi->velocity = (int16_t)velocity << 8;
+	}
+
+	yn = bi->y + bi->velocity;
+	if (((yn >> 8) != (bi->y >> 8)) || ((yn >> 8) != (g->state.bump_ye >> 8)))
+		bi->update = 1;
+	if (yn > g->state.bump_ye)
+		bi->y = g->state.bump_ye;
+	else
+		bi->y = yn;
+	bi->velocity += bi->gravity;
+	return 0;
+}
+
+static void init_8_char_img_bump(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
+	struct bumping_img *bi = gd->bump;
+
+	init_bump(&bi[0], 5, 0, 128);
+	init_bump(&bi[1], 5 + 14, -20, 100);
+	init_bump(&bi[2], 5 + 2 * 14, -10, 64);
+	init_bump(&bi[3], 5 + 3 * 14, -5, 80);
+	init_bump(&bi[4], 10 + 4 * 14, -7, 70);
+	init_bump(&bi[5], 10 + 5 * 14, -30, 110);
+	init_bump(&bi[6], 10 + 6 * 14, -15, 90);
+	init_bump(&bi[7], 10 + 7 * 14, -12, 120);
+}
+
+static void init_stage_text(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
+	struct bumping_img *bi = gd->bump;
+
+	init_bump(&bi[0], 20, 0, 128);
+	init_bump(&bi[1], 20 + 14, -20, 100);
 	init_bump(&bi[2], 20 + 2 * 14, -10, 64);
 	init_bump(&bi[3], 20 + 3 * 14, -5, 80);
 	init_bump(&bi[4], 20 + 4 * 14, -7, 70);
 	init_bump(&bi[5], 25 + 5 * 14, -30, 110);
-	gd.stage_time = FPS;
+	gd->stage_time = FPS;
 }
 /*---------------------------------------------------------------------------
  * text printing functions
@@ -608,9 +757,13 @@ static uint8_t line_length(const char *t)
 	return len;
 }
 
-static void print_text(const char *t, uint8_t x, uint8_t y, uint8_t options)
+static void draw_text(void *context, const void *text, int16_t x, int16_t y,
+		      uint8_t options)
 {
-	uint8_t cx, cy, flags, len = 0;
+	struct game_context *g = (struct game_context *)context;
+	const char *t = (const char *)text;
+	uint8_t cx, flags, len = 0;
+	int16_t cy;
 	char c;
 
 	if (options & __text_centered) {
@@ -647,7 +800,7 @@ static void print_text(const char *t, uint8_t x, uint8_t y, uint8_t options)
 				c -= 87;
 		}
 		if ((flags & 1) == 0)
-			blit_image_frame(cx,
+			blit_image_frame(g, cx,
 					 cy,
 					 characters_3x4_img,
 					 NULL,
@@ -662,52 +815,91 @@ static void print_text(const char *t, uint8_t x, uint8_t y, uint8_t options)
 		}
 	}
 }
+
+/* text is drawn as a whole, which keeps it in one piece on a strip renderer */
+static void print_text(struct game_context *g, const char *t, uint8_t x,
+		       uint8_t y, uint8_t options)
+{
+	if (rendering(g))
+		g->arduboy.drawDeferred(draw_text, t, x, y, options);
+}
+
+/* opt holds the flags of draw_number() and the number of digits above them */
+static void draw_number_at(void *context, const void *n, int16_t x, int16_t y,
+			   uint8_t opt)
+{
+	struct game_context *g = (struct game_context *)context;
+	uint32_t divider = 1;
+	uint8_t digits = opt >> 2;
+
+	while (--digits)
+		divider *= 10;
+	draw_number(g, x, y, *(const int32_t *)n, divider, opt & 3);
+}
+
+/* like print_text(), n is read when the number is drawn */
+static void print_number(struct game_context *g, int8_t x, uint8_t y,
+			 const int32_t *n, uint8_t digits, uint8_t flags)
+{
+	if (rendering(g))
+		g->arduboy.drawDeferred(draw_number_at, n, x, y,
+				     (digits << 2) | flags);
+}
 /*---------------------------------------------------------------------------
  * flying numbers
  *---------------------------------------------------------------------------*/
-static struct flying_number flying_numbers[MAX_FLYING_NUMBERS];
 
-static void init_flying_numbers(void)
+static void init_flying_numbers(struct game_context *g)
 {
-	memset(flying_numbers, 0, sizeof(flying_numbers));
+	memset(g->state.flying_numbers, 0, sizeof(g->state.flying_numbers));
 }
 
-static void add_flying_number(int8_t x, uint8_t y, int8_t number)
+static void add_flying_number(struct game_context *g, int8_t x, uint8_t y,
+			      int8_t number)
 {
 	uint8_t n = 0;
 
 	do {
-		if (!flying_numbers[n].y) {
-			flying_numbers[n].x = x;
-			flying_numbers[n].y = y;
-			flying_numbers[n].number = number;
+		if (!g->state.flying_numbers[n].y) {
+			g->state.flying_numbers[n].x = x;
+			g->state.flying_numbers[n].y = y;
+			g->state.flying_numbers[n].number = number;
 			break;
 		}
 	} while (++n < MAX_FLYING_NUMBERS);
 }
 
-static void update_flying_numbers(void)
+static void update_flying_numbers(struct game_context *g)
 {
 	uint8_t n = 0;
 
 	do {
-		if (flying_numbers[n].y)
-				flying_numbers[n].y--;
+		if (g->state.flying_numbers[n].y)
+				g->state.flying_numbers[n].y--;
 	} while (++n < MAX_FLYING_NUMBERS);
 }
 
-static void draw_flying_numbers(void)
+static void draw_flying_number_list(void *context, const void *arg, int16_t x,
+				    int16_t y, uint8_t opt)
 {
+	struct game_context *g = (struct game_context *)context;
 	uint8_t n = 0;
 
 	do {
-		if (flying_numbers[n].y)
-			draw_number(flying_numbers[n].x,
-				    flying_numbers[n].y,
-				    flying_numbers[n].number,
+		if (g->state.flying_numbers[n].y)
+			draw_number(g, g->state.flying_numbers[n].x,
+				    y + g->state.flying_numbers[n].y,
+				    g->state.flying_numbers[n].number,
 				    100, 2);
 	} while (++n < MAX_FLYING_NUMBERS);
 }
+
+/* all of them in one command of a strip renderer, a boss leaves many */
+static void draw_flying_numbers(struct game_context *g)
+{
+	if (rendering(g))
+		g->arduboy.drawDeferred(draw_flying_number_list, NULL, 0, 0, 0);
+}
 /*---------------------------------------------------------------------------
  * main menu handling
  *---------------------------------------------------------------------------*/
@@ -742,9 +934,9 @@ static const uint8_t menu_drop_atime[] = {
 	6, 3, 1, 2,
 };
 
-static void menu_drop_init(struct menu_drop *drop)
+static void menu_drop_init(struct game_context *g, struct menu_drop *drop)
 {
-	drop->stime = random8(10) * FPS;
+	drop->stime = random8(g, 10) * FPS;
 	drop->atime = menu_drop_atime[0];
 	drop->state = 0;
 	drop->frame = 0;
@@ -753,17 +945,18 @@ static void menu_drop_init(struct menu_drop *drop)
 }
 
 static uint8_t
-mainscreen(void)
+mainscreen(struct game_context *g)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t game_state = PROGRAM_MAIN_MENU;
 	const struct menu_data *data;
 	struct menu_drop *drop;
-	struct menu *menu = &gd.menu;
+	struct menu *menu = &gd->menu;
 	uint8_t i;
 
-	if (pressedLeft())
+	if (pressedLeft(g))
 		menu->state--;
-	else if (pressedRight())
+	else if (pressedRight(g))
 		menu->state++;
 
 	menu->state &= 1;
@@ -773,21 +966,21 @@ mainscreen(void)
 		do {
 			drop = &menu->drop[i];
 			drop->idx = i;
-			menu_drop_init(drop);
+			menu_drop_init(g, drop);
 		} while (++i < NR_OF_DROPS);
 		menu->initialized = 1;
 	}
 
 	data = &menu_item_xlate[menu->state];
-	if (a())
+	if (a(g))
 		game_state = data->n_game_state;
 
-	blit_image(3,
+	blit_image(g, 3,
 		   10,
 		   mainscreen_img,
 		   NULL,
 		   __flag_white);
-	draw_rect(0, 0, WIDTH, HEIGHT);
+	draw_rect(g, 0, 0, WIDTH, HEIGHT);
 
 	i = 0;
 	do {
@@ -795,18 +988,18 @@ mainscreen(void)
 		if (drop->stime)
 			continue;
 		if (drop->state != 2) {
-			blit_image_frame(drop->x,
+			blit_image_frame(g, drop->x,
 					 drop->y,
 					 menu_drops_img,
 					 NULL,
 					 menu_drop_state_frame_offsets[drop->state] + drop->frame,
 					 __flag_white);
 		} else
-			draw_rect(drop->x, drop->y + 4, 2, 2);
+			draw_rect(g, drop->x, drop->y + 4, 2, 2);
 	} while (++i < NR_OF_DROPS);
 
-	draw_hline(data->x, 51, 26);
-	draw_vline(data->x - 1, 52, 9);
+	draw_hline(g, data->x, 51, 26);
+	draw_vline(g, data->x - 1, 52, 9);
 
 	i = 0;
 	do {
@@ -833,7 +1026,7 @@ mainscreen(void)
 		}
 
 		if (drop->state == 4)
-			menu_drop_init(drop);
+			menu_drop_init(g, drop);
 
 		if (drop->state == 0) {
 			drop->x = menu_drop_x_locations[drop->idx];
@@ -861,34 +1054,38 @@ static const char help_b_str[] PROGMEM = "lower lane";
 static const char help_back_str[] PROGMEM = "pause";
 
 static uint8_t
-help(void)
+help(struct game_context *g)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t rstate = PROGRAM_SHOW_HELP;
 
-	if (gd.game_state == GAME_STATE_INIT) {
-		init_timers();
+	if (gd->game_state == GAME_STATE_INIT) {
+		init_timers(g);
 		/* setup general purpose timer to 1s */
-		gp_timer_ticks = 0;
-		setup_timer(TIMER_GP, gp_timer_count_fn);
-		start_timer(TIMER_GP, FPS);
-		delay(500);
-		gd.game_state = GAME_STATE_RUN_GAME;
-	} else if (gd.game_state == GAME_STATE_RUN_GAME) {
-		blit_image(0, 0, help_screen_img, NULL, __flag_white);
-		print_text(help_move_str, 32, 9, 0);
-		print_text(help_select_str, 32, 20, 0);
-		print_text(help_a_str, 32, 31, 0);
-		print_text(help_b_str, 32, 42, 0);
-		print_text(help_back_str, 32, 53, 0);
-		if (gp_timer_ticks & 1)
-			blit_image(64, 55, icon_a_img, NULL, __flag_white);
-		if (pressedA())
-			gd.game_state = GAME_STATE_CLEANUP;
-	} else if (gd.game_state == GAME_STATE_CLEANUP) {
-		init_timers();
-		memset(&gd, 0, sizeof(gd));
+		g->state.gp_timer_ticks = 0;
+		setup_timer(g, TIMER_GP, gp_timer_count_fn);
+		start_timer(g, TIMER_GP, FPS);
+		start_transition(g);
+		gd->game_state = GAME_STATE_RUN_GAME;
+	} else if (gd->game_state == GAME_STATE_RUN_GAME) {
+		if (g->state.draw_frame) {
+			blit_image(g, 0, 0, help_screen_img, NULL, __flag_white);
+			print_text(g, help_move_str, 32, 9, 0);
+			print_text(g, help_select_str, 32, 20, 0);
+			print_text(g, help_a_str, 32, 31, 0);
+			print_text(g, help_b_str, 32, 42, 0);
+			print_text(g, help_back_str, 32, 53, 0);
+			if (g->state.gp_timer_ticks & 1)
+				blit_image(g, 64, 55, icon_a_img, NULL,
+					   __flag_white);
+		}
+		if (pressedA(g))
+			gd->game_state = GAME_STATE_CLEANUP;
+	} else if (gd->game_state == GAME_STATE_CLEANUP) {
+		init_timers(g);
+		memset(gd, 0, sizeof(*gd));
 		rstate = PROGRAM_MAIN_MENU;
-		delay(500);
+		start_transition(g);
 	}
 	return rstate;
 }
@@ -896,9 +1093,10 @@ help(void)
 /*---------------------------------------------------------------------------
  * game handling
  *---------------------------------------------------------------------------*/
-static inline void player_set_poison(void)
+static inline void player_set_poison(struct game_context *g)
 {
-	struct player *p = &gd.player;
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
 
 	p->poison = 1;
 	p->poison_timeout = 20 * FPS;
@@ -924,9 +1122,10 @@ static const uint8_t player_frame_offsets[PLAYER_MAX_STATES] = {
 	  8, /* resting */
 };
 
-static void player_set_state(uint8_t new_state)
+static void player_set_state(struct game_context *g, uint8_t new_state)
 {
-	struct player *p = &gd.player;
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
 
 	if (new_state != p->state) {
 		p->frame = 0;
@@ -934,36 +1133,38 @@ static void player_set_state(uint8_t new_state)
 	}
 
 	if (new_state != PLAYER_RESTS)
-		start_timer(TIMER_PLAYER_RESTS, PLAYER_REST_TIMEOUT);
+		start_timer(g, TIMER_PLAYER_RESTS, PLAYER_REST_TIMEOUT);
 
 	p->previous_state = p->state;
 	p->state = new_state;
 }
 
-static void player_is_resting(void) {
-	player_set_state(PLAYER_RESTS);
+static void player_is_resting(struct game_context *g)
+{
+	player_set_state(g, PLAYER_RESTS);
 }
 
-static void update_player(int8_t dx, uint8_t throws)
+static void update_player(struct game_context *g, int8_t dx, uint8_t throws)
 {
-	struct player *p = &gd.player;
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
 
 	/* update position */
 	if (dx < 0) {
-		player_set_state(PLAYER_L_MOVE);
+		player_set_state(g, PLAYER_L_MOVE);
 		if (p->x > 0)
 			p->x--;
 	}
 	if (dx > 0) {
-		player_set_state(PLAYER_R_MOVE);
+		player_set_state(g, PLAYER_R_MOVE);
 		if (p->x < 116)
 			p->x++;
 	}
 
 	if (throws && p->state == PLAYER_RESTS)
-		player_set_state(p->previous_state);
+		player_set_state(g, p->previous_state);
 	else if (throws)
-		start_timer(TIMER_PLAYER_RESTS, PLAYER_REST_TIMEOUT);
+		start_timer(g, TIMER_PLAYER_RESTS, PLAYER_REST_TIMEOUT);
 
 	/* update frames */
 	if (p->atime == 0) {
@@ -979,16 +1180,17 @@ static void update_player(int8_t dx, uint8_t throws)
 	}
 }
 
-static void init_player(void)
+static void init_player(struct game_context *g)
 {
-	struct player *p = &gd.player;
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
 
 	memset(p, 0, sizeof(*p));
 	p->life = PLAYER_MAX_LIFE;
 	p->x = 20;
 	/* setup timer for players resting animation */
-	setup_timer(TIMER_PLAYER_RESTS, player_is_resting);
-	start_timer(TIMER_PLAYER_RESTS, PLAYER_REST_TIMEOUT);
+	setup_timer(g, TIMER_PLAYER_RESTS, player_is_resting);
+	start_timer(g, TIMER_PLAYER_RESTS, PLAYER_REST_TIMEOUT);
 }
 
 /*---------------------------------------------------------------------------
@@ -1097,19 +1299,20 @@ static const uint8_t weapon_effect_frame_reloads[] = {
 	8,
 };
 
-static uint8_t new_bullet(uint8_t lane, uint8_t weapon)
+static uint8_t new_bullet(struct game_context *g, uint8_t lane, uint8_t weapon)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t b, x = 0;
 	struct bullet *bs;
-	struct player *p = &gd.player;
+	struct player *p = &gd->player;
 
-	if (gd.ws.ammo[weapon] == 0)
+	if (gd->ws.ammo[weapon] == 0)
 		return 0;
 
-	if (gd.ws.cool_down[weapon])
+	if (gd->ws.cool_down[weapon])
 		return 0;
 
-	gd.ws.cool_down[weapon] = pgm_read_word(&weapon_cool_down[weapon]);
+	gd->ws.cool_down[weapon] = pgm_read_word(&weapon_cool_down[weapon]);
 
 	if (p->state != PLAYER_RESTS)
 		b = p->state;
@@ -1124,7 +1327,7 @@ static uint8_t new_bullet(uint8_t lane, uint8_t weapon)
 	/* create a new bullet, do nothing if not possible */
 	b = 0;
 	do {
-		bs = &gd.ws.bs[b];
+		bs = &gd->ws.bs[b];
 		if (bs->state != BULLET_INACTIVE)
 			continue;
 
@@ -1136,25 +1339,26 @@ static uint8_t new_bullet(uint8_t lane, uint8_t weapon)
 		bs->atime = BULLET_FRAME_TIME;
 		bs->etime = pgm_read_word(&etime[weapon]);
 		bs->frame = 0;
-		gd.ws.ammo[weapon]--;
+		gd->ws.ammo[weapon]--;
 		break;
 	} while (++b < NR_BULLETS);
 	return 1;
 }
 
-static void update_bullets(void)
+static void update_bullets(struct game_context *g)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t b = 0, height;
 	struct bullet *bs;
 
 	do {
-		if (gd.ws.cool_down[b])
-			gd.ws.cool_down[b]--;
+		if (gd->ws.cool_down[b])
+			gd->ws.cool_down[b]--;
 	} while (++b < NR_WEAPONS);
 
 	b = 0;
 	do {
-		bs = &gd.ws.bs[b];
+		bs = &gd->ws.bs[b];
 		if (bs->state == BULLET_INACTIVE)
 			continue;
 
@@ -1162,9 +1366,9 @@ static void update_bullets(void)
 		if (bs->state == BULLET_EFFECT || bs->state == BULLET_SPLASH) {
 			if (bs->etime == 0) {
 				if (bs->state == BULLET_EFFECT)
-					gd.ws.effects_active--;
+					gd->ws.effects_active--;
 				bs->state = BULLET_INACTIVE;
-				gd.ws.ammo[bs->weapon]++;
+				gd->ws.ammo[bs->weapon]++;
 			} else {
 				bs->etime--;
 			}
@@ -1173,7 +1377,9 @@ static void update_bullets(void)
 			if (bs->ys == lane_y[bs->lane] - height) {
 				bs->frame = 0;
 				bs->state = BULLET_EFFECT;
-				gd.ws.effects_active++;
+				gd->ws.effects_active++;
+				if (bs->weapon == WEAPON_MOLOTOV)
+					g->arduboy.shake(MS_TO_FRAMES(400), 3);
 			}
 			bs->ys++;
 		}
@@ -1192,13 +1398,15 @@ static void update_bullets(void)
 	} while (++b < NR_BULLETS);
 }
 
-static uint8_t get_bullet_damage(uint8_t lane, struct rect *r)
+static uint8_t get_bullet_damage(struct game_context *g, uint8_t lane,
+				 struct rect *r)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t b = 0, damage = 0;
 	struct bullet *bs;
 
 	do {
-		bs = &gd.ws.bs[b];
+		bs = &gd->ws.bs[b];
 		if (bs->state < BULLET_ACTIVE)
 			continue;
 		if (bs->lane != lane_xlate[lane])
@@ -1209,15 +1417,17 @@ static uint8_t get_bullet_damage(uint8_t lane, struct rect *r)
 	return damage;
 }
 
-static void get_bullet_effect(uint8_t lane, struct enemy *e)
+static void get_bullet_effect(struct game_context *g, uint8_t lane,
+			      struct enemy *e)
 {
+	struct game_data *gd = &g->state.gd;
 	int8_t x1;
 	int16_t x2;
 	uint8_t b = 0;
 	struct bullet *bs;
 
 	do {
-		bs = &gd.ws.bs[b];
+		bs = &gd->ws.bs[b];
 		if (bs->weapon != WEAPON_OIL)
 			continue;
 		if (bs->state != BULLET_EFFECT)
@@ -1237,35 +1447,38 @@ static void get_bullet_effect(uint8_t lane, struct enemy *e)
 	} while (++b < NR_BULLETS);
 }
 
-void select_weapon(int8_t up_down)
+void select_weapon(struct game_context *g, int8_t up_down)
 {
-	struct player *p = &gd.player;
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
 
-	gd.ws.previous = gd.ws.selected;
+	gd->ws.previous = gd->ws.selected;
 	if (p->x < 64 - img_width(player_all_frames_img) / 2) {
-		gd.ws.direction = 1;
-		gd.ws.icon_x = WIDTH;
+		gd->ws.direction = 1;
+		gd->ws.icon_x = WIDTH;
 	} else {
-		gd.ws.direction = 0;
-		gd.ws.icon_x = -img_width(weapons_img);
+		gd->ws.direction = 0;
+		gd->ws.icon_x = -img_width(weapons_img);
 	}
 	if (up_down > 0) {
 		/* select weapon downwards */
-		gd.ws.selected++;
+		gd->ws.selected++;
 	} else {
 		/* select weapon upwards */
-		gd.ws.selected--;
+		gd->ws.selected--;
 	}
-	gd.ws.selected &= NR_WEAPONS - 1;
+	gd->ws.selected &= NR_WEAPONS - 1;
 }
 
-static void init_weapons(void)
+static void init_weapons(struct game_context *g)
 {
-	memset(&gd.ws, 0, sizeof(gd.ws));
+	struct game_data *gd = &g->state.gd;
+
+	memset(&gd->ws, 0, sizeof(gd->ws));
 #ifdef HOST_TEST
-	memcpy(&gd.ws.ammo[0], max_ammo, NR_WEAPONS);
+	memcpy(&gd->ws.ammo[0], max_ammo, NR_WEAPONS);
 #else
-	memcpy_P(&gd.ws.ammo[0], max_ammo, NR_WEAPONS);
+	memcpy_P(&gd->ws.ammo[0], max_ammo, NR_WEAPONS);
 #endif
 }
 
@@ -1279,35 +1492,37 @@ static const struct stage game_stages[MAX_STAGES] PROGMEM = {
 	{ 70, 3, 2, 3},
 };
 
-static void init_stage(void)
+static void init_stage(struct game_context *g)
 {
-	struct stage *s = &gd.stage;
+	struct game_data *gd = &g->state.gd;
+	struct stage *s = &gd->stage;
 #ifdef HOST_TEST
 	memcpy(s, &game_stages[0], sizeof(*s));
 #else
 	memcpy_P(s, &game_stages[0], sizeof(*s));
 #endif
-	init_stage_text();
+	init_stage_text(g);
 }
 
-static void update_stage(void)
+static void update_stage(struct game_context *g)
 {
-	struct stage *s = &gd.stage;
+	struct game_data *gd = &g->state.gd;
+	struct stage *s = &gd->stage;
 
-	if (s->kills <= 0 && !gd.door.boss) {
-		init_8_char_img_bump();
-		gd.boss_time = FPS;
-		gd.door.boss = 3;
+	if (s->kills <= 0 && !gd->door.boss) {
+		init_8_char_img_bump(g);
+		gd->boss_time = FPS;
+		gd->door.boss = 3;
 	}
 
-	if (gd.door.boss == 1 && gd.stage_nr < MAX_STAGES) {
-		init_stage_text();
-		gd.door.boss = 0;
-		gd.stage_nr++;
+	if (gd->door.boss == 1 && gd->stage_nr < MAX_STAGES) {
+		init_stage_text(g);
+		gd->door.boss = 0;
+		gd->stage_nr++;
 #ifdef HOST_TEST
-		memcpy(s, &game_stages[gd.stage_nr], sizeof(*s));
+		memcpy(s, &game_stages[gd->stage_nr], sizeof(*s));
 #else
-		memcpy_P(s, &game_stages[gd.stage_nr], sizeof(*s));
+		memcpy_P(s, &game_stages[gd->stage_nr], sizeof(*s));
 #endif
 	}
 }
@@ -1504,29 +1719,30 @@ static const uint8_t *enemy_frame_reloads[ENEMY_MAX] = {
 	enemy_little_girl_frame_reloads,
 };
 
-static uint8_t enemy_generate_random(struct enemy *e)
+static uint8_t enemy_generate_random(struct game_context *g, struct enemy *e)
 {
-	uint8_t r = random8(100);
+	struct game_data *gd = &g->state.gd;
+	uint8_t r = random8(g, 100);
 	uint8_t id, type;
-	struct stage *s = &gd.stage;
+	struct stage *s = &gd->stage;
 
-	if (gd.door.boss == 3) {
-		gd.door.boss = 2;
+	if (gd->door.boss == 3) {
+		gd->door.boss = 2;
 		id = ENEMY_BOSS1;
 		type = ENEMY_BOSS;
-	} else if (r < 9 && (gd.ecount[ENEMY_PEACEFUL] < s->limits[ENEMY_PEACEFUL])) {
+	} else if (r < 9 && (gd->ecount[ENEMY_PEACEFUL] < s->limits[ENEMY_PEACEFUL])) {
 		id = ENEMY_GRANDMA;
 		type = ENEMY_PEACEFUL;
-	} else if (r < 18 && (gd.ecount[ENEMY_PEACEFUL] < s->limits[ENEMY_PEACEFUL])) {
+	} else if (r < 18 && (gd->ecount[ENEMY_PEACEFUL] < s->limits[ENEMY_PEACEFUL])) {
 		id = ENEMY_LITTLE_GIRL;
 		type = ENEMY_PEACEFUL;
-	} else if (r < 30 && (gd.ecount[ENEMY_VICIOUS] < s->limits[ENEMY_VICIOUS])) {
+	} else if (r < 30 && (gd->ecount[ENEMY_VICIOUS] < s->limits[ENEMY_VICIOUS])) {
 		id = ENEMY_DRUNKEN_PUNK;
 		type = ENEMY_VICIOUS;
-	} else if (r < 60 && (gd.ecount[ENEMY_THIEF] < s->limits[ENEMY_THIEF])) {
+	} else if (r < 60 && (gd->ecount[ENEMY_THIEF] < s->limits[ENEMY_THIEF])) {
 		id = ENEMY_HACKER;
 		type = ENEMY_THIEF;
-	} else if  (gd.ecount[ENEMY_VICIOUS] < s->limits[ENEMY_VICIOUS]) {
+	} else if  (gd->ecount[ENEMY_VICIOUS] < s->limits[ENEMY_VICIOUS]) {
 		id = ENEMY_RAIDER;
 		type = ENEMY_VICIOUS;
 	} else
@@ -1534,7 +1750,7 @@ static uint8_t enemy_generate_random(struct enemy *e)
 	e->id = id;
 	e->type = type;
 	if (type < ENEMY_BOSS)
-		gd.ecount[type]++;
+		gd->ecount[type]++;
 
 	return 1;
 }
@@ -1574,42 +1790,49 @@ static void enemy_set_state(struct enemy *e, uint8_t state, uint8_t push)
 	e->frame = 0;
 }
 
-static void spawn_new_enemies(void)
+/* into a free slot, which stays cleared if the stage has enough enemies */
+static void spawn_enemy(struct game_context *g, struct enemy *e)
+{
+	memset(e, 0, sizeof(*e));
+	if (!enemy_generate_random(g, e))
+		return;
+	e->active = 1;
+	e->width = img_width(enemy_sprites[e->id]);
+	e->height = img_height(enemy_sprites[e->id]);
+	e->lane = 1 + random8(g, 2);
+	if (e->type == ENEMY_VICIOUS)
+		e->pee_x = WIDTH - e->width * 2 - random8(g, 64);
+	/* calculate point where to start hacking */
+	if (e->type == ENEMY_THIEF)
+		e->dx = random8(g, WIDTH - e->width);
+	e->y = lane_y[e->lane] - e->height;
+	e->x = WIDTH;
+	e->mtime = enemy_mtime[e->id];
+	e->rtime = enemy_rtime[e->id];
+	e->atime = enemy_atime[e->id];
+	e->life = enemy_life[e->id];
+	e->damage = enemy_damage[e->id];
+	enemy_set_state(e, ENEMY_WALKING_LEFT, 0);
+	enemy_set_state(e, ENEMY_WALKING_LEFT, 1);
+	e->flags = __flag_white;
+}
+
+static void spawn_new_enemies(struct game_context *g)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t i = 0;
 	struct enemy *e;
 
 	/* update and spawn enemies */
 	do {
-		e = &gd.enemies[i];
+		e = &gd->enemies[i];
 		if (e->active)
 			continue;
-		memset(e, 0, sizeof(*e));
-		if (!enemy_generate_random(e))
-			break;
-		e->active = 1;
-		e->width = img_width(enemy_sprites[e->id]);
-		e->height = img_height(enemy_sprites[e->id]);
-		e->lane = 1 + random8(2);
-		if (e->type == ENEMY_VICIOUS)
-			e->pee_x = WIDTH - e->width * 2 - random8(64);
-		/* calculate point where to start hacking */
-		if (e->type == ENEMY_THIEF)
-			e->dx = random8(WIDTH - e->width);
-		e->y = lane_y[e->lane] - e->height;
-		e->x = WIDTH;
-		e->mtime = enemy_mtime[e->id];
-		e->rtime = enemy_rtime[e->id];
-		e->atime = enemy_atime[e->id];
-		e->life = enemy_life[e->id];
-		e->damage = enemy_damage[e->id];
-		enemy_set_state(e, ENEMY_WALKING_LEFT, 0);
-		enemy_set_state(e, ENEMY_WALKING_LEFT, 1);
-		e->flags = __flag_white;
+		spawn_enemy(g, e);
 		break;
 	} while (++i < MAX_ENEMIES);
 
-	start_timer(TIMER_ENEMY_SPAWN, ENEMIES_SPAWN_RATE);
+	start_timer(g, TIMER_ENEMY_SPAWN, ENEMIES_SPAWN_RATE);
 }
 
 static uint8_t enemy_switch_lane(struct enemy *e, uint8_t lane, uint8_t y)
@@ -1635,12 +1858,13 @@ static uint8_t enemy_switch_lane(struct enemy *e, uint8_t lane, uint8_t y)
 	return 0;
 }
 
-static void enemy_prepare_direction_change(struct enemy *e)
+static void enemy_prepare_direction_change(struct game_context *g,
+					   struct enemy *e)
 {
 	uint8_t min;
-	e->dlane = 1 + random8(2);
+	e->dlane = 1 + random8(g, 2);
 	min = abs(lane_y[e->lane] - lane_y[e->dlane]) + e->width + 1;
-	e->dx = e->x + min + random8(WIDTH - 2 * min - e->x);
+	e->dx = e->x + min + random8(g, WIDTH - 2 * min - e->x);
 }
 
 static uint8_t enemy_pee_pee_done(struct enemy *e)
@@ -1651,199 +1875,219 @@ static uint8_t enemy_pee_pee_done(struct enemy *e)
 	return 0;
 }
 
-static void update_enemies(void)
+/* what the bullets do, damage is more than 0 */
+static void enemy_hit(struct game_context *g, struct enemy *e, uint8_t damage)
 {
-	uint8_t damage;
-	uint8_t i = 0;
-	struct enemy *e;
-	struct player *p = &gd.player;
-	struct door *d = &gd.door;
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
+	struct door *d = &gd->door;
+
+	/* check if enemy gets poisoned */
+	if (p->poison)
+		e->poisoned = 4;
+	e->life -= damage; /* do damage */
+	if (e->type != ENEMY_PEACEFUL) {
+		/* blink for 1 sec */
+		e->hit = FPS;
+	}
+	if (e->life <= 0) {
+		if (d->attacker == e) {
+			d->attacker = NULL;
+			d->under_attack = 0;
+		}
+		e->atime = FPS;
+
+		p->score += enemy_score[e->id];
+		if (p->score < 0)
+			p->score = 0;
+		enemy_set_state(e, ENEMY_DYING, 0);
+	} else {
+		if (e->state != ENEMY_SPECIAL && e->state != ENEMY_RESTING_SWEARING) {
+			switch (e->type) {
+			case ENEMY_PEACEFUL:
+				enemy_set_state(e, ENEMY_RESTING_SWEARING, 1);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+}
+
+/* what an enemy does in its state */
+static void enemy_act(struct game_context *g, struct enemy *e)
+{
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
+	struct door *d = &gd->door;
+	struct stage *s = &gd->stage;
 	struct enemy *a;
-	struct stage *s = &gd.stage;
-	struct rect r;
 
-	/* update and spawn enemies */
-	do {
-		e = &gd.enemies[i];
-		if (!e->active)
-			continue;
+	switch (e->state) {
+	case ENEMY_WALKING_LEFT:
+		e->flags &= ~__flag_h_mirror;
+		if (e->mtime)
+			break;
 
-		/* check if hit by bullet */
-		damage = 0;
-		if (e->life > 0) {
-			r.x = e->x;
-			r.y = e->y;
-			r.xe = e->x + e->width;
-			r.ye = e->y + e->height;
-			damage = get_bullet_damage(e->lane, &r);
-			if (e->poisoned) {
-				if (e->poison_timeout)
-					e->poison_timeout--;
-				else {
-					damage += 2;
-					e->poison_timeout = 2 * FPS;
-					e->poisoned--;
-				}
+		switch (e->type) {
+		case ENEMY_BOSS:
+		case ENEMY_VICIOUS:
+			if (e->x == (6 + lane_y[e->lane] - lane_y[DOOR_LANE]))
+				enemy_set_state(e, ENEMY_APPROACH_DOOR, 1);
+			if (e->type == ENEMY_VICIOUS && e->pee_x == e->x) {
+				e->rtime = FPS * 3;
+				enemy_set_state(e, ENEMY_SPECIAL, 1);
 			}
-		}
-		if (damage) {
-			/* check if enemy gets poisoned */
-			if (p->poison)
-				e->poisoned = 4;
-			e->life -= damage; /* do damage */
-			if (e->type != ENEMY_PEACEFUL) {
-				/* blink for 1 sec */
-				e->hit = FPS;
-			}
-			if (e->life <= 0) {
-				if (d->attacker == e) {
-					d->attacker = NULL;
-					d->under_attack = 0;
-				}
-				e->atime = FPS;
-
-				p->score += enemy_score[e->id];
-				if (p->score < 0)
-					p->score = 0;
-				enemy_set_state(e, ENEMY_DYING, 0);
-			} else {
-				if (e->state != ENEMY_SPECIAL && e->state != ENEMY_RESTING_SWEARING) {
-					switch (e->type) {
-					case ENEMY_PEACEFUL:
-						enemy_set_state(e, ENEMY_RESTING_SWEARING, 1);
-						break;
-					default:
-						break;
-					}
-				}
+			break;
+		case ENEMY_THIEF:
+			if (e->x == e->dx) {
+				enemy_set_state(e, ENEMY_SPECIAL, 0);
+				enemy_set_state(e, ENEMY_RESTING_SWEARING, 1);
+				e->rtime = enemy_frame_reloads[e->id][e->state] * enemy_atime[e->id];
 			}
+			break;
+		default:
+			/* peaceful enemies just pass by */
+			if (e->x == -e->width)
+				e->active = 0;
+			break;
 		}
-
-		if (gd.ws.effects_active)
-			get_bullet_effect(e->lane, e);
-
-		switch (e->state) {
-		case ENEMY_WALKING_LEFT:
-			e->flags &= ~__flag_h_mirror;
-			if (e->mtime)
-				break;
-
-			switch (e->type) {
-			case ENEMY_BOSS:
-			case ENEMY_VICIOUS:
-				if (e->x == (6 + lane_y[e->lane] - lane_y[DOOR_LANE]))
-					enemy_set_state(e, ENEMY_APPROACH_DOOR, 1);
-				if (e->type == ENEMY_VICIOUS && e->pee_x == e->x) {
-					e->rtime = FPS * 3;
-					enemy_set_state(e, ENEMY_SPECIAL, 1);
-				}
-				break;
-			case ENEMY_THIEF:
-				if (e->x == e->dx) {
-					enemy_set_state(e, ENEMY_SPECIAL, 0);
-					enemy_set_state(e, ENEMY_RESTING_SWEARING, 1);
-					e->rtime = enemy_frame_reloads[e->id][e->state] * enemy_atime[e->id];
-				}
-				break;
-			default:
-				/* peaceful enemies just pass by */
-				if (e->x == -e->width)
-					e->active = 0;
+		e->x--;
+		break;
+	case ENEMY_APPROACH_DOOR:
+		/* peaceful enemies will not reach this state */
+		a = d->attacker;
+		if (d->under_attack && a != e) {
+			if (e->type == ENEMY_BOSS) {
+				/* move away for the boss */
+				enemy_flush_states(a);
+				enemy_prepare_direction_change(g, a);
+				enemy_set_state(a, ENEMY_WALKING_LEFT, 0);
+				enemy_set_state(a, ENEMY_WALKING_RIGHT, 1);
+			} else {
+				/* door is already under attack, take a walk */
+				enemy_prepare_direction_change(g, e);
+				enemy_set_state(e, ENEMY_WALKING_RIGHT, 0);
 				break;
 			}
-			e->x--;
-			break;
-		case ENEMY_APPROACH_DOOR:
-			/* peaceful enemies will not reach this state */
-			a = d->attacker;
-			if (d->under_attack && a != e) {
-				if (e->type == ENEMY_BOSS) {
-					/* move away for the boss */
-					enemy_flush_states(a);
-					enemy_prepare_direction_change(a);
-					enemy_set_state(a, ENEMY_WALKING_LEFT, 0);
-					enemy_set_state(a, ENEMY_WALKING_RIGHT, 1);
-				} else {
-					/* door is already under attack, take a walk */
-					enemy_prepare_direction_change(e);
-					enemy_set_state(e, ENEMY_WALKING_RIGHT, 0);
-					break;
-				}
-			}
-			d->under_attack = 1;
-			d->attacker = e;
-			e->dlane = DOOR_LANE;
+		}
+		d->under_attack = 1;
+		d->attacker = e;
+		e->dlane = DOOR_LANE;
 
-			e->dx = e->x - abs(lane_y[e->lane] - lane_y[e->dlane]);
-			if (enemy_switch_lane(e, e->dlane, lane_y[e->dlane] - e->height))
-				enemy_set_state(e, ENEMY_ATTACKING, 0);
+		e->dx = e->x - abs(lane_y[e->lane] - lane_y[e->dlane]);
+		if (enemy_switch_lane(e, e->dlane, lane_y[e->dlane] - e->height))
+			enemy_set_state(e, ENEMY_ATTACKING, 0);
 
+		break;
+	case ENEMY_WALKING_RIGHT:
+		e->flags |= __flag_h_mirror;
+		if (e->mtime)
 			break;
-		case ENEMY_WALKING_RIGHT:
-			e->flags |= __flag_h_mirror;
-			if (e->mtime)
-				break;
 
-			if (enemy_switch_lane(e, e->dlane, lane_y[e->dlane] - e->height)) {
-				if (e->pee_x == e->x) {
-					e->rtime = FPS * 5;
-					enemy_set_state(e, ENEMY_SPECIAL, 1);
-				}
-				if (e->x >= e->dx)
-					enemy_set_state(e, enemy_pop_state(e), 0);
-				else
-					e->x++;
+		if (enemy_switch_lane(e, e->dlane, lane_y[e->dlane] - e->height)) {
+			if (e->pee_x == e->x) {
+				e->rtime = FPS * 5;
+				enemy_set_state(e, ENEMY_SPECIAL, 1);
 			}
+			if (e->x >= e->dx)
+				enemy_set_state(e, enemy_pop_state(e), 0);
+			else
+				e->x++;
+		}
 
+		break;
+	case ENEMY_ATTACKING:
+		/* do door damage */
+		if (e->frame == (e->frame_reload - 1) && e->atime == 0) {
+			p->life -= enemy_damage[e->id];
+			g->arduboy.flash(MS_TO_FRAMES(100));
+			enemy_set_state(e, ENEMY_RESTING_SWEARING, 1);
+		}
+		break;
+	case ENEMY_SPECIAL:
+		switch (e->type)  {
+		case ENEMY_VICIOUS:
+			if (enemy_pee_pee_done(e))
+				enemy_set_state(e, enemy_pop_state(e), 0);
 			break;
-		case ENEMY_ATTACKING:
-			/* do door damage */
-			if (e->frame == (e->frame_reload - 1) && e->atime == 0) {
-				p->life -= enemy_damage[e->id];
-				enemy_set_state(e, ENEMY_RESTING_SWEARING, 1);
-			}
-			break;
-		case ENEMY_SPECIAL:
-			switch (e->type)  {
-			case ENEMY_VICIOUS:
-				if (enemy_pee_pee_done(e))
-					enemy_set_state(e, enemy_pop_state(e), 0);
-				break;
-			case ENEMY_THIEF:
-				if (e->rtime == 0) {
-					e->rtime = enemy_rtime[e->id];
-					p->score -= 8;
-					add_flying_number(e->x, e->y, -8);
-					if (p->score < 0)
-						p->score = 0;
-				} else
-					e->rtime--;
-				break;
-			}
-			break;
-		case ENEMY_RESTING_SWEARING:
-			if (e->type == ENEMY_PEACEFUL)
-				if (e->frame < e->frame_reload - 1)
-					break;
+		case ENEMY_THIEF:
 			if (e->rtime == 0) {
 				e->rtime = enemy_rtime[e->id];
-				enemy_set_state(e, enemy_pop_state(e), 0);
+				p->score -= 8;
+				add_flying_number(g, e->x, e->y, -8);
+				if (p->score < 0)
+					p->score = 0;
 			} else
 				e->rtime--;
 			break;
-		case ENEMY_DYING:
-			if (e->hit == 0)
-				enemy_set_state(e, ENEMY_DEAD, 0);
-			break;
-		case ENEMY_DEAD:
-			e->active = 0;
-			if (e->type != ENEMY_BOSS && !d->boss)
-				s->kills--;
-			if (e->type == ENEMY_BOSS)
-				d->boss = 1;
-			add_flying_number(e->x, e->y, enemy_score[e->id]);
-			break;
 		}
+		break;
+	case ENEMY_RESTING_SWEARING:
+		if (e->type == ENEMY_PEACEFUL)
+			if (e->frame < e->frame_reload - 1)
+				break;
+		if (e->rtime == 0) {
+			e->rtime = enemy_rtime[e->id];
+			enemy_set_state(e, enemy_pop_state(e), 0);
+		} else
+			e->rtime--;
+		break;
+	case ENEMY_DYING:
+		if (e->hit == 0)
+			enemy_set_state(e, ENEMY_DEAD, 0);
+		break;
+	case ENEMY_DEAD:
+		e->active = 0;
+		if (e->type != ENEMY_BOSS && !d->boss)
+			s->kills--;
+		if (e->type == ENEMY_BOSS)
+			d->boss = 1;
+		add_flying_number(g, e->x, e->y, enemy_score[e->id]);
+		break;
+	}
+}
+
+static void update_enemies(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
+	uint8_t damage;
+	uint8_t i = 0;
+	struct enemy *e;
+	struct rect r;
+
+	/* update and spawn enemies */
+	do {
+		e = &gd->enemies[i];
+		if (!e->active)
+			continue;
+
+		/* check if hit by bullet */
+		damage = 0;
+		if (e->life > 0) {
+			r.x = e->x;
+			r.y = e->y;
+			r.xe = e->x + e->width;
+			r.ye = e->y + e->height;
+			damage = get_bullet_damage(g, e->lane, &r);
+			if (e->poisoned) {
+				if (e->poison_timeout)
+					e->poison_timeout--;
+				else {
+					damage += 2;
+					e->poison_timeout = 2 * FPS;
+					e->poisoned--;
+				}
+			}
+		}
+		if (damage)
+			enemy_hit(g, e, damage);
+
+		if (gd->ws.effects_active)
+			get_bullet_effect(g, e->lane, e);
+
+		enemy_act(g, e);
+
 		/* next animation */
 		if (e->atime == 0) {
 			e->atime = enemy_atime[e->id];
@@ -1865,20 +2109,22 @@ static void update_enemies(void)
 		if (e->hit)
 			e->hit--;
 		if (e->active == 0 && e->type != ENEMY_BOSS)
-			gd.ecount[e->type]--;
+			gd->ecount[e->type]--;
 		if (e->slowdown)
 			e->slowdown--;
 	} while (++i < MAX_ENEMIES);
 }
 
-static void init_enemies(void)
+static void init_enemies(struct game_context *g)
 {
-	memset(&gd.door, 0, sizeof(gd.door));
-	memset(gd.enemies, 0, sizeof(gd.enemies));
+	struct game_data *gd = &g->state.gd;
+
+	memset(&gd->door, 0, sizeof(gd->door));
+	memset(gd->enemies, 0, sizeof(gd->enemies));
 
 	/* setup timer for enemy spawning */
-	setup_timer(TIMER_ENEMY_SPAWN, spawn_new_enemies);
-	start_timer(TIMER_ENEMY_SPAWN, ENEMIES_SPAWN_RATE);
+	setup_timer(g, TIMER_ENEMY_SPAWN, spawn_new_enemies);
+	start_timer(g, TIMER_ENEMY_SPAWN, ENEMIES_SPAWN_RATE);
 }
 
 /*---------------------------------------------------------------------------
@@ -1893,64 +2139,81 @@ enum power_up_type {
 	POWER_UP_MAX,
 };
 
-static void spawn_new_powerup(void)
+static void spawn_powerup(struct game_context *g, struct power_up *p)
 {
-	uint8_t i = 0, width, height;
-	struct power_up *p;
+	uint8_t width, height;
 
 	width = img_width(powerups_img);
 	height = img_height(powerups_img);
 
+	p->active = 1;
+	p->atime = MS_TO_FRAMES(150);
+	p->frame = 0;
+	p->timeout = 12 * FPS;
+	p->lane = 1 + random8(g, 2);
+	p->r.x = random8(g, WIDTH - width);
+	p->r.y = lane_y[p->lane] - height;
+	p->r.xe = p->r.x + width;
+	p->r.ye = p->r.y + height;
+	/* make life and poison less often */
+	p->type = random8(g, POWER_UP_MAX);
+}
+
+static void spawn_new_powerup(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
+	uint8_t i = 0;
+	struct power_up *p;
+
 	do {
-		p = &gd.power_ups[i];
+		p = &gd->power_ups[i];
 		if (p->active)
 			continue;
-		p->active = 1;
-		p->atime = MS_TO_FRAMES(150);
-		p->frame = 0;
-		p->timeout = 12 * FPS;
-		p->lane = 1 + random8(2);
-		p->r.x = random8(WIDTH - width);
-		p->r.y = lane_y[p->lane] - height;
-		p->r.xe = p->r.x + width;
-		p->r.ye = p->r.y + height;
-		/* make life and poison less often */
-		p->type = random8(POWER_UP_MAX);
+		spawn_powerup(g, p);
 		break;
 	} while (++i < MAX_POWERUPS);
 }
 
-static void update_powerups(void)
+/* what the player gets for hitting it */
+static void collect_powerup(struct game_context *g, struct power_up *pu)
 {
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
+
+	if (pu->type == POWER_UP_LIFE) {
+		p->life += 64;
+		add_flying_number(g, pu->r.x, pu->r.y, 64);
+		if (p->life > PLAYER_MAX_LIFE)
+			p->life = PLAYER_MAX_LIFE;
+	} else if (pu->type == POWER_UP_POISON) {
+		player_set_poison(g);
+	} else {
+		p->score += 200;
+		add_flying_number(g, pu->r.x, pu->r.y, 100);
+	}
+}
+
+static void update_powerups(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
 	uint8_t i = 0;
 	struct power_up *pu;
-	struct player *p = &gd.player;
 
 	do {
-		pu = &gd.power_ups[i];
+		pu = &gd->power_ups[i];
 		if (!pu->active)
 			continue;
 		pu->timeout--;
 		if (!pu->timeout) {
 			pu->active = 0;
-			start_timer(TIMER_POWERUP_SPAWN + i, (random8(8) + 4) * FPS);
+			start_timer(g, TIMER_POWERUP_SPAWN + i, (random8(g, 8) + 4) * FPS);
 			continue;
 		}
 		/* check if hit by player */
-		if (get_bullet_damage(pu->lane, &pu->r)) {
+		if (get_bullet_damage(g, pu->lane, &pu->r)) {
 			pu->active = 0;
-			start_timer(TIMER_POWERUP_SPAWN + i, (random8(8) + 4) * FPS);
-			if (pu->type == POWER_UP_LIFE) {
-				p->life += 64;
-				add_flying_number(pu->r.x, pu->r.y, 64);
-				if (p->life > PLAYER_MAX_LIFE)
-					p->life = PLAYER_MAX_LIFE;
-			} else if (pu->type == POWER_UP_POISON) {
-				player_set_poison();
-			} else {
-				p->score += 200;
-				add_flying_number(pu->r.x, pu->r.y, 100);
-			}
+			start_timer(g, TIMER_POWERUP_SPAWN + i, (random8(g, 8) + 4) * FPS);
+			collect_powerup(g, pu);
 		}
 
 		if (pu->atime) {
@@ -1964,39 +2227,76 @@ static void update_powerups(void)
 	} while (++i < MAX_POWERUPS);
 }
 
-static void init_powerups(void)
+static void init_powerups(struct game_context *g)
 {
-	memset(&gd.power_ups, 0, sizeof(gd.power_ups));
-	setup_timer(TIMER_POWERUP_SPAWN, spawn_new_powerup);
-	start_timer(TIMER_POWERUP_SPAWN, random8(8) * FPS + ENEMIES_SPAWN_RATE);
-	setup_timer(TIMER_POWERUP_SPAWN + 1, spawn_new_powerup);
-	start_timer(TIMER_POWERUP_SPAWN + 1, random8(8) * FPS + ENEMIES_SPAWN_RATE);
+	struct game_data *gd = &g->state.gd;
+
+	memset(&gd->power_ups, 0, sizeof(gd->power_ups));
+	setup_timer(g, TIMER_POWERUP_SPAWN, spawn_new_powerup);
+	start_timer(g, TIMER_POWERUP_SPAWN, random8(g, 8) * FPS + ENEMIES_SPAWN_RATE);
+	setup_timer(g, TIMER_POWERUP_SPAWN + 1, spawn_new_powerup);
+	start_timer(g, TIMER_POWERUP_SPAWN + 1, random8(g, 8) * FPS + ENEMIES_SPAWN_RATE);
 }
 
 /*---------------------------------------------------------------------------
  * scene handling
  *---------------------------------------------------------------------------*/
-static uint8_t lamp_frame = 0;
 
-static void update_scene(void)
+/* the texts of a new stage or boss */
+static void update_bumps(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
+
+	if (gd->boss_time) {
+		struct bumping_img *bi = gd->bump;
+		uint8_t ret = 0;
+		ret += img_bump(g, &bi[0], characters_13x16_img, CHAR_B);
+		ret += img_bump(g, &bi[1], characters_13x16_img, CHAR_O);
+		ret += img_bump(g, &bi[2], characters_13x16_img, CHAR_S);
+		ret += img_bump(g, &bi[3], characters_13x16_img, CHAR_S);
+		ret += img_bump(g, &bi[4], characters_13x16_img, CHAR_T);
+		ret += img_bump(g, &bi[5], characters_13x16_img, CHAR_I);
+		ret += img_bump(g, &bi[6], characters_13x16_img, CHAR_M);
+		ret += img_bump(g, &bi[7], characters_13x16_img, CHAR_E);
+		if (ret == 8)
+			gd->boss_time--;
+	}
+
+	if (gd->stage_time) {
+		struct bumping_img *bi = gd->bump;
+		uint8_t ret = 0;
+		ret += img_bump(g, &bi[0], characters_13x16_img, CHAR_S);
+		ret += img_bump(g, &bi[1], characters_13x16_img, CHAR_T);
+		ret += img_bump(g, &bi[2], characters_13x16_img, CHAR_A);
+		ret += img_bump(g, &bi[3], characters_13x16_img, CHAR_G);
+		ret += img_bump(g, &bi[4], characters_13x16_img, CHAR_E);
+		ret += img_bump(g, &bi[5], characters_13x16_img, CHAR_1 + gd->stage_nr);
+		if (ret == 6)
+			gd->stage_time--;
+	}
+}
+
+static void update_scene(struct game_context *g)
 {
+	struct game_data *gd = &g->state.gd;
+
 	/* update scene animations */
 
 	/* show selected weapon icon */
-	if (gd.ws.selected != gd.ws.previous) {
-		if (gd.ws.direction) {
-			if (gd.ws.icon_x == WIDTH - img_width(weapons_img))
-				gd.ws.previous = gd.ws.selected;
+	if (gd->ws.selected != gd->ws.previous) {
+		if (gd->ws.direction) {
+			if (gd->ws.icon_x == WIDTH - img_width(weapons_img))
+				gd->ws.previous = gd->ws.selected;
 			else {
-				gd.ws.stime = FPS;
-				gd.ws.icon_x-=2;
+				gd->ws.stime = FPS;
+				gd->ws.icon_x-=2;
 			}
 		} else {
-			if (gd.ws.icon_x == 0)
-				gd.ws.previous = gd.ws.selected;
+			if (gd->ws.icon_x == 0)
+				gd->ws.previous = gd->ws.selected;
 			else {
-				gd.ws.stime = FPS;
-				gd.ws.icon_x+=2;
+				gd->ws.stime = FPS;
+				gd->ws.icon_x+=2;
 			}
 		}
 	}
@@ -2004,67 +2304,46 @@ static void update_scene(void)
 	/* TODO add another lamp frame above the door */
 
 	/* update lamp animation */
-	if (gp_timer_ticks & 1)
-		lamp_frame = random8(2);
-
-	if (gd.boss_time) {
-		struct bumping_img *bi = (struct bumping_img *)&gd;
-		uint8_t ret = 0;
-		ret += img_bump(&bi[0], characters_13x16_img, CHAR_B);
-		ret += img_bump(&bi[1], characters_13x16_img, CHAR_O);
-		ret += img_bump(&bi[2], characters_13x16_img, CHAR_S);
-		ret += img_bump(&bi[3], characters_13x16_img, CHAR_S);
-		ret += img_bump(&bi[4], characters_13x16_img, CHAR_T);
-		ret += img_bump(&bi[5], characters_13x16_img, CHAR_I);
-		ret += img_bump(&bi[6], characters_13x16_img, CHAR_M);
-		ret += img_bump(&bi[7], characters_13x16_img, CHAR_E);
-		if (ret == 8)
-			gd.boss_time--;
-	}
+	if (g->state.gp_timer_ticks & 1)
+		g->state.lamp_frame = random8(g, 2);
 
-	if (gd.stage_time) {
-		struct bumping_img *bi = (struct bumping_img *)&gd;
-		uint8_t ret = 0;
-		ret += img_bump(&bi[0], characters_13x16_img, CHAR_S);
-		ret += img_bump(&bi[1], characters_13x16_img, CHAR_T);
-		ret += img_bump(&bi[2], characters_13x16_img, CHAR_A);
-		ret += img_bump(&bi[3], characters_13x16_img, CHAR_G);
-		ret += img_bump(&bi[4], characters_13x16_img, CHAR_E);
-		ret += img_bump(&bi[5], characters_13x16_img, CHAR_1 + gd.stage_nr);
-		if (ret == 6)
-			gd.stage_time--;
-	}
+	update_bumps(g);
 }
 
 /*---------------------------------------------------------------------------
  * misc control functions
  *---------------------------------------------------------------------------*/
-static int check_game_over(void)
+static int check_game_over(struct game_context *g)
 {
-	struct player *p = &gd.player;
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
 
 	if (p->life <= 0)
 		return 1;
 	return 0;
 }
 
-static int check_win_game(void)
+static int check_win_game(struct game_context *g)
 {
-	if (gd.stage_nr == MAX_STAGES)
+	struct game_data *gd = &g->state.gd;
+
+	if (gd->stage_nr == MAX_STAGES)
 		return 1;
 	return 0;
 }
 /*---------------------------------------------------------------------------
  * rendering functions
  *---------------------------------------------------------------------------*/
-static void draw_digit(int8_t x, uint8_t y, uint8_t number)
+static void draw_digit(struct game_context *g, int8_t x, int16_t y,
+		       uint8_t number)
 {
 	if (number < 0 || number > 9)
 		return;
-	blit_image_frame(x, y, numbers_3x5_img, NULL, number, __flag_white);
+	blit_image_frame(g, x, y, numbers_3x5_img, NULL, number, __flag_white);
 }
 
-static void draw_number(int8_t x, uint8_t y, int32_t n, uint32_t divider, uint8_t flags)
+static void draw_number(struct game_context *g, int8_t x, int16_t y, int32_t n,
+			uint32_t divider, uint8_t flags)
 {
 	uint8_t digit;
 	uint8_t fill = flags & 1;
@@ -2077,12 +2356,12 @@ static void draw_number(int8_t x, uint8_t y, int32_t n, uint32_t divider, uint8_
 		if (digit || fill) {
 			if (sign && x >= 0) {
 				if (n > 0)
-					draw_vline(x + 1, y + 1, 3);
-				draw_hline(x, y + 2, 3);
+					draw_vline(g, x + 1, y + 1, 3);
+				draw_hline(g, x, y + 2, 3);
 				x += 4;
 			}
 			sign = 0;
-			draw_digit(x, y, digit);
+			draw_digit(g, x, y, digit);
 			fill = 1;
 		}
 		number %= divider;
@@ -2091,35 +2370,37 @@ static void draw_number(int8_t x, uint8_t y, int32_t n, uint32_t divider, uint8_
 	}
 }
 
-static void draw_player(void)
+static void draw_player(struct game_context *g)
 {
-	struct player *p = &gd.player;
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
 
-	blit_image_frame(p->x,
+	blit_image_frame(g, p->x,
 			 0,
 			 player_all_frames_img,
 			 NULL,
 			 player_frame_offsets[p->state] + p->frame,
 			 __flag_white);
 	if (p->poison)
-		blit_image(p->x + img_width(player_all_frames_img),
+		blit_image(g, p->x + img_width(player_all_frames_img),
 			   0,
 			   poison_damage_img,
 			   NULL,
 			   __flag_white);
 }
 
-static void draw_enemies(void)
+static void draw_enemies(struct game_context *g)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t i = 0;
 	struct enemy *e;
 
 	do {
-		e = &gd.enemies[i];
+		e = &gd->enemies[i];
 		if (!e->active)
 			continue;
 		if (!(e->hit & 1)) {
-			blit_image_frame(e->x,
+			blit_image_frame(g, e->x,
 					 e->y,
 					 enemy_sprites[e->id],
 					 enemy_masks[e->id],
@@ -2129,15 +2410,16 @@ static void draw_enemies(void)
 	} while (++i < MAX_ENEMIES);
 }
 
-static void draw_powerups(void)
+static void draw_powerups(struct game_context *g)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t i = 0;
 	struct power_up *p;
 
 	do {
-		p = &gd.power_ups[i];
+		p = &gd->power_ups[i];
 		if (p->active)
-			blit_image_frame(p->r.x,
+			blit_image_frame(g, p->r.x,
 					 p->r.y,
 					 powerups_img,
 					 powerups_mask_img,
@@ -2146,56 +2428,68 @@ static void draw_powerups(void)
 	} while (++i < MAX_POWERUPS);
 }
 
-static void draw_life_bar(uint8_t x, uint8_t y, int16_t current, int16_t max,
-			  uint8_t blink)
+/* opt holds the life level, with 8 for the frame around it */
+static void draw_life_level(void *context, const void *arg, int16_t x,
+			    int16_t y, uint8_t opt)
+{
+	struct game_context *g = (struct game_context *)context;
+	uint8_t life_level = opt & 7;
+
+	if (opt & 8)
+		draw_rect(g, x, y, 15, 5);
+	while (life_level--)
+		draw_hline(g, x + 2 + (3 * life_level), y + 2, 2);
+}
+
+static void draw_life_bar(struct game_context *g, uint8_t x, uint8_t y,
+			  int16_t current, int16_t max, uint8_t blink)
 {
 	int16_t life_level;
+	uint8_t opt;
 
+	if (!rendering(g))
+		return;
 	/* draw current life */
 	life_level = (current * 4 + max - 1) / max;
-	if (life_level > 2 || !blink) {
-		draw_rect(x, y, 15, 5);
-	} else {
-		if (gp_timer_ticks & 1)
-			draw_rect(x, y, 15, 5);
-	}
-
-	while (life_level--)
-		draw_hline(x + 2 + (3 * life_level), y + 2, 2);
+	opt = life_level > 0 ? life_level : 0;
+	if (life_level > 2 || !blink || (g->state.gp_timer_ticks & 1))
+		opt |= 8;
+	/* one command of a strip renderer */
+	g->arduboy.drawDeferred(draw_life_level, NULL, x, y, opt);
 }
 
-static void draw_scene(void)
+static void draw_scene(struct game_context *g)
 {
-	struct player *p = &gd.player;
-	struct door *d = &gd.door;
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
+	struct door *d = &gd->door;
 
-	draw_life_bar(0, 59, p->life, PLAYER_MAX_LIFE, 1);
+	draw_life_bar(g, 0, 59, p->life, PLAYER_MAX_LIFE, 1);
 	if (d->under_attack) {
 		struct enemy *e = d->attacker;
-		draw_life_bar(20, 59, e->life, enemy_life[e->id], 0);
+		draw_life_bar(g, 20, 59, e->life, enemy_life[e->id], 0);
 	}
 
-	if (gd.ws.stime) {
-		blit_image_frame(gd.ws.icon_x,
+	if (gd->ws.stime) {
+		blit_image_frame(g, gd->ws.icon_x,
 				 0,
 				 weapons_img,
 				 NULL,
-				 gd.ws.selected,
+				 gd->ws.selected,
 				 __flag_white);
-		gd.ws.stime--;
 	}
 
 	/* draw weather animation */
 	/* TODO */
 
 	/* draw lamp animation */
-	blit_image(56,
+	blit_image(g, 56,
 		   HEIGHT - img_height(scene_lamp_img),
 		   scene_lamp_img,
 		   NULL,
 		   __flag_white);
-	if (lamp_frame)
-		draw_hline(59, HEIGHT - img_height(scene_lamp_img) + 1, 3);
+	if (g->state.lamp_frame)
+		draw_hline(g, 59, HEIGHT - img_height(scene_lamp_img) + 1, 3);
 }
 
 static const uint8_t *bullet_effect[NR_WEAPONS] = {
@@ -2212,14 +2506,15 @@ static const uint8_t *bullet_effect_mask[NR_WEAPONS] = {
 	bomb_explode_mask_img,
 };
 
-static void draw_bullets(void)
+static void draw_bullets(struct game_context *g)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t b = 0, y;
 	struct bullet *bs;
 	uint8_t width, height;
 
 	do {
-		bs = &gd.ws.bs[b];
+		bs = &gd->ws.bs[b];
 		if (bs->state == BULLET_EFFECT) {
 			width = img_width(bullet_effect[bs->weapon]);
 			y = lane_y[bs->lane];
@@ -2229,21 +2524,21 @@ static void draw_bullets(void)
 				height = img_height(bullet_effect[bs->weapon]);
 				y -= height;
 			}
-			blit_image_frame(bs->x - width / 2,
+			blit_image_frame(g, bs->x - width / 2,
 					 y,
 					 bullet_effect[bs->weapon],
 					 bullet_effect_mask[bs->weapon],
 					 bs->frame,
 					 __flag_white | __flag_mask_single);
 		} else if (bs->state == BULLET_SPLASH) {
-			blit_image_frame(bs->x,
+			blit_image_frame(g, bs->x,
 					 bs->ys,
 					 bomb_splash_img,
 					 NULL,
 					 bs->frame,
 					 __flag_white);
 		} else if (bs->state == BULLET_ACTIVE) {
-			blit_image_frame(bs->x,
+			blit_image_frame(g, bs->x,
 					 bs->ys,
 					 water_bomb_air_img,
 					 water_bomb_air_mask_img,
@@ -2253,32 +2548,45 @@ static void draw_bullets(void)
 	} while (++b < NR_BULLETS);
 }
 
-static void draw_score(void)
+static void draw_score(struct game_context *g)
 {
-	struct player *p = &gd.player;
-	draw_number(100, 59, p->score, 1000000, 1);
+	struct game_data *gd = &g->state.gd;
+	struct player *p = &gd->player;
+	print_number(g, 100, 59, &p->score, 7, 1);
 }
 
-static void draw_screen(void)
+static void draw_screen(struct game_context *g)
 {
 	/* draw main scene */
-	blit_image(0, 13, game_background_img, NULL, __flag_white);
+	blit_image(g, 0, 13, BACKGROUND_IMG, NULL, BACKGROUND_FLAGS);
 	/* draw player */
-	draw_player();
+	draw_player(g);
 	/* draw powerups */
-	draw_powerups();
+	draw_powerups(g);
 	/* draw enemies */
-	draw_enemies();
+	draw_enemies(g);
 	/* update animations */
-	draw_bullets();
+	draw_bullets(g);
 	/* update flying numbers */
-	draw_flying_numbers();
+	draw_flying_numbers(g);
 	/* draw new score */
-	draw_score();
+	draw_score(g);
 	/* draw scene */
-	draw_scene();
+	draw_scene(g);
 }
 
+#ifdef ARDUBOY_STRIP_RENDERING
+/*
+ * A frame of play records the most commands: background, player and poison,
+ * powerups, enemies, bullets, flying numbers, score, two life bars, weapon
+ * icon, lamp and its light.  Menu, help and end screens record at most 13.
+ */
+#define PLAY_DRAW_COMMANDS	\
+	(1 + 2 + MAX_POWERUPS + MAX_ENEMIES + NR_BULLETS + 1 + 1 + 2 + 1 + 2)
+static_assert(DRAW_LIST_SIZE >= PLAY_DRAW_COMMANDS,
+	      "the draw list is too short for a frame of play");
+#endif
+
 static const char pause_str[] PROGMEM = "pause";
 static const char won_str[] PROGMEM = "you won";
 static const char new_highscore_str[] PROGMEM = "new highscore";
@@ -2289,165 +2597,182 @@ static const char won_story_str[] PROGMEM =
 "finally come to rest";
 
 static uint8_t
-run(void)
+run(struct game_context *g)
 {
+	struct game_data *gd = &g->state.gd;
 	uint8_t throws = 0;
 	int8_t dx = 0;
 	uint8_t rstate = PROGRAM_RUN_GAME;
-	struct bumping_img *bi = (struct bumping_img *)&gd;
+	struct bumping_img *bi = gd->bump;
 
-	switch (gd.game_state) {
+	switch (gd->game_state) {
 	case GAME_STATE_INIT:
-		init_flying_numbers();
-		init_timers();
-		init_player();
-		init_weapons();
-		init_enemies();
-		init_powerups();
-		init_stage();
-		init_img_bump(25);
-		gd.highscore = read_highscore();
+		init_flying_numbers(g);
+		init_timers(g);
+		init_player(g);
+		init_weapons(g);
+		init_enemies(g);
+		init_powerups(g);
+		init_stage(g);
+		init_img_bump(g, 25);
+		gd->highscore = read_highscore();
 
 		/* setup general purpose timer to 500ms */
-		gp_timer_ticks = 0;
-		setup_timer(TIMER_GP, gp_timer_count_fn);
-		start_timer(TIMER_GP, FPS / 2);
+		g->state.gp_timer_ticks = 0;
+		setup_timer(g, TIMER_GP, gp_timer_count_fn);
+		start_timer(g, TIMER_GP, FPS / 2);
 
-		gd.game_state = GAME_STATE_RUN_GAME;
-		delay(500);
+		gd->game_state = GAME_STATE_RUN_GAME;
+		start_transition(g);
 		break;
 	case GAME_STATE_RUN_GAME:
 		/* check for game over */
-		if (check_game_over()) {
-			init_timers();
+		if (check_game_over(g)) {
+			init_timers(g);
 			/* setup general purpose timer to 1s */
-			gp_timer_ticks = 0;
-			setup_timer(TIMER_GP, gp_timer_count_fn);
-			start_timer(TIMER_GP, FPS);
+			g->state.gp_timer_ticks = 0;
+			setup_timer(g, TIMER_GP, gp_timer_count_fn);
+			start_timer(g, TIMER_GP, FPS);
 
-			gd.game_state = GAME_STATE_OVER;
-			init_8_char_img_bump();
-			delay(500);
+			gd->game_state = GAME_STATE_OVER;
+			init_8_char_img_bump(g);
+			start_transition(g);
 			break;
 		}
 
-		if (check_win_game()) {
-			init_timers();
+		if (check_win_game(g)) {
+			init_timers(g);
 			/* setup general purpose timer to 1s */
-			gp_timer_ticks = 0;
-			setup_timer(TIMER_GP, gp_timer_count_fn);
-			start_timer(TIMER_GP, FPS);
+			g->state.gp_timer_ticks = 0;
+			setup_timer(g, TIMER_GP, gp_timer_count_fn);
+			start_timer(g, TIMER_GP, FPS);
 
-			gd.game_state = GAME_STATE_WON;
-			delay(500);
+			gd->game_state = GAME_STATE_WON;
+			start_transition(g);
 			break;
 		}
 
 		/* pause */
-		if (pressedUp() && pressedA()) {
-			gd.game_state = GAME_STATE_PAUSE_GAME;
-			gd.pause = 1;
+		if (pressedUp(g) && pressedA(g)) {
+			gd->game_state = GAME_STATE_PAUSE_GAME;
+			gd->pause = 1;
 			break;
 		}
 
 		/* check user inputs */
-		if (pressedUp()) {
-			select_weapon(-1);
-		} else if (pressedDown()) {
-			select_weapon(1);
-		} else if (left()) {
+		if (pressedUp(g)) {
+			select_weapon(g, -1);
+		} else if (pressedDown(g)) {
+			select_weapon(g, 1);
+		} else if (left(g)) {
 			/* move character to the left */
 			dx = -1;
-		} else if (right()) {
+		} else if (right(g)) {
 			/* move character to the right */
 			dx = 1;
 		}
-		if (a()) {
+		if (a(g)) {
 			/* throws bullet to the upper lane of the street */
-			throws = new_bullet(UPPER_LANE, gd.ws.selected);
+			throws = new_bullet(g, UPPER_LANE, gd->ws.selected);
 		}
-		if (b()) {
+		if (b(g)) {
 			/* throws bullet to the lower lane of the street */
-			throws = new_bullet(LOWER_LANE, gd.ws.selected);
+			throws = new_bullet(g, LOWER_LANE, gd->ws.selected);
 		}
 
 		/* update bullets */
-		update_bullets();
+		update_bullets(g);
 		/* update/spawn powerups */
-		update_powerups();
+		update_powerups(g);
 		/* update/spawn enemies */
-		update_enemies();
+		update_enemies(g);
 		/* update scene animations */
-		update_scene();
+		update_scene(g);
 		/* update player */
-		update_player(dx, throws);
+		update_player(g, dx, throws);
 		/* update stage */
-		update_stage();
+		update_stage(g);
 		/* update flying numbers */
-		update_flying_numbers();
+		update_flying_numbers(g);
 
-		draw_screen();
+		if (rendering(g))
+			draw_screen(g);
+		/* the weapon icon shows for stime frames, drawn or not */
+		if (gd->ws.stime)
+			gd->ws.stime--;
 
 		break;
 	case GAME_STATE_PAUSE_GAME:
-		print_text(pause_str, 0, 30, __text_centered);
-		if (gp_timer_ticks & 2)
-			blit_image(118, 55, icon_a_img, NULL, __flag_white);
-		if (pressedA()) {
-			gd.pause = 0;
-			gd.game_state = GAME_STATE_RUN_GAME;
+		if (g->state.draw_frame) {
+			print_text(g, pause_str, 0, 30, __text_centered);
+			if (g->state.gp_timer_ticks & 2)
+				blit_image(g, 118, 55, icon_a_img, NULL,
+					   __flag_white);
+		}
+		if (pressedA(g)) {
+			gd->pause = 0;
+			gd->game_state = GAME_STATE_RUN_GAME;
 		}
 		break;
 	case GAME_STATE_WON: {
 		/* print score */
-		struct player *p = &gd.player;
-		print_text(won_str, 0, 10, __text_centered);
-		if (p->score > gd.highscore)
-			print_text(&new_highscore_str[4], 10, 20, 0);
-		draw_number(50, 20, p->score, 1000000, 1);
-		print_text(won_story_str, 10, 30, __text_centered);
-		if (gp_timer_ticks & 1)
-			blit_image(118, 55, icon_a_img, NULL, __flag_white);
-		if (pressedA())
-			gd.game_state = GAME_STATE_CLEANUP;
+		struct player *p = &gd->player;
+		if (g->state.draw_frame) {
+			print_text(g, won_str, 0, 10, __text_centered);
+			if (p->score > gd->highscore)
+				print_text(g, &new_highscore_str[4], 10, 20, 0);
+			print_number(g, 50, 20, &p->score, 7, 1);
+			print_text(g, won_story_str, 10, 30, __text_centered);
+			if (g->state.gp_timer_ticks & 1)
+				blit_image(g, 118, 55, icon_a_img, NULL,
+					   __flag_white);
+		}
+		if (pressedA(g))
+			gd->game_state = GAME_STATE_CLEANUP;
 		break;
 	}
 	case GAME_STATE_OVER:
 	{
 		uint8_t ret = 0;
-		struct player *p = &gd.player;
-		ret += img_bump(&bi[0], characters_13x16_img, CHAR_G);
-		ret += img_bump(&bi[1], characters_13x16_img, CHAR_A);
-		ret += img_bump(&bi[2], characters_13x16_img, CHAR_M);
-		ret += img_bump(&bi[3], characters_13x16_img, CHAR_E);
-		ret += img_bump(&bi[4], characters_13x16_img, CHAR_O);
-		ret += img_bump(&bi[5], characters_13x16_img, CHAR_V);
-		ret += img_bump(&bi[6], characters_13x16_img, CHAR_E);
-		ret += img_bump(&bi[7], characters_13x16_img, CHAR_R);
+		struct player *p = &gd->player;
+		/* frames are only held once all letters have settled */
+		if (!g->state.draw_frame) {
+			if (pressedA(g))
+				gd->game_state = GAME_STATE_CLEANUP;
+			break;
+		}
+		ret += img_bump(g, &bi[0], characters_13x16_img, CHAR_G);
+		ret += img_bump(g, &bi[1], characters_13x16_img, CHAR_A);
+		ret += img_bump(g, &bi[2], characters_13x16_img, CHAR_M);
+		ret += img_bump(g, &bi[3], characters_13x16_img, CHAR_E);
+		ret += img_bump(g, &bi[4], characters_13x16_img, CHAR_O);
+		ret += img_bump(g, &bi[5], characters_13x16_img, CHAR_V);
+		ret += img_bump(g, &bi[6], characters_13x16_img, CHAR_E);
+		ret += img_bump(g, &bi[7], characters_13x16_img, CHAR_R);
 		if (ret == 8) {
-			if (p->score > gd.highscore) {
-				print_text(new_highscore_str, 0, 45,
+			if (p->score > gd->highscore) {
+				print_text(g, new_highscore_str, 0, 45,
 					   __text_centered);
 			} else {
-				print_text(&new_highscore_str[4], 10, 45, 0);
-				draw_number(50, 45, gd.highscore, 1000000, 1);
+				print_text(g, &new_highscore_str[4], 10, 45, 0);
+				print_number(g, 50, 45, &gd->highscore, 7, 1);
 			}
-			draw_number(50, 52, p->score, 1000000, 1);
-			if (gp_timer_ticks & 1)
-				blit_image(118, 55, icon_a_img, NULL,
+			print_number(g, 50, 52, &p->score, 7, 1);
+			if (g->state.gp_timer_ticks & 1)
+				blit_image(g, 118, 55, icon_a_img, NULL,
 					   __flag_white);
-			if (pressedA())
-				gd.game_state = GAME_STATE_CLEANUP;
+			if (pressedA(g))
+				gd->game_state = GAME_STATE_CLEANUP;
 		}
 		break;
 	}
 	case GAME_STATE_CLEANUP:
-		init_timers();
+		init_timers(g);
 		rstate = PROGRAM_MAIN_MENU;
-		if (gd.player.score > gd.highscore)
-			write_highscore(gd.player.score);
-		memset(&gd, 0, sizeof(gd));
-		delay(500);
+		if (gd->player.score > gd->highscore)
+			write_highscore(gd->player.score);
+		memset(gd, 0, sizeof(*gd));
+		start_transition(g);
 		break;
 	}
 	return rstate;
@@ -2456,9 +2781,7 @@ run(void)
 /*---------------------------------------------------------------------------
  * loop
  *---------------------------------------------------------------------------*/
-typedef uint8_t (*state_fn_t)(void);
-/* state of the program */
-static uint8_t main_state = PROGRAM_MAIN_MENU;
+typedef uint8_t (*state_fn_t)(struct game_context *g);
 
 static const state_fn_t main_state_fn[PROGRAM_STATE_MAX] = {
 	mainscreen,
@@ -2466,13 +2789,1555 @@ static const state_fn_t main_state_fn[PROGRAM_STATE_MAX] = {
 	help,
 };
 
+static uint8_t bumps_settled(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
+	uint8_t i = 0;
+
+	do {
+		if (gd->bump[i].i != 7)
+			return 0;
+	} while (++i < NR_BUMPING_IMGS);
+	return 1;
+}
+
+static uint16_t frame_key(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
+	uint8_t phase;
+
+	if (g->state.main_state == PROGRAM_SHOW_HELP &&
+	    gd->game_state == GAME_STATE_RUN_GAME) {
+		phase = g->state.gp_timer_ticks & 1;
+	} else if (g->state.main_state != PROGRAM_RUN_GAME) {
+		return FRAME_DYNAMIC;
+	} else if (gd->game_state == GAME_STATE_PAUSE_GAME) {
+		phase = !!(g->state.gp_timer_ticks & 2);
+	} else if (gd->game_state == GAME_STATE_WON ||
+		   (gd->game_state == GAME_STATE_OVER && bumps_settled(g))) {
+		phase = g->state.gp_timer_ticks & 1;
+	} else {
+		return FRAME_DYNAMIC;
+	}
+	return (g->state.main_state << 12) | (gd->game_state << 8) | phase;
+}
+
+/* clears the screen unless it would only be drawn like the last one */
+static void begin_frame(struct game_context *g)
+{
+	uint16_t key = frame_key(g);
+
+	g->state.draw_frame = key == FRAME_DYNAMIC || key != g->state.last_key;
+	g->state.last_key = key;
+#ifdef HOST_TEST
+	if (!rendering(g)) {
+		g->render_skipped = 1;
+		return;
+	}
+	/*
+	 * The screen shows an older frame, so draw this one whole.  That does
+	 * not change the game: a screen is only held once it stopped changing.
+	 */
+	if (g->render_skipped) {
+		g->state.draw_frame = 1;
+		g->render_skipped = 0;
+	}
+#endif
+	if (g->state.draw_frame)
+		g->arduboy.clear();
+	else
+		g->arduboy.holdFrame();
+}
+
 void
 loop(void)
 {
-	if (!next_frame())
+	struct game_context *g = game;
+
+	if (!next_frame(g))
 		return;
 
-	main_state = main_state_fn[main_state]();
+	begin_frame(g);
+	g->state.main_state = main_state_fn[g->state.main_state](g);
+
+	finish_frame(g);
+}
+
+#ifdef HOST_TEST
+/*---------------------------------------------------------------------------
+ * simulation status
+ *---------------------------------------------------------------------------*/
+static_assert(GAME_MAX_LIFE == PLAYER_MAX_LIFE &&
+	      GAME_STAGES == MAX_STAGES &&
+	      GAME_ENEMIES == MAX_ENEMIES &&
+	      GAME_FEATURES == 16 + MAX_ENEMIES * 8 + NR_BULLETS * 6 +
+	      MAX_POWERUPS * 5, "Fatsche.h is out of date");
+
+void game_status(struct game_context *g, struct game_status *s)
+{
+	struct game_state *gs = &g->state;
+	struct game_data *gd = &gs->gd;
+	struct player *p = &gd->player;
+	struct enemy *e;
+	uint8_t i = 0;
+
+	memset(s, 0, sizeof(*s));
+	s->playing = gs->main_state == PROGRAM_RUN_GAME &&
+		gd->game_state != GAME_STATE_INIT &&
+		gd->game_state != GAME_STATE_CLEANUP;
+	if (gd->game_state == GAME_STATE_OVER)
+		s->result = GAME_LOST;
+	else if (gd->game_state == GAME_STATE_WON)
+		s->result = GAME_WON;
+	s->stage = gd->stage_nr;
+	s->weapon = gd->ws.selected;
+	s->ammo = gd->ws.ammo[gd->ws.selected];
+	s->cool_down = gd->ws.cool_down[gd->ws.selected];
+	s->x = p->x;
+	s->width = img_width(player_all_frames_img);
+	s->life = p->life;
+	s->score = p->score;
+	do {
+		e = &gd->enemies[i];
+		if (!e->active || e->state >= ENEMY_DYING)
+			continue;
+		s->enemies[s->nr_enemies].x = e->x;
+		s->enemies[s->nr_enemies].width = e->width;
+		s->enemies[s->nr_enemies].lane = e->lane;
+		s->enemies[s->nr_enemies].hostile = e->type != ENEMY_PEACEFUL;
+		s->nr_enemies++;
+	} while (++i < MAX_ENEMIES);
+}
+
+void game_features(struct game_context *g, float *f)
+{
+	struct game_data *gd = &g->state.gd;
+	struct enemy *e;
+	struct bullet *bs;
+	struct power_up *pu;
+	uint8_t i;
+
+	*f++ = gd->player.x;
+	*f++ = gd->player.life;
+	*f++ = gd->player.score;
+	*f++ = gd->stage_nr;
+	*f++ = gd->stage.kills;
+	*f++ = gd->ws.selected;
+	*f++ = gd->door.under_attack;
+	*f++ = gd->door.boss;
+	for (i = 0; i < NR_WEAPONS; i++)
+		*f++ = gd->ws.ammo[i];
+	for (i = 0; i < NR_WEAPONS; i++)
+		*f++ = gd->ws.cool_down[i];
+	for (i = 0; i < MAX_ENEMIES; i++) {
+		e = &gd->enemies[i];
+		*f++ = e->active;
+		*f++ = e->id;
+		*f++ = e->x;
+		*f++ = e->y;
+		*f++ = e->lane;
+		*f++ = e->life;
+		*f++ = e->state;
+		*f++ = e->slowdown != 0;
+	}
+	for (i = 0; i < NR_BULLETS; i++) {
+		bs = &gd->ws.bs[i];
+		*f++ = bs->state;
+		*f++ = bs->weapon;
+		*f++ = bs->x;
+		*f++ = bs->ys;
+		*f++ = bs->lane;
+		*f++ = bs->etime;
+	}
+	for (i = 0; i < MAX_POWERUPS; i++) {
+		pu = &gd->power_ups[i];
+		*f++ = pu->active;
+		*f++ = pu->type;
+		*f++ = pu->r.x;
+		*f++ = pu->lane;
+		*f++ = pu->timeout;
+	}
+}
+
+/*---------------------------------------------------------------------------
+ * checksum
+ *---------------------------------------------------------------------------*/
+static uint64_t fnv(uint64_t h, const void *data, size_t size)
+{
+	const uint8_t *p = (const uint8_t *)data;
+
+	while (size--)
+		h = (h ^ *p++) * 0x100000001b3ULL;
+	return h;
+}
+
+/* the timer functions by number, their addresses differ between runs */
+static const timeout_fn timer_fns[] = {
+	NULL,
+	gp_timer_count_fn,
+	player_is_resting,
+	spawn_new_enemies,
+	spawn_new_powerup,
+};
+#define NR_TIMER_FNS		(sizeof(timer_fns) / sizeof(timer_fns[0]))
+
+static uint8_t timer_fn_index(timeout_fn fn)
+{
+	uint8_t i = 0;
+
+	while (i < NR_TIMER_FNS && timer_fns[i] != fn)
+		i++;
+	return i;
+}
+
+uint64_t game_checksum(struct game_context *g)
+{
+	struct game_state *gs = &g->state;
+	struct game_data *gd = &gs->gd;
+	struct game_data d;
+	uint64_t h = 0xcbf29ce484222325ULL;
+	uintptr_t attacker = 0;
+	uint16_t t[3];
+	uint8_t i = 0;
 
-	finish_frame();
+	/* the attacker as an index, pointers differ between runs */
+	memcpy(&d, gd, sizeof(d));
+	if (gd->door.attacker)
+		attacker = gd->door.attacker - gd->enemies + 1;
+	memset(&d.door.attacker, 0, sizeof(d.door.attacker));
+	memcpy(&d.door.attacker, &attacker, sizeof(attacker));
+	h = fnv(h, &d, sizeof(d));
+	do {
+		t[0] = gs->timers[i].active;
+		t[1] = gs->timers[i].timeout;
+		t[2] = timer_fn_index(gs->timers[i].fn);
+		h = fnv(h, t, sizeof(t));
+	} while (++i < TIMER_MAX);
+	h = fnv(h, gs->flying_numbers, sizeof(gs->flying_numbers));
+	h = fnv(h, &gs->gp_timer_ticks, sizeof(gs->gp_timer_ticks));
+	h = fnv(h, &gs->lamp_frame, sizeof(gs->lamp_frame));
+	h = fnv(h, &gs->bump_ye, sizeof(gs->bump_ye));
+	h = fnv(h, &gs->main_state, sizeof(gs->main_state));
+	h = fnv(h, &gs->transition, sizeof(gs->transition));
+	h = fnv(h, &g->rng, sizeof(g->rng));
+	return h;
+}
+
+/*---------------------------------------------------------------------------
+ * snapshots
+ *---------------------------------------------------------------------------*/
+#define SNAPSHOT_MAGIC		0x50414e53	/* SNAP */
+#define SNAPSHOT_VERSION	1
+
+/* what a struct game_snapshot holds, without pointers */
+struct snapshot {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t size;
+	struct game_state state;	/* with the pointers cleared */
+	uint8_t attacker;		/* enemy + 1, 0 for none */
+	uint8_t timer_fn[TIMER_MAX];	/* in timer_fns */
+	uint32_t rng;
+	unsigned long millis;		/* the clock of the game */
+	ArduboyVeritazz::FrameState frame;
+};
+
+static_assert(sizeof(struct snapshot) <= GAME_SNAPSHOT_SIZE,
+	      "GAME_SNAPSHOT_SIZE is too small");
+
+/* millis() of a game, whether selected in this thread or not */
+static unsigned long game_millis(struct game_context *g)
+{
+#ifdef HOST_HEADLESS
+	return g == game ? host_millis : g->millis;
+#else
+	return millis();
+#endif
+}
+
+void game_snapshot(struct game_context *g, struct game_snapshot *s)
+{
+	struct game_state *gs = &g->state;
+	struct game_data *gd = &gs->gd;
+	struct snapshot *snap = (struct snapshot *)s->data;
+	struct enemy *attacker;
+	timeout_fn fns[TIMER_MAX];
+	uint8_t i = 0;
+
+	memset(s, 0, sizeof(*s));
+	snap->magic = SNAPSHOT_MAGIC;
+	snap->version = SNAPSHOT_VERSION;
+	snap->size = sizeof(*snap);
+	attacker = gd->door.attacker;
+	if (attacker)
+		snap->attacker = attacker - gd->enemies + 1;
+	/* no pointers in the copy, the accessors only reach the game's own */
+	gd->door.attacker = NULL;
+	do {
+		fns[i] = gs->timers[i].fn;
+		snap->timer_fn[i] = timer_fn_index(fns[i]);
+		gs->timers[i].fn = NULL;
+	} while (++i < TIMER_MAX);
+	memcpy(&snap->state, gs, sizeof(snap->state));
+	gd->door.attacker = attacker;
+	for (i = 0; i < TIMER_MAX; i++)
+		gs->timers[i].fn = fns[i];
+	snap->rng = g->rng;
+	snap->millis = game_millis(g);
+	g->arduboy.saveFrameState(&snap->frame);
+}
+
+int game_restore(struct game_context *g, const struct game_snapshot *s)
+{
+	struct game_state *gs = &g->state;
+	struct game_data *gd = &gs->gd;
+	const struct snapshot *snap = (const struct snapshot *)s->data;
+	ArduboyVeritazz::FrameState frame = snap->frame;
+	long shift;
+	uint8_t i = 0;
+
+	if (snap->magic != SNAPSHOT_MAGIC ||
+	    snap->version != SNAPSHOT_VERSION ||
+	    snap->size != sizeof(*snap) ||
+	    snap->attacker > MAX_ENEMIES)
+		return -1;
+	do {
+		if (snap->timer_fn[i] >= NR_TIMER_FNS)
+			return -1;
+	} while (++i < TIMER_MAX);
+
+	memcpy(gs, &snap->state, sizeof(*gs));
+	if (snap->attacker)
+		gd->door.attacker = &gd->enemies[snap->attacker - 1];
+	i = 0;
+	do {
+		gs->timers[i].fn = timer_fns[snap->timer_fn[i]];
+	} while (++i < TIMER_MAX);
+	g->rng = snap->rng;
+#ifdef HOST_HEADLESS
+	/* a virtual clock is simply set back */
+	if (g == game)
+		host_millis = snap->millis;
+	else
+		g->millis = snap->millis;
+#endif
+	/* the frames keep their pace on any other clock */
+	shift = (long)(game_millis(g) - snap->millis);
+	frame.lastFrameStart += shift;
+	frame.nextFrameStart += shift;
+	g->arduboy.loadFrameState(&frame);
+	/* the screen is not part of it */
+	g->render_skipped = 1;
+	return 0;
 }
+
+struct game_context *game_fork(struct game_context *g)
+{
+	struct game_snapshot s;
+	struct game_context *f;
+
+	f = game_create(1);
+	if (!f)
+		return NULL;
+	game_snapshot(g, &s);
+	game_restore(f, &s);
+	/* with a copy of the screen, drawn or not */
+	memcpy(game_arduboy(f)->getBuffer(), game_arduboy(g)->getBuffer(),
+	       (HEIGHT * WIDTH) / 8);
+	f->user = g->user;
+	f->render_frame = g->render_frame;
+	f->render_skipped = g->render_skipped;
+	return f;
+}
+
+/*---------------------------------------------------------------------------
+ * lockstep
+ *---------------------------------------------------------------------------*/
+/*
+ * The games of a group keep the timers, player, weapons, enemies and
+ * power-ups of their play side by side, a vector lane for every game, so that
+ * bullets, hits and the timers of the games and their enemies step for all of
+ * them at once.  Whatever only some of the lanes do in a frame, like an enemy
+ * turning or a spawn, runs lane by lane through the functions of loop() on
+ * the game's context, which keeps the rest: the door, stage, texts, flying
+ * numbers and random numbers.  A game is only played in its lane while it is
+ * at play and not drawn, loop() plays it otherwise.
+ *
+ * GCC does the vectors wider than the machine's element by element, so the
+ * lanes are as many as a vector register holds 16 bit numbers of, and a group
+ * is played in blocks of that many.
+ */
+#if defined(__AVX512BW__)
+#define LANES			32
+#elif defined(__AVX2__)
+#define LANES			16
+#else
+#define LANES			8
+#endif
+
+static_assert(GAME_LOCKSTEP_LANES % LANES == 0, "a group is whole blocks");
+
+/* masks of lanes are vs8 of 0 and -1, like the comparisons give them */
+typedef int8_t vs8 __attribute__((vector_size(LANES)));
+typedef uint8_t vu8 __attribute__((vector_size(LANES)));
+typedef int16_t vs16 __attribute__((vector_size(LANES * 2)));
+typedef uint16_t vu16 __attribute__((vector_size(LANES * 2)));
+typedef int32_t vs32 __attribute__((vector_size(LANES * 4)));
+
+#define to_vs16(v)		__builtin_convertvector(v, vs16)
+#define to_vs8(v)		__builtin_convertvector(v, vs8)
+
+struct lanes_player {
+	vs16 life;
+	vu8 x;
+	vu8 atime;
+	vu8 frame;
+	vu8 state;
+	vu8 previous_state;
+	vu8 poison;
+	vu16 poison_timeout;
+	vs32 score;
+};
+
+struct lanes_enemy {
+	vs16 life;
+	vs8 x;
+	vu8 dx;
+	vu8 y;
+	vu8 type;
+	vu8 id;
+	vu8 pee_x;
+	vu8 atime;
+	vu8 rtime;
+	vu8 mtime;
+	vu8 damage;
+	vu8 frame;
+	vu8 active;
+	vu8 lane;
+	vu8 dlane;
+	vu8 poisoned;
+	vu8 poison_timeout;
+	vu8 frame_reload;
+	vu8 state;
+	vu8 pindex;
+	vu8 previous_state[2];
+	vu8 sprite_offset;
+	vu8 hit;
+	vu16 slowdown;
+	vu8 width;
+	vu8 height;
+	vu16 flags;
+};
+
+struct lanes_bullet {
+	vu8 x;
+	vu8 ys;
+	vu8 state;
+	vu8 weapon;
+	vu8 lane;
+	vu8 frame;
+	vu8 atime;
+	vu16 etime;
+};
+
+struct lanes_weapon_states {
+	vu16 cool_down[NR_WEAPONS];
+	vu8 selected;
+	vu8 previous;
+	vu8 direction;
+	vu8 effects_active;
+	vu8 stime;
+	vs8 icon_x;
+	vu8 ammo[NR_WEAPONS];
+	struct lanes_bullet bs[NR_BULLETS];
+};
+
+struct lanes_power_up {
+	vu8 active;
+	vu8 type;
+	struct {
+		vs16 x;
+		vs16 y;
+		vs16 xe;
+		vs16 ye;
+	} r;
+	vu8 lane;
+	vu8 frame;
+	vu8 atime;
+	vu16 timeout;
+};
+
+struct lanes {
+	vu8 timer_active[TIMER_MAX];
+	vu16 timer_timeout[TIMER_MAX];
+	struct lanes_player player;
+	struct lanes_enemy enemies[MAX_ENEMIES];
+	struct lanes_weapon_states ws;
+	struct lanes_power_up power_ups[MAX_POWERUPS];
+	vs8 in_lanes;			/* games played in their lane */
+	struct game_context *games[LANES];
+	uint8_t n;
+	struct game_lockstep_stats stats;
+};
+
+struct game_lockstep {
+	struct lanes blocks[GAME_LOCKSTEP_LANES / LANES];
+	uint8_t nr_blocks;
+};
+
+/* the fields moved between a game and its lane */
+#define PLAYER_FIELDS(X)						\
+	X(life) X(x) X(atime) X(frame) X(state) X(previous_state)	\
+	X(poison) X(poison_timeout) X(score)
+#define ENEMY_FIELDS(X)							\
+	X(life) X(x) X(dx) X(y) X(type) X(id) X(pee_x) X(atime)		\
+	X(rtime) X(mtime) X(damage) X(frame) X(active) X(lane)		\
+	X(dlane) X(poisoned) X(poison_timeout) X(frame_reload)		\
+	X(state) X(pindex) X(previous_state[0]) X(previous_state[1])	\
+	X(sprite_offset) X(hit) X(slowdown) X(width) X(height)		\
+	X(flags)
+#define BULLET_FIELDS(X)						\
+	X(x) X(ys) X(state) X(weapon) X(lane) X(frame) X(atime)		\
+	X(etime)
+#define WEAPON_FIELDS(X)						\
+	X(cool_down[0]) X(cool_down[1]) X(cool_down[2])			\
+	X(cool_down[3]) X(selected) X(previous) X(direction)		\
+	X(effects_active) X(stime) X(icon_x) X(ammo[0]) X(ammo[1])	\
+	X(ammo[2]) X(ammo[3])
+#define POWER_UP_FIELDS(X)						\
+	X(active) X(type) X(r.x) X(r.y) X(r.xe) X(r.ye) X(lane)		\
+	X(frame) X(atime) X(timeout)
+
+static_assert(NR_WEAPONS == 4, "WEAPON_FIELDS is out of date");
+
+#define LOAD(f)			to->f = from->f[l];
+#define STORE(f)		to->f[l] = from->f;
+
+static void load_player(struct player *to, const struct lanes_player *from,
+			uint8_t l)
+{
+	PLAYER_FIELDS(LOAD)
+}
+
+static void store_player(struct lanes_player *to, uint8_t l,
+			 const struct player *from)
+{
+	PLAYER_FIELDS(STORE)
+}
+
+static void load_enemy(struct enemy *to, const struct lanes_enemy *from,
+		       uint8_t l)
+{
+	ENEMY_FIELDS(LOAD)
+}
+
+static void store_enemy(struct lanes_enemy *to, uint8_t l,
+			const struct enemy *from)
+{
+	ENEMY_FIELDS(STORE)
+}
+
+static void load_power_up(struct power_up *to,
+			  const struct lanes_power_up *from, uint8_t l)
+{
+	POWER_UP_FIELDS(LOAD)
+}
+
+static void store_power_up(struct lanes_power_up *to, uint8_t l,
+			   const struct power_up *from)
+{
+	POWER_UP_FIELDS(STORE)
+}
+
+static void load_bullet(struct bullet *to, const struct lanes_bullet *from,
+			uint8_t l)
+{
+	BULLET_FIELDS(LOAD)
+}
+
+static void store_bullet(struct lanes_bullet *to, uint8_t l,
+			 const struct bullet *from)
+{
+	BULLET_FIELDS(STORE)
+}
+
+static void load_weapons(struct weapon_states *to,
+			 const struct lanes_weapon_states *from, uint8_t l)
+{
+	uint8_t b = 0;
+
+	WEAPON_FIELDS(LOAD)
+	do {
+		load_bullet(&to->bs[b], &from->bs[b], l);
+	} while (++b < NR_BULLETS);
+}
+
+static void store_weapons(struct lanes_weapon_states *to, uint8_t l,
+			  const struct weapon_states *from)
+{
+	uint8_t b = 0;
+
+	WEAPON_FIELDS(STORE)
+	do {
+		store_bullet(&to->bs[b], l, &from->bs[b]);
+	} while (++b < NR_BULLETS);
+}
+
+/* moves the play of game l into its lane */
+static void lanes_enter(struct lanes *ls, uint8_t l)
+{
+	struct game_state *gs = &ls->games[l]->state;
+	struct game_data *gd = &gs->gd;
+	uint8_t i = 0;
+
+	do {
+		ls->timer_active[i][l] = gs->timers[i].active;
+		ls->timer_timeout[i][l] = gs->timers[i].timeout;
+	} while (++i < TIMER_MAX);
+	store_player(&ls->player, l, &gd->player);
+	i = 0;
+	do {
+		store_enemy(&ls->enemies[i], l, &gd->enemies[i]);
+	} while (++i < MAX_ENEMIES);
+	store_weapons(&ls->ws, l, &gd->ws);
+	i = 0;
+	do {
+		store_power_up(&ls->power_ups[i], l, &gd->power_ups[i]);
+	} while (++i < MAX_POWERUPS);
+	ls->in_lanes[l] = -1;
+}
+
+/* writes the lane of game l back, it stays in the lane */
+static void lanes_write_back(struct lanes *ls, uint8_t l)
+{
+	struct game_state *gs = &ls->games[l]->state;
+	struct game_data *gd = &gs->gd;
+	uint8_t i = 0;
+
+	do {
+		gs->timers[i].active = ls->timer_active[i][l];
+		gs->timers[i].timeout = ls->timer_timeout[i][l];
+	} while (++i < TIMER_MAX);
+	load_player(&gd->player, &ls->player, l);
+	i = 0;
+	do {
+		load_enemy(&gd->enemies[i], &ls->enemies[i], l);
+	} while (++i < MAX_ENEMIES);
+	load_weapons(&gd->ws, &ls->ws, l);
+	i = 0;
+	do {
+		load_power_up(&gd->power_ups[i], &ls->power_ups[i], l);
+	} while (++i < MAX_POWERUPS);
+}
+
+static void lanes_leave(struct lanes *ls, uint8_t l)
+{
+	lanes_write_back(ls, l);
+	ls->in_lanes[l] = 0;
+}
+
+/* the timer functions of a game at play */
+static const timeout_fn play_timer_fns[TIMER_MAX] = {
+	[TIMER_PLAYER_RESTS] = player_is_resting,
+	[TIMER_ENEMY_SPAWN] = spawn_new_enemies,
+	[TIMER_POWERUP_SPAWN] = spawn_new_powerup,
+	[TIMER_POWERUP_SPAWN2] = spawn_new_powerup,
+	[TIMER_GP] = gp_timer_count_fn,
+};
+
+/* whether the next frames of g can be played in a lane */
+static uint8_t lanes_fit(struct game_context *g)
+{
+	struct game_data *gd = &g->state.gd;
+	uint8_t t = 0;
+
+	if (rendering(g) || g->state.main_state != PROGRAM_RUN_GAME ||
+	    gd->game_state != GAME_STATE_RUN_GAME || gd->pause)
+		return 0;
+	do {
+		if (g->state.timers[t].fn != play_timer_fns[t])
+			return 0;
+	} while (++t < TIMER_MAX);
+	return 1;
+}
+
+/*
+ * Masks, broadcasts and table lookups.  The vectors only pass between the
+ * static functions here, so their calling convention does not matter.
+ */
+static inline unsigned lanes_count(vs8 m)
+{
+	uint64_t w[LANES / 8];
+	unsigned n = 0;
+	uint8_t i = 0;
+
+	memcpy(w, &m, sizeof(w));
+	do {
+		n += __builtin_popcountll(w[i]);
+	} while (++i < LANES / 8);
+	return n / 8;
+}
+
+static inline uint8_t lanes_any(vs8 m)
+{
+	uint64_t w[LANES / 8], any = 0;
+	uint8_t i = 0;
+
+	memcpy(w, &m, sizeof(w));
+	do {
+		any |= w[i];
+	} while (++i < LANES / 8);
+	return any != 0;
+}
+
+static inline vu8 splat8(uint8_t c)
+{
+	vu8 v = {};
+
+	return v + c;
+}
+
+static inline vu16 splat16(uint16_t c)
+{
+	vu16 v = {};
+
+	return v + c;
+}
+
+/* table[index] in every lane, all indices are below n */
+static inline vu8 lookup8(const uint8_t *table, uint8_t n, vu8 index)
+{
+	vu8 v = {};
+	uint8_t i = 0;
+
+	do {
+		v = index == i ? splat8(table[i]) : v;
+	} while (++i < n);
+	return v;
+}
+
+static inline vu16 lookup16(const uint16_t *table, uint8_t n, vu8 index)
+{
+	vu16 v = {};
+	uint8_t i = 0;
+
+	do {
+		v = to_vs16(index == i) ? splat16(table[i]) : v;
+	} while (++i < n);
+	return v;
+}
+
+/*---------------------------------------------------------------------------
+ * lockstep timers
+ *---------------------------------------------------------------------------*/
+static void lanes_start_timer(struct lanes *ls, vs8 m, uint8_t id,
+			      uint16_t timeout)
+{
+	ls->timer_timeout[id] = to_vs16(m) ? splat16(timeout & 0x7fff) :
+		ls->timer_timeout[id];
+	ls->timer_active[id] = m ? splat8(1) : ls->timer_active[id];
+}
+
+static void lane_start_timer(struct lanes *ls, uint8_t l, uint8_t id,
+			     uint16_t timeout)
+{
+	ls->timer_timeout[id][l] = timeout & 0x7fff;
+	ls->timer_active[id][l] = 1;
+}
+
+static void lanes_player_set_state(struct lanes *ls, vs8 m,
+				   vu8 new_state)
+{
+	struct lanes_player *p = &ls->player;
+	vs8 changed = m & (new_state != p->state);
+
+	p->frame = changed ? splat8(0) : p->frame;
+	p->atime = changed ?
+		lookup8(player_timings, PLAYER_MAX_STATES, new_state) :
+		p->atime;
+	lanes_start_timer(ls, m & (new_state != splat8(PLAYER_RESTS)),
+			  TIMER_PLAYER_RESTS, PLAYER_REST_TIMEOUT);
+	p->previous_state = m ? p->state : p->previous_state;
+	p->state = m ? new_state : p->state;
+}
+
+/* spawn_new_enemies() of lane l, but for the timer */
+static void lane_spawn_enemy(struct lanes *ls, uint8_t l)
+{
+	struct game_context *g = ls->games[l];
+	struct enemy *e;
+	uint8_t i = 0;
+
+	do {
+		if (ls->enemies[i].active[l])
+			continue;
+		e = &g->state.gd.enemies[i];
+		spawn_enemy(g, e);
+		store_enemy(&ls->enemies[i], l, e);
+		break;
+	} while (++i < MAX_ENEMIES);
+}
+
+static void lane_spawn_powerup(struct lanes *ls, uint8_t l)
+{
+	struct game_context *g = ls->games[l];
+	struct power_up *pu;
+	uint8_t i = 0;
+
+	do {
+		if (ls->power_ups[i].active[l])
+			continue;
+		pu = &g->state.gd.power_ups[i];
+		spawn_powerup(g, pu);
+		store_power_up(&ls->power_ups[i], l, pu);
+		break;
+	} while (++i < MAX_POWERUPS);
+}
+
+/* the timer functions of play_timer_fns for the lanes in m */
+static void lanes_timeout(struct lanes *ls, vs8 m, uint8_t t)
+{
+	uint8_t l;
+
+	switch (t) {
+	case TIMER_PLAYER_RESTS:
+		lanes_player_set_state(ls, m, splat8(PLAYER_RESTS));
+		return;
+	case TIMER_GP:
+		for (l = 0; l < ls->n; l++)
+			if (m[l])
+				ls->games[l]->state.gp_timer_ticks++;
+		lanes_start_timer(ls, m, TIMER_GP, FPS / 2);
+		return;
+	case TIMER_ENEMY_SPAWN:
+		for (l = 0; l < ls->n; l++)
+			if (m[l])
+				lane_spawn_enemy(ls, l);
+		lanes_start_timer(ls, m, TIMER_ENEMY_SPAWN,
+				  ENEMIES_SPAWN_RATE);
+		return;
+	default:
+		for (l = 0; l < ls->n; l++)
+			if (m[l])
+				lane_spawn_powerup(ls, l);
+		return;
+	}
+}
+
+static void lanes_run_timers(struct lanes *ls, vs8 m)
+{
+	vs8 on, due;
+	uint8_t t = 0;
+
+	do {
+		on = m & (ls->timer_active[t] != 0);
+		due = on & to_vs8(ls->timer_timeout[t] == 0);
+		ls->timer_active[t] = due ? splat8(0) : ls->timer_active[t];
+		if (lanes_any(due))
+			lanes_timeout(ls, due, t);
+		ls->timer_timeout[t] = to_vs16(on) ?
+			(ls->timer_timeout[t] - 1) & 0x7fff :
+			ls->timer_timeout[t];
+	} while (++t < TIMER_MAX);
+}
+
+/*---------------------------------------------------------------------------
+ * lockstep bullets
+ *---------------------------------------------------------------------------*/
+static uint8_t lane_new_bullet(struct lanes *ls, uint8_t l,
+			       uint8_t lane, uint8_t weapon)
+{
+	struct lanes_weapon_states *ws = &ls->ws;
+	struct lanes_player *p = &ls->player;
+	struct lanes_bullet *bs;
+	uint8_t b, x = 0;
+
+	if (ws->ammo[weapon][l] == 0)
+		return 0;
+
+	if (ws->cool_down[weapon][l])
+		return 0;
+
+	ws->cool_down[weapon][l] = pgm_read_word(&weapon_cool_down[weapon]);
+
+	if (p->state[l] != PLAYER_RESTS)
+		b = p->state[l];
+	else
+		b = p->previous_state[l];
+
+	x = p->x[l];
+	if (b == PLAYER_R_MOVE) {
+		x += img_width(player_all_frames_img) - img_width(water_bomb_air_img);
+	}
+
+	b = 0;
+	do {
+		bs = &ws->bs[b];
+		if (bs->state[l] != BULLET_INACTIVE)
+			continue;
+
+		bs->state[l] = BULLET_ACTIVE;
+		bs->weapon[l] = weapon;
+		bs->x[l] = x;
+		bs->ys[l] = 5;
+		bs->lane[l] = lane;
+		bs->atime[l] = BULLET_FRAME_TIME;
+		bs->etime[l] = pgm_read_word(&etime[weapon]);
+		bs->frame[l] = 0;
+		ws->ammo[weapon][l]--;
+		break;
+	} while (++b < NR_BULLETS);
+	return 1;
+}
+
+static void lanes_update_bullets(struct lanes *ls, vs8 m)
+{
+	struct lanes_weapon_states *ws = &ls->ws;
+	struct lanes_bullet *bs;
+	vs8 live, waits, done, falls, lands, next;
+	uint8_t b = 0, w, l, height;
+	vu8 frame;
+
+	do {
+		ws->cool_down[b] = to_vs16(m) & (ws->cool_down[b] != 0) ?
+			ws->cool_down[b] - 1 : ws->cool_down[b];
+	} while (++b < NR_WEAPONS);
+
+	height = img_height(water_bomb_air_img);
+	b = 0;
+	do {
+		bs = &ws->bs[b];
+		live = m & (bs->state != splat8(BULLET_INACTIVE));
+		if (!lanes_any(live))
+			continue;
+
+		waits = live & ((bs->state == splat8(BULLET_EFFECT)) |
+				(bs->state == splat8(BULLET_SPLASH)));
+		done = waits & to_vs8(bs->etime == 0);
+		ws->effects_active -= (vu8)(done &
+					    (bs->state == splat8(BULLET_EFFECT))) & 1;
+		w = 0;
+		do {
+			ws->ammo[w] += (vu8)(done & (bs->weapon == w)) & 1;
+		} while (++w < NR_WEAPONS);
+		bs->state = done ? splat8(BULLET_INACTIVE) : bs->state;
+		bs->etime = to_vs16(waits & ~done) ? bs->etime - 1 : bs->etime;
+
+		/* next movement */
+		falls = live & ~waits;
+		lands = falls & (bs->ys == lookup8(lane_y, 3, bs->lane) - height);
+		bs->frame = lands ? splat8(0) : bs->frame;
+		bs->state = lands ? splat8(BULLET_EFFECT) : bs->state;
+		ws->effects_active += (vu8)lands & 1;
+		lands &= bs->weapon == splat8(WEAPON_MOLOTOV);
+		if (lanes_any(lands))
+			for (l = 0; l < ls->n; l++)
+				if (lands[l])
+					ls->games[l]->arduboy.shake(
+						MS_TO_FRAMES(400), 3);
+		bs->ys += (vu8)falls & 1;
+
+		/* next animation */
+		next = live & (bs->atime == 0);
+		frame = bs->frame + 1;
+		frame = bs->state == splat8(BULLET_EFFECT) ?
+			(frame == lookup8(weapon_effect_frame_reloads,
+					  NR_WEAPONS, bs->weapon) ?
+			 splat8(0) : frame) :
+			frame & 3;
+		bs->frame = next ? frame : bs->frame;
+		bs->atime = next ? splat8(BULLET_FRAME_TIME) :
+			live ? bs->atime - 1 : bs->atime;
+	} while (++b < NR_BULLETS);
+}
+
+/* get_bullet_damage() of the lanes in m for the rectangles in their lanes */
+static vu8 lanes_bullet_damage(struct lanes *ls, vs8 m, vu8 lane,
+			       vs16 x, vs16 y, vs16 xe, vs16 ye)
+{
+	struct lanes_bullet *bs;
+	vu8 damage = {}, rdx;
+	vs16 bx, by, x1, x2;
+	vs8 on, hit;
+	uint8_t b = 0;
+
+	lane = lookup8(lane_xlate, 3, lane);
+	do {
+		bs = &ls->ws.bs[b];
+		on = m & (bs->state >= splat8(BULLET_ACTIVE)) & (bs->lane == lane);
+		if (!lanes_any(on))
+			continue;
+		bx = to_vs16(bs->x);
+		by = to_vs16(bs->ys);
+
+		/* do_damage_from_table() */
+		hit = on & (bs->weapon < splat8(WEAPON_OIL)) &
+			to_vs8((bx < xe) & (bx + 4 > x) &
+			       (by < ye) & (by + 4 > y));
+		bs->etime = to_vs16(hit & (bs->state == splat8(BULLET_ACTIVE))) ?
+			splat16(FPS / 4) : bs->etime;
+		bs->state = hit ? splat8(BULLET_SPLASH) : bs->state;
+		damage += (vu8)hit &
+			lookup8(bullet_damage_table, NR_WEAPONS, bs->weapon);
+
+		/* do_damage_from_explosion() */
+		hit = on & (bs->weapon >= splat8(WEAPON_OIL)) &
+			(bs->state == splat8(BULLET_EFFECT)) &
+			to_vs8(bs->etime == lookup16(etime, NR_WEAPONS,
+						     bs->weapon));
+		if (!lanes_any(hit))
+			continue;
+		rdx = bs->weapon == splat8(WEAPON_OIL) ? splat8(8) : splat8(15);
+		x1 = to_vs16((vs8)(bs->x - rdx));
+		x2 = bx + to_vs16(rdx);
+		hit &= to_vs8(((x >= x1) & (x <= x2)) |
+			      ((xe >= x1) & (xe <= x2)));
+		damage += (vu8)hit &
+			lookup8(bullet_damage_table, NR_WEAPONS, bs->weapon);
+	} while (++b < NR_BULLETS);
+
+	return damage;
+}
+
+/* get_bullet_effect() of the lanes in m */
+static void lanes_bullet_effect(struct lanes *ls, vs8 m,
+				struct lanes_enemy *e)
+{
+	struct lanes_bullet *bs;
+	vu8 lane = lookup8(lane_xlate, 3, e->lane);
+	vs16 x = to_vs16(e->x), xw = x + to_vs16(e->width), x1, x2;
+	vs8 on;
+	uint8_t b = 0;
+
+	do {
+		bs = &ls->ws.bs[b];
+		on = m & (bs->weapon == splat8(WEAPON_OIL)) &
+			(bs->state == splat8(BULLET_EFFECT)) & (bs->lane == lane) &
+			to_vs8(e->slowdown == 0);
+		if (!lanes_any(on))
+			continue;
+
+		x1 = to_vs16((vs8)(bs->x - 6));
+		x2 = to_vs16(bs->x) + 6;
+		on &= to_vs8(((x >= x1) & (x <= x2)) |
+			     ((xw >= x1) & (xw <= x2)));
+		e->slowdown = to_vs16(on) ? splat16(FPS * 10) : e->slowdown;
+	} while (++b < NR_BULLETS);
+}
+
+/*---------------------------------------------------------------------------
+ * lockstep power-ups
+ *---------------------------------------------------------------------------*/
+static void lane_collect_powerup(struct lanes *ls, uint8_t l,
+				 uint8_t i)
+{
+	struct game_context *g = ls->games[l];
+	struct player *p = &g->state.gd.player;
+	struct power_up pu;
+
+	load_power_up(&pu, &ls->power_ups[i], l);
+	load_player(p, &ls->player, l);
+	collect_powerup(g, &pu);
+	store_player(&ls->player, l, p);
+}
+
+static void lanes_update_powerups(struct lanes *ls, vs8 m)
+{
+	struct lanes_power_up *pu;
+	vs8 on, gone, hit;
+	uint8_t i = 0, l;
+
+	do {
+		pu = &ls->power_ups[i];
+		on = m & (pu->active != 0);
+		if (!lanes_any(on))
+			continue;
+		pu->timeout = to_vs16(on) ? pu->timeout - 1 : pu->timeout;
+		gone = on & to_vs8(pu->timeout == 0);
+		on &= ~gone;
+
+		/* check if hit by player */
+		hit = on & (lanes_bullet_damage(ls, on, pu->lane, pu->r.x,
+						pu->r.y, pu->r.xe,
+						pu->r.ye) != 0);
+		if (lanes_any(gone | hit)) {
+			for (l = 0; l < ls->n; l++) {
+				if (!gone[l] && !hit[l])
+					continue;
+				pu->active[l] = 0;
+				lane_start_timer(ls, l, TIMER_POWERUP_SPAWN + i,
+						 (random8(ls->games[l], 8) + 4) *
+						 FPS);
+				if (hit[l])
+					lane_collect_powerup(ls, l, i);
+			}
+		}
+
+		pu->atime = on ? pu->atime - 1 : pu->atime;
+		on &= pu->atime == 0xff;
+		pu->atime = on ? splat8(MS_TO_FRAMES(150)) : pu->atime;
+		pu->frame = on ? (pu->frame + 1) & 0x3 : pu->frame;
+	} while (++i < MAX_POWERUPS);
+}
+
+/*---------------------------------------------------------------------------
+ * lockstep enemies
+ *---------------------------------------------------------------------------*/
+/* lends the player, enemy i and the attacker of lane l to its context */
+static struct enemy *lane_lend(struct lanes *ls, uint8_t l, uint8_t i)
+{
+	struct game_data *gd = &ls->games[l]->state.gd;
+	struct enemy *a = gd->door.attacker;
+
+	load_player(&gd->player, &ls->player, l);
+	if (a)
+		load_enemy(a, &ls->enemies[a - gd->enemies], l);
+	load_enemy(&gd->enemies[i], &ls->enemies[i], l);
+	return &gd->enemies[i];
+}
+
+/* and takes them back, a is the attacker when they were lent */
+static void lane_take_back(struct lanes *ls, uint8_t l, uint8_t i,
+			   struct enemy *a)
+{
+	struct game_data *gd = &ls->games[l]->state.gd;
+
+	store_player(&ls->player, l, &gd->player);
+	if (a)
+		store_enemy(&ls->enemies[a - gd->enemies], l, a);
+	store_enemy(&ls->enemies[i], l, &gd->enemies[i]);
+}
+
+/* enemy_hit() of the lanes in m */
+static void lanes_enemy_hit(struct lanes *ls, vs8 m, uint8_t i,
+			    vu8 damage)
+{
+	struct lanes_enemy *e = &ls->enemies[i];
+	struct game_context *g;
+	struct enemy *a;
+	vs16 life = e->life - to_vs16(damage);
+	vs8 alone;
+	uint8_t l;
+
+	/* deaths and the peaceful enemies which start to swear */
+	alone = m & (to_vs8(life <= 0) |
+		     ((e->type == splat8(ENEMY_PEACEFUL)) &
+		      (e->state != splat8(ENEMY_SPECIAL)) &
+		      (e->state != splat8(ENEMY_RESTING_SWEARING))));
+	m &= ~alone;
+	e->poisoned = m & (ls->player.poison != 0) ? splat8(4) : e->poisoned;
+	e->life = to_vs16(m) ? life : e->life;
+	e->hit = m & (e->type != splat8(ENEMY_PEACEFUL)) ? splat8(FPS) : e->hit;
+	if (!lanes_any(alone))
+		return;
+	for (l = 0; l < ls->n; l++) {
+		if (!alone[l])
+			continue;
+		g = ls->games[l];
+		a = g->state.gd.door.attacker;
+		enemy_hit(g, lane_lend(ls, l, i), damage[l]);
+		lane_take_back(ls, l, i, a);
+	}
+}
+
+/* enemy_act() of the lanes in m, whatever changes state goes lane by lane */
+static void lanes_enemy_act(struct lanes *ls, vs8 m, uint8_t i)
+{
+	struct lanes_enemy *e = &ls->enemies[i];
+	vs8 alone, moves, turns, counts, vicious, thief, peaceful, state;
+	vs16 x = to_vs16(e->x);
+	struct game_context *g;
+	struct enemy *a;
+	uint8_t l;
+
+	vicious = e->type == splat8(ENEMY_VICIOUS);
+	thief = e->type == splat8(ENEMY_THIEF);
+	peaceful = e->type == splat8(ENEMY_PEACEFUL);
+
+	/* walking left, until the door, a rest or a hack */
+	state = m & (e->state == splat8(ENEMY_WALKING_LEFT));
+	e->flags = to_vs16(state) ? e->flags & ~__flag_h_mirror : e->flags;
+	moves = state & (e->mtime == 0);
+	turns = ((vicious | (e->type == splat8(ENEMY_BOSS))) &
+		 to_vs8(x == 6 + to_vs16(lookup8(lane_y, 3, e->lane)) -
+			lane_y[DOOR_LANE])) |
+		(vicious & to_vs8(to_vs16(e->pee_x) == x)) |
+		(thief & to_vs8(to_vs16(e->dx) == x));
+	alone = moves & turns;
+	moves &= ~turns;
+	/* peaceful enemies just pass by */
+	e->active = moves & peaceful & to_vs8(x == -to_vs16(e->width)) ?
+		splat8(0) : e->active;
+	e->x = moves ? e->x - 1 : e->x;
+
+	/* walking right, lane by lane */
+	state = m & (e->state == splat8(ENEMY_WALKING_RIGHT));
+	e->flags = to_vs16(state) ? e->flags | __flag_h_mirror : e->flags;
+	alone |= state & (e->mtime == 0);
+
+	/* attacking, the door takes damage at the end of a swing */
+	state = m & (e->state == splat8(ENEMY_ATTACKING));
+	alone |= state & (e->atime == 0) &
+		to_vs8(to_vs16(e->frame) == to_vs16(e->frame_reload) - 1);
+
+	/* the rests and hacks count down */
+	state = m & (e->state == splat8(ENEMY_SPECIAL)) & (vicious | thief);
+	state |= m & (e->state == splat8(ENEMY_RESTING_SWEARING)) &
+		~(peaceful & to_vs8(to_vs16(e->frame) <
+				    to_vs16(e->frame_reload) - 1));
+	counts = state & (e->rtime != 0);
+	alone |= state & ~counts;
+	e->rtime = counts ? e->rtime - 1 : e->rtime;
+
+	alone |= m & (e->state == splat8(ENEMY_DYING)) & (e->hit == 0);
+	alone |= m & ((e->state == splat8(ENEMY_APPROACH_DOOR)) |
+		      (e->state == splat8(ENEMY_DEAD)));
+
+	if (!lanes_any(alone))
+		return;
+	ls->stats.diverged += lanes_count(alone);
+	for (l = 0; l < ls->n; l++) {
+		if (!alone[l])
+			continue;
+		g = ls->games[l];
+		a = g->state.gd.door.attacker;
+		enemy_act(g, lane_lend(ls, l, i));
+		lane_take_back(ls, l, i, a);
+	}
+}
+
+static void lanes_update_enemies(struct lanes *ls, vs8 m)
+{
+	struct lanes_enemy *e;
+	vs8 on, alive, poisoned, waits, gone;
+	vs16 x, y;
+	vu8 damage, mtime;
+	uint8_t i = 0, l;
+
+	do {
+		e = &ls->enemies[i];
+		on = m & (e->active != 0);
+		if (!lanes_any(on))
+			continue;
+		ls->stats.enemies += lanes_count(on);
+
+		/* check if hit by bullet */
+		x = to_vs16(e->x);
+		y = to_vs16(e->y);
+		alive = on & to_vs8(e->life > 0);
+		damage = lanes_bullet_damage(ls, alive, e->lane, x, y,
+					     x + to_vs16(e->width),
+					     y + to_vs16(e->height));
+		poisoned = alive & (e->poisoned != 0);
+		waits = poisoned & (e->poison_timeout != 0);
+		poisoned &= ~waits;
+		e->poison_timeout = waits ? e->poison_timeout - 1 :
+			poisoned ? splat8(2 * FPS) : e->poison_timeout;
+		damage += (vu8)poisoned & 2;
+		e->poisoned -= (vu8)poisoned & 1;
+		lanes_enemy_hit(ls, on & (damage != 0), i, damage);
+
+		if (lanes_any(on & (ls->ws.effects_active != 0)))
+			lanes_bullet_effect(ls, on &
+					    (ls->ws.effects_active != 0), e);
+
+		lanes_enemy_act(ls, on, i);
+
+		/* next animation */
+		e->atime = on ? e->atime - 1 : e->atime;
+		waits = on & (e->atime == 0xff);
+		e->atime = waits ?
+			lookup8((const uint8_t *)enemy_atime, ENEMY_MAX, e->id) :
+			e->atime;
+		e->frame = waits ? e->frame + 1 : e->frame;
+		e->frame = waits & (e->frame == e->frame_reload) ?
+			splat8(0) : e->frame;
+		/* next movement */
+		waits = on & (e->mtime == 0);
+		mtime = lookup8((const uint8_t *)enemy_mtime, ENEMY_MAX, e->id);
+		mtime = to_vs8(e->slowdown != 0) ? mtime * 8 : mtime;
+		mtime = e->state < splat8(ENEMY_DYING) ? mtime : splat8(0);
+		e->mtime = waits ? mtime : on ? e->mtime - 1 : e->mtime;
+		e->hit = on & (e->hit != 0) ? e->hit - 1 : e->hit;
+		gone = on & (e->active == 0) & (e->type != splat8(ENEMY_BOSS));
+		if (lanes_any(gone))
+			for (l = 0; l < ls->n; l++)
+				if (gone[l])
+					ls->games[l]->state.gd.ecount[e->type[l]]--;
+		e->slowdown = to_vs16(on) & (e->slowdown != 0) ?
+			e->slowdown - 1 : e->slowdown;
+	} while (++i < MAX_ENEMIES);
+}
+
+/*---------------------------------------------------------------------------
+ * lockstep play
+ *---------------------------------------------------------------------------*/
+static void lane_select_weapon(struct lanes *ls, uint8_t l,
+			       int8_t up_down)
+{
+	struct lanes_weapon_states *ws = &ls->ws;
+
+	ws->previous[l] = ws->selected[l];
+	if (ls->player.x[l] < 64 - img_width(player_all_frames_img) / 2) {
+		ws->direction[l] = 1;
+		ws->icon_x[l] = WIDTH;
+	} else {
+		ws->direction[l] = 0;
+		ws->icon_x[l] = -img_width(weapons_img);
+	}
+	if (up_down > 0) {
+		/* select weapon downwards */
+		ws->selected[l]++;
+	} else {
+		/* select weapon upwards */
+		ws->selected[l]--;
+	}
+	ws->selected[l] &= NR_WEAPONS - 1;
+}
+
+/* the checks and buttons of run(), 0 if the game ends or pauses instead */
+static uint8_t lane_input(struct lanes *ls, uint8_t l, vs8 *dx,
+			  vu8 *throws)
+{
+	struct game_context *g = ls->games[l];
+
+	if (ls->player.life[l] <= 0 || check_win_game(g))
+		return 0;
+	if (pressedUp(g) && pressedA(g))
+		return 0;
+
+	if (pressedUp(g)) {
+		lane_select_weapon(ls, l, -1);
+	} else if (pressedDown(g)) {
+		lane_select_weapon(ls, l, 1);
+	} else if (left(g)) {
+		(*dx)[l] = -1;
+	} else if (right(g)) {
+		(*dx)[l] = 1;
+	}
+	if (a(g))
+		(*throws)[l] = lane_new_bullet(ls, l, UPPER_LANE,
+					       ls->ws.selected[l]);
+	if (b(g))
+		(*throws)[l] = lane_new_bullet(ls, l, LOWER_LANE,
+					       ls->ws.selected[l]);
+	return 1;
+}
+
+static void lanes_update_scene(struct lanes *ls, vs8 m)
+{
+	struct lanes_weapon_states *ws = &ls->ws;
+	struct game_context *g;
+	vs8 shown, right, moves;
+	vs16 x = to_vs16(ws->icon_x);
+	uint8_t l;
+
+	/* show selected weapon icon */
+	shown = m & (ws->selected != ws->previous);
+	right = ws->direction != 0;
+	moves = shown & ~to_vs8(to_vs16(right) ?
+				x == (int16_t)(WIDTH - img_width(weapons_img)) :
+				x == 0);
+	ws->previous = shown & ~moves ? ws->selected : ws->previous;
+	ws->stime = moves ? splat8(FPS) : ws->stime;
+	ws->icon_x += moves & (right ? (vs8)splat8(-2) : (vs8)splat8(2));
+
+	for (l = 0; l < ls->n; l++) {
+		if (!m[l])
+			continue;
+		g = ls->games[l];
+		/* update lamp animation */
+		if (g->state.gp_timer_ticks & 1)
+			g->state.lamp_frame = random8(g, 2);
+		update_bumps(g);
+	}
+}
+
+static void lanes_update_player(struct lanes *ls, vs8 m, vs8 dx,
+				vu8 throws)
+{
+	struct lanes_player *p = &ls->player;
+	vs8 moves, resting;
+
+	/* update position */
+	moves = m & (dx < 0);
+	lanes_player_set_state(ls, moves, splat8(PLAYER_L_MOVE));
+	p->x = moves & (p->x > 0) ? p->x - 1 : p->x;
+	moves = m & (dx > 0);
+	lanes_player_set_state(ls, moves, splat8(PLAYER_R_MOVE));
+	p->x = moves & (p->x < 116) ? p->x + 1 : p->x;
+
+	moves = m & (throws != 0);
+	resting = moves & (p->state == splat8(PLAYER_RESTS));
+	lanes_player_set_state(ls, resting, p->previous_state);
+	lanes_start_timer(ls, moves & ~resting, TIMER_PLAYER_RESTS,
+			  PLAYER_REST_TIMEOUT);
+
+	/* update frames */
+	moves = m & (p->atime == 0);
+	p->atime = moves ?
+		lookup8(player_timings, PLAYER_MAX_STATES, p->state) :
+		m ? p->atime - 1 : p->atime;
+	p->frame = moves ? (p->frame + 1) & 3 : p->frame;
+
+	moves = m & (p->poison != 0);
+	p->poison_timeout = to_vs16(moves) ? p->poison_timeout - 1 :
+		p->poison_timeout;
+	p->poison = moves & to_vs8(p->poison_timeout == 0) ? splat8(0) :
+		p->poison;
+}
+
+/* the rest of a frame of the games in m, like loop() */
+static void lanes_frame(struct lanes *ls, vs8 m)
+{
+	struct game_context *g;
+	vu8 throws = {};
+	vs8 dx = {};
+	uint8_t l;
+
+	lanes_run_timers(ls, m);
+	for (l = 0; l < ls->n; l++) {
+		if (!m[l])
+			continue;
+		g = ls->games[l];
+		begin_frame(g);
+		if (lane_input(ls, l, &dx, &throws))
+			continue;
+		/* the game ends or pauses in loop()'s code */
+		lanes_leave(ls, l);
+		m[l] = 0;
+		game_select(g);
+		g->state.main_state = main_state_fn[g->state.main_state](g);
+		finish_frame(g);
+	}
+	if (!lanes_any(m))
+		return;
+
+	lanes_update_bullets(ls, m);
+	lanes_update_powerups(ls, m);
+	lanes_update_enemies(ls, m);
+	lanes_update_scene(ls, m);
+	lanes_update_player(ls, m, dx, throws);
+	for (l = 0; l < ls->n; l++) {
+		if (!m[l])
+			continue;
+		g = ls->games[l];
+		update_stage(g);
+		update_flying_numbers(g);
+	}
+	/* the weapon icon shows for stime frames, drawn or not */
+	ls->ws.stime = m & (ls->ws.stime != 0) ? ls->ws.stime - 1 :
+		ls->ws.stime;
+
+	for (l = 0; l < ls->n; l++) {
+		if (!m[l])
+			continue;
+		g = ls->games[l];
+		game_select(g);
+		finish_frame(g);
+	}
+}
+
+/* like a loop() of every game of the block */
+static void lanes_step(struct lanes *ls)
+{
+	struct game_context *g;
+	vs8 m = {};
+	uint8_t l;
+
+	for (l = 0; l < ls->n; l++) {
+		g = ls->games[l];
+		game_select(g);
+		/* frames drawn are loop()'s */
+		if (ls->in_lanes[l] && rendering(g))
+			lanes_leave(ls, l);
+		if (!ls->in_lanes[l]) {
+			ls->stats.alone++;
+			loop();
+			continue;
+		}
+		ls->stats.in_lanes++;
+		if (start_frame(g))
+			m[l] = -1;
+	}
+	if (lanes_any(m))
+		lanes_frame(ls, m);
+
+	/* the games which started to play move into their lanes */
+	for (l = 0; l < ls->n; l++)
+		if (!ls->in_lanes[l] && lanes_fit(ls->games[l]))
+			lanes_enter(ls, l);
+}
+
+struct game_lockstep *game_lockstep_create(struct game_context **g,
+					   unsigned n)
+{
+	struct game_lockstep *gl;
+	struct lanes *ls;
+	void *p;
+	uint8_t b, l;
+
+	if (!n || n > GAME_LOCKSTEP_LANES)
+		return NULL;
+	if (posix_memalign(&p, __alignof__(struct game_lockstep),
+			   sizeof(*gl)))
+		return NULL;
+	gl = (struct game_lockstep *)p;
+	memset(gl, 0, sizeof(*gl));
+	gl->nr_blocks = (n + LANES - 1) / LANES;
+	for (b = 0; b < gl->nr_blocks; b++) {
+		ls = &gl->blocks[b];
+		ls->n = n - b * LANES < LANES ? n - b * LANES : LANES;
+		memcpy(ls->games, &g[b * LANES], ls->n * sizeof(*g));
+		for (l = 0; l < ls->n; l++)
+			if (lanes_fit(ls->games[l]))
+				lanes_enter(ls, l);
+	}
+	return gl;
+}
+
+void game_lockstep_destroy(struct game_lockstep *gl)
+{
+	game_lockstep_sync(gl);
+	free(gl);
+}
+
+void game_lockstep_step(struct game_lockstep *gl)
+{
+	struct game_context *selected = game;
+	uint8_t b;
+
+	for (b = 0; b < gl->nr_blocks; b++)
+		lanes_step(&gl->blocks[b]);
+	game_select(selected);
+}
+
+void game_lockstep_sync(struct game_lockstep *gl)
+{
+	struct lanes *ls;
+	uint8_t b, l;
+
+	for (b = 0; b < gl->nr_blocks; b++) {
+		ls = &gl->blocks[b];
+		for (l = 0; l < ls->n; l++)
+			if (ls->in_lanes[l])
+				lanes_write_back(ls, l);
+	}
+}
+
+void game_lockstep_stats(const struct game_lockstep *gl,
+			 struct game_lockstep_stats *s)
+{
+	const struct game_lockstep_stats *bs;
+	uint8_t b;
+
+	memset(s, 0, sizeof(*s));
+	for (b = 0; b < gl->nr_blocks; b++) {
+		bs = &gl->blocks[b].stats;
+		s->in_lanes += bs->in_lanes;
+		s->alone += bs->alone;
+		s->enemies += bs->enemies;
+		s->diverged += bs->diverged;
+	}
+}
+#endif
@@ -0,0 +1,147 @@
+#ifndef Fatsche_h
+#define Fatsche_h
+
+#include "VeritazzExtra.h"
+
+void setup(void);
+void loop(void);
+
+#ifdef HOST_TEST
+/*
+ * The Arduboy runs a single game.  On the host every game lives in a
+ * context of its own, and setup() and loop() run the one selected in the
+ * calling thread, so a process can run as many as it likes.
+ */
+struct game_context;
+
+/* a new game with its own library instance and random numbers */
+struct game_context *game_create(uint32_t seed);
+void game_destroy(struct game_context *g);
+
+/* makes setup() and loop() in this thread run g */
+void game_select(struct game_context *g);
+struct game_context *game_selected(void);
+
+VeritazzExtra *game_arduboy(struct game_context *g);
+
+/* anything the harness wants to find from a game, e.g. in get_inputs() */
+void game_set_user(struct game_context *g, void *user);
+void *game_user(struct game_context *g);
+
+/* whether the next frames of the selected game are drawn */
+void set_render(uint8_t on);
+
+#define GAME_MAX_LIFE			256	/* of the door */
+#define GAME_STAGES			4
+#define GAME_ENEMIES			10	/* on the street at once */
+
+enum game_results {
+	GAME_RUNNING,
+	GAME_LOST,
+	GAME_WON,
+};
+
+/* what a game is at, for simulations to steer and judge it */
+struct game_status {
+	uint8_t playing;		/* a game, not the menus or the help */
+	uint8_t result;			/* enum game_results */
+	uint8_t stage;			/* cleared, GAME_STAGES once won */
+	uint8_t weapon;			/* selected */
+	uint8_t ammo;			/* left of it */
+	uint8_t cool_down;		/* frames until it throws again */
+	uint8_t x;			/* of the player */
+	uint8_t width;
+	int16_t life;			/* of the door */
+	int32_t score;
+	uint8_t nr_enemies;
+	struct {
+		int8_t x;
+		uint8_t width;
+		uint8_t lane;		/* 0 at the door, 1 upper, 2 lower */
+		uint8_t hostile;	/* not a passer-by */
+	} enemies[GAME_ENEMIES];
+};
+
+void game_status(struct game_context *g, struct game_status *s);
+
+/*
+ * The state of play as plain numbers for learning agents, unscaled:
+ *
+ *   0    player  x, life, score, stages cleared, kills left in the stage,
+ *                weapon, door under attack, boss (0 none, 1 - 3 phases),
+ *                ammo of the 4 weapons, their cool downs
+ *   16   10 enemies of 8: active, kind, x, y, lane, life, state, slowed
+ *   96   12 bullets of 6: state (0 none, 1 splash, 2 falling, 3 on the
+ *                ground), weapon, x, y, lane, frames left on the ground
+ *   168  2 power-ups of 5: active, kind, x, lane, frames left
+ */
+#define GAME_FEATURES			178
+
+void game_features(struct game_context *g, float *f);
+
+/*
+ * A hash of everything the game keeps, apart from the screen and what only
+ * matters for drawing it.  Two runs of the same seed and buttons give the
+ * same one every frame, in any process.
+ */
+uint64_t game_checksum(struct game_context *g);
+
+/*
+ * Everything a game needs to go on from a frame: its state, random numbers,
+ * clock and frame timing and the buttons of the last frame.  A snapshot has
+ * no pointers, so it can be kept anywhere, and a restored game plays on just
+ * like the one it was taken from, in any build of the same source.  The
+ * screen is not part of it, the next frame drawn after a restore is drawn
+ * whole.
+ */
+#define GAME_SNAPSHOT_SIZE		1024
+
+struct game_snapshot {
+	uint8_t data[GAME_SNAPSHOT_SIZE];
+};
+
+void game_snapshot(struct game_context *g, struct game_snapshot *s);
+
+/* returns -1 and leaves g alone if s is not a snapshot of this build */
+int game_restore(struct game_context *g, const struct game_snapshot *s);
+
+/* a new game to play on from where g is, with its screen and user */
+struct game_context *game_fork(struct game_context *g);
+
+/*
+ * Up to GAME_LOCKSTEP_LANES games stepped together, a frame of each at a
+ * time.  While a game is at play and not drawn, its play is kept side by
+ * side with that of the others and updated for all of them at once; it
+ * plays exactly like with loop(), only faster.  The functions above see
+ * the games of a group as of the last game_lockstep_sync(), and until the
+ * group is destroyed they must not be played or changed other than through
+ * it, apart from set_render().
+ */
+#define GAME_LOCKSTEP_LANES		32
+
+struct game_lockstep;
+
+struct game_lockstep_stats {
+	unsigned long in_lanes;		/* steps of a game in its lane */
+	unsigned long alone;		/* and by loop() */
+	unsigned long enemies;		/* enemy updates in lanes */
+	unsigned long diverged;		/* of them done lane by lane */
+};
+
+/* NULL unless 1 <= n <= GAME_LOCKSTEP_LANES */
+struct game_lockstep *game_lockstep_create(struct game_context **g,
+					   unsigned n);
+/* the games stay, to be played on alone */
+void game_lockstep_destroy(struct game_lockstep *ls);
+
+/* like a loop() of every game, each selected in turn */
+void game_lockstep_step(struct game_lockstep *ls);
+
+/* brings the games up to date for the functions above */
+void game_lockstep_sync(struct game_lockstep *ls);
+
+void game_lockstep_stats(const struct game_lockstep *ls,
+			 struct game_lockstep_stats *s);
+#endif
+
+#endif
@@ -179,21 +179,21 @@ void VeritazzExtra::unpackBytes(uint8_t *buf, uint16_t len)
 void VeritazzExtra::drawPackedImage(int16_t x, int16_t y, const uint8_t *img,
                                     uint8_t w, uint8_t h, uint16_t flags)
 {
-	// no need to dar at all of we're offscreen
-	if (x + w <= 0 || x > WIDTH - 1 || y + h <= 0 || y > HEIGHT - 1)
+	Surface *s = drawTarget();
+	uint8_t color;
+
+	// no need to dar at all of we're outside of the clip rectangle
+	if (x + w <= s->clipX || x >= s->clipX + s->clipW ||
+	    y + h <= s->clipY || y >= s->clipY + s->clipH)
 		return;
 
-	int yOffset = abs(y) % 8;
-	int sRow = y / 8;
-	int sCol = 0;
-	int eCol = w - (x + w > WIDTH ? (x + w) % WIDTH : 0);
-	uint8_t bCol;
-	if (y < 0) {
-		sRow--;
-		yOffset = 8 - yOffset;
-	}
-	if (x < 0)
-		sCol = abs(x);
+	if (flags & __flag_white)
+		color = WHITE;
+	else if (flags & __flag_black)
+		color = BLACK;
+	else
+		color = INVERT;
+
 	uint8_t buf[w];
 
 	if (flags & __flag_unpack)
@@ -202,7 +202,7 @@ void VeritazzExtra::drawPackedImage(int16_t x, int16_t y, const uint8_t *img,
 	int rows = h / 8;
 	if (h % 8 != 0) rows++;
 	for (int a = 0; a < rows; a++) {
-		int bRow = sRow + a;
+		int16_t ry = y + a * 8;
 		if (flags & __flag_unpack)
 			unpackBytes(buf, w);
 		else {
@@ -213,61 +213,78 @@ void VeritazzExtra::drawPackedImage(int16_t x, int16_t y, const uint8_t *img,
 #endif
 			img += w;
 		}
-		if (bRow > (HEIGHT / 8) - 1) break;
-		if (bRow >= 0) {
-			for (int iCol = sCol; iCol < eCol; iCol++) {
-				if (iCol + x > (WIDTH - 1)) break;
-				if (flags & __flag_h_mirror)
-					bCol = w - iCol - 1;
-				else
-					bCol = iCol;
-				if      (flags & __flag_white) this->sBuffer[ (bRow * WIDTH) + x + iCol ] |= buf[bCol] << yOffset;
-				else if (flags & __flag_black) this->sBuffer[ (bRow * WIDTH) + x + iCol ] &= ~(buf[bCol] << yOffset);
-				else                     this->sBuffer[ (bRow * WIDTH) + x + iCol ] ^= buf[bCol] << yOffset;
-			}
-		}
-
-		if (yOffset && bRow < (HEIGHT / 8) - 1 && bRow > -2) {
-			for (int iCol = sCol; iCol < eCol; iCol++) {
-				if (iCol + x > (WIDTH - 1)) break;
-				if (flags & __flag_h_mirror)
-					bCol = w - iCol - 1;
-				else
-					bCol = iCol;
-				if      (flags & __flag_white) this->sBuffer[ ((bRow + 1)*WIDTH) + x + iCol ] |= buf[bCol] >> (8 - yOffset);
-				else if (flags & __flag_black) this->sBuffer[ ((bRow + 1)*WIDTH) + x + iCol ] &= ~(buf[bCol] >> (8 - yOffset));
-				else                     this->sBuffer[ ((bRow + 1)*WIDTH) + x + iCol ] ^= buf[bCol] >> (8 - yOffset);
-			}
-		}
+		if (ry >= s->clipY + s->clipH) break;
+		drawColumns(s, x, ry, buf, w, color, 0, flags & __flag_h_mirror);
 	}
 }
 
+void VeritazzExtra::drawFrame(int16_t x, int16_t y, const uint8_t *img,
+			      uint8_t nr, uint16_t flags)
+{
+	uint16_t offset;
+
+	offset = img_offset(img, nr);
+	if (offset & 0x8000)
+		flags |= __flag_unpack;
+	offset &= 0x7fff;
+	drawPackedImage(x, y, img + offset, img_width(img), img_height(img),
+			flags);
+}
+
 void VeritazzExtra::drawImageFrame(int16_t x, int16_t y, const uint8_t *img,
                                    const uint8_t *mask, uint8_t nr,
                                    uint16_t flags)
 {
-	uint16_t ioffset;
-	uint8_t w, h;
-	uint16_t iflags = flags, mflags = flags;
-
-	w = img_width(img);
-	h = img_height(img);
-	ioffset = img_offset(img, nr);
-	if (ioffset & 0x8000)
-		iflags |= __flag_unpack;
-	ioffset &= 0x7fff;
+	uint8_t inr = nr, mnr = nr;
+	uint16_t mflags = (flags & (~__color_mask)) | __flag_black;
 
-	if (mask) {
-		uint16_t moffset;
-		if (flags & __flag_mask_single)
-			nr = 0;
-		moffset = img_offset(mask, nr);
-		if (moffset & 0x8000)
-			mflags |= __flag_unpack;
-		moffset &= 0x7fff;
-		drawPackedImage(x, y, mask + moffset, w, h,
-				(mflags & (~__color_mask)) | __flag_black);
+#ifdef ARDUBOY_STRIP_RENDERING
+	if (deferred()) {
+		DrawCommand *c = record(DRAW_OP_IMAGE, x, y);
+		if (c) {
+			c->image.img = img;
+			c->image.mask = mask;
+			c->image.nr = nr;
+			c->image.flags = flags;
+		}
+		return;
 	}
+#endif
+
+	/* gray images hold the screen and the shade frame of every frame */
+	if (flags & __flag_gray)
+		inr = nr * 2;
+	if (flags & __flag_mask_single)
+		mnr = 0;
+
+	if (mask)
+		drawFrame(x, y, mask, mnr, mflags);
+	drawFrame(x, y, img, inr, flags);
+
+#ifdef ARDUBOY_GRAYSCALE
+	if (target != &screen)
+		return;
+	/* whatever the mask covers loses its shade */
+	target = &shade;
+	if (mask)
+		drawFrame(x, y, mask, mnr, mflags);
+	if (flags & __flag_gray)
+		drawFrame(x, y, img, inr + 1,
+			  (flags & (~__color_mask)) | __flag_white);
+	else if (flags & __flag_shade)
+		drawFrame(x, y, img, inr, flags);
+	target = &screen;
+#endif
+}
 
-	drawPackedImage(x, y, img + ioffset, w, h, iflags);
+#ifdef ARDUBOY_STRIP_RENDERING
+void VeritazzExtra::replay(const DrawCommand *c, int16_t dy)
+{
+	if (c->op != DRAW_OP_IMAGE) {
+		ArduboyVeritazz::replay(c, dy);
+		return;
+	}
+	drawImageFrame(c->x, c->y - dy, c->image.img, c->image.mask,
+		       c->image.nr, c->image.flags);
 }
+#endif
@@ -3,10 +3,6 @@
 
 #include "ArduboyVeritazz.h"
 
-#ifdef HOST_TEST
-extern uint8_t get_inputs(void);
-#endif
-
 #define __flag_none                  (0)
 #define __flag_color_invert          (1 << 0)
 #define __flag_h_mirror              (1 << 1)
@@ -15,6 +11,9 @@ extern uint8_t get_inputs(void);
 #define __flag_white                 (1 << 4)
 #define __flag_unpack                (1 << 7)
 #define __flag_mask_single           (1 << 8)
+/* two frames per frame for the grayscale screen, see ARDUBOY_GRAYSCALE */
+#define __flag_gray                  (1 << 9)
+#define __flag_shade                 (1 << 10)	/* light gray */
 
 #define __color_mask                 (3 << 3)
 
@@ -37,7 +36,14 @@ public:
 				   const uint8_t *mask, uint8_t nr,
 				   uint16_t flags);
 
+protected:
+#ifdef ARDUBOY_STRIP_RENDERING
+	virtual void replay(const DrawCommand *c, int16_t dy);
+#endif
+
 private:
+	void drawFrame(int16_t x, int16_t y, const uint8_t *img, uint8_t nr,
+		       uint16_t flags);
 	void drawPackedImage(int16_t x, int16_t y, const uint8_t *img, uint8_t w, uint8_t h,
 				uint16_t flags);
 
@@ -0,0 +1,623 @@
+/*
+ * Plays many games on all cores, for balancing and soak tests.
+ *
+ * Built like headless, every game runs on its virtual clock without being
+ * drawn.  Game n gets the seed first + n.  The games are split evenly over
+ * the threads, which take them one at a time and steal half of what is
+ * left from another thread once theirs are done.  A policy presses the
+ * buttons: through the menu into a game, then until it is lost, won or
+ * runs out of frames.  The results go into histograms shared by all
+ * threads without locks, a summary is printed at the end and optionally
+ * written as JSON, every game as a line of CSV.
+ *
+ *   batch [-g games] [-j threads] [-p policy] [-i script] [-n frames]
+ *         [-s first seed] [-c csv] [-o json]
+ *
+ * policies:
+ *   idle     presses nothing, the door just takes it
+ *   random   holds random buttons for a while
+ *   spam     walks back and forth throwing at both lanes
+ *   hunt     walks to the nearest hostile enemy and throws at its lane
+ *   script   plays the script of -i, frames count from the start of a game
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "Fatsche.h"
+#include "script.h"
+
+#define FPS			30
+
+/* give up on the menu after this */
+#define MENU_FRAMES		(FPS * 10)
+
+/* read by the library once per frame of the thread's game */
+static __thread uint8_t buttons;
+
+uint8_t
+get_inputs(void)
+{
+	return buttons;
+}
+
+/*---------------------------------------------------------------------------
+ * policies
+ *---------------------------------------------------------------------------*/
+struct bot {
+	uint32_t rng;
+	unsigned long frame;		/* of the game, 0 at its start */
+	uint8_t held;
+	unsigned hold;			/* frames to keep held */
+	int8_t dir;
+	unsigned long cursor;		/* in the script */
+};
+
+static struct script script;
+
+static uint32_t
+bot_random(struct bot *b)
+{
+	b->rng ^= b->rng << 13;
+	b->rng ^= b->rng >> 17;
+	b->rng ^= b->rng << 5;
+	return b->rng;
+}
+
+static uint8_t
+idle_buttons(struct bot *b, const struct game_status *s)
+{
+	return 0;
+}
+
+static uint8_t
+random_buttons(struct bot *b, const struct game_status *s)
+{
+	static const uint8_t moves[] = {
+		0, LEFT_BUTTON, RIGHT_BUTTON, UP_BUTTON, DOWN_BUTTON,
+	};
+	static const uint8_t throws[] = {
+		0, A_BUTTON, B_BUTTON, A_BUTTON | B_BUTTON,
+	};
+
+	if (b->hold) {
+		b->hold--;
+		return b->held;
+	}
+	b->held = moves[bot_random(b) % 5] | throws[bot_random(b) % 4];
+	/* up and a pause the game, weapons change once */
+	if (b->held & (UP_BUTTON | DOWN_BUTTON)) {
+		b->held &= ~A_BUTTON;
+		b->hold = 1;
+	} else {
+		b->hold = 5 + bot_random(b) % 25;
+	}
+	return b->held;
+}
+
+static uint8_t
+spam_buttons(struct bot *b, const struct game_status *s)
+{
+	uint8_t pressed = 0;
+
+	if (s->x <= 8)
+		b->dir = 1;
+	else if (s->x >= 112)
+		b->dir = -1;
+	pressed = b->dir < 0 ? LEFT_BUTTON : RIGHT_BUTTON;
+	/* a throw needs a press, so every other frame */
+	if (b->frame & 1)
+		pressed |= b->frame & 2 ? A_BUTTON : B_BUTTON;
+	else if (!s->ammo && !(b->frame & 62))
+		pressed = DOWN_BUTTON;
+	return pressed;
+}
+
+static uint8_t
+hunt_buttons(struct bot *b, const struct game_status *s)
+{
+	int center = s->x + s->width / 2, target = -1, best = 256, d, i;
+	uint8_t pressed = 0, lane = 0;
+
+	for (i = 0; i < s->nr_enemies; i++) {
+		if (!s->enemies[i].hostile)
+			continue;
+		d = s->enemies[i].x + s->enemies[i].width / 2;
+		/* the door is on the left, closest to it first */
+		if (d < best) {
+			best = d;
+			target = i;
+		}
+	}
+	if (target < 0)
+		return spam_buttons(b, s) & ~(A_BUTTON | B_BUTTON);
+	lane = s->enemies[target].lane;
+	if (best < center - 2)
+		pressed = LEFT_BUTTON;
+	else if (best > center + 2)
+		pressed = RIGHT_BUTTON;
+	if (!s->ammo) {
+		/* every frame would skip the next weapon too */
+		if (!(b->frame & 7))
+			pressed = DOWN_BUTTON;
+	} else if (!s->cool_down && (b->frame & 1)) {
+		pressed |= lane == 2 ? B_BUTTON : A_BUTTON;
+	}
+	return pressed;
+}
+
+static uint8_t
+script_policy_buttons(struct bot *b, const struct game_status *s)
+{
+	b->held = script_buttons(&script, &b->cursor, b->frame, b->held);
+	return b->held;
+}
+
+struct policy {
+	const char *name;
+	uint8_t (*buttons)(struct bot *b, const struct game_status *s);
+};
+
+static const struct policy policies[] = {
+	{ "idle", idle_buttons, },
+	{ "random", random_buttons, },
+	{ "spam", spam_buttons, },
+	{ "hunt", hunt_buttons, },
+	{ "script", script_policy_buttons, },
+};
+
+#define NR_POLICIES		(sizeof(policies) / sizeof(policies[0]))
+
+/*---------------------------------------------------------------------------
+ * results
+ *---------------------------------------------------------------------------*/
+struct result {
+	uint32_t seed;
+	uint8_t result;			/* enum game_results */
+	uint8_t stage;
+	int32_t score;
+	uint32_t frames;		/* played, the menu does not count */
+	uint32_t door_damage;		/* life lost, whatever was healed */
+};
+
+#define HIST_BINS		32
+
+/* counts of values in bins of width, the last one takes the rest */
+struct hist {
+	const char *name;
+	long width;
+	long min;			/* of the first bin */
+	unsigned long bins[HIST_BINS];
+	long long sum;
+	long lo, hi;
+};
+
+enum hists {
+	HIST_SCORE,
+	HIST_STAGE,
+	HIST_FRAMES,
+	HIST_DAMAGE,
+	NR_HISTS,
+};
+
+static struct hist hists[NR_HISTS] = {
+	[HIST_SCORE] = { "score", 100, -200, },
+	[HIST_STAGE] = { "stage", 1, 0, },
+	[HIST_FRAMES] = { "frames", FPS * 60, 0, },
+	[HIST_DAMAGE] = { "door_damage", 32, 0, },
+};
+
+static unsigned long outcomes[3];
+
+static void
+hist_init(struct hist *h)
+{
+	h->lo = __LONG_MAX__;
+	h->hi = -__LONG_MAX__ - 1;
+}
+
+static void
+hist_add(struct hist *h, long v)
+{
+	long bin = (v - h->min) / h->width, old;
+
+	if (v < h->min)
+		bin = 0;
+	else if (bin >= HIST_BINS)
+		bin = HIST_BINS - 1;
+	__atomic_fetch_add(&h->bins[bin], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&h->sum, v, __ATOMIC_RELAXED);
+	old = __atomic_load_n(&h->lo, __ATOMIC_RELAXED);
+	while (v < old && !__atomic_compare_exchange_n(&h->lo, &old, v, 1,
+			__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+	old = __atomic_load_n(&h->hi, __ATOMIC_RELAXED);
+	while (v > old && !__atomic_compare_exchange_n(&h->hi, &old, v, 1,
+			__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+}
+
+/*---------------------------------------------------------------------------
+ * playing
+ *---------------------------------------------------------------------------*/
+static const struct policy *policy;
+static unsigned long max_frames = FPS * 60 * 20;
+
+/* counts a frame, the library does not finish one for every loop() */
+static int
+step(VeritazzExtra *arduboy)
+{
+	loop();
+	return arduboy->post_render;
+}
+
+static void
+play(uint32_t seed, struct result *r, unsigned long *looped)
+{
+	struct game_context *g = game_create(seed);
+	VeritazzExtra *arduboy;
+	struct game_status s;
+	struct bot b;
+	unsigned long menu = 0;
+	int16_t life = GAME_MAX_LIFE;
+
+	memset(r, 0, sizeof(*r));
+	r->seed = seed;
+	if (!g) {
+		fprintf(stderr, "batch: out of memory\n");
+		exit(1);
+	}
+	arduboy = game_arduboy(g);
+	game_select(g);
+	set_render(0);
+	/* up held from the last game would make begin() wait for down */
+	buttons = 0;
+	setup();
+
+	/* a press in the menu starts the game */
+	do {
+		buttons = menu & 1 ? A_BUTTON : 0;
+		menu += step(arduboy);
+		game_status(g, &s);
+	} while (!s.playing && menu < MENU_FRAMES);
+
+	memset(&b, 0, sizeof(b));
+	b.rng = seed ? seed : 1;
+	buttons = 0;
+	while (s.playing && s.result == GAME_RUNNING &&
+	       b.frame < max_frames) {
+		if (!step(arduboy))
+			continue;
+		b.frame++;
+		game_status(g, &s);
+		if (s.life < life)
+			r->door_damage += life - s.life;
+		life = s.life;
+		buttons = policy->buttons(&b, &s);
+	}
+	r->result = s.result;
+	r->stage = s.stage;
+	r->score = s.score;
+	r->frames = b.frame;
+	*looped += menu + b.frame;
+	game_destroy(g);
+}
+
+/*---------------------------------------------------------------------------
+ * work stealing
+ *---------------------------------------------------------------------------*/
+/* the games a thread has left, next in the low and end in the high half */
+#define RANGE(next, end)	((uint64_t)(end) << 32 | (uint32_t)(next))
+#define RANGE_NEXT(r)		((uint32_t)(r))
+#define RANGE_END(r)		((uint32_t)((r) >> 32))
+
+struct worker {
+	uint64_t range;
+	pthread_t thread;
+	unsigned id;
+	unsigned long games;
+	unsigned long stolen;
+	unsigned long frames;
+	double cpu;			/* seconds */
+} __attribute__((aligned(64)));
+
+static struct worker *workers;
+static unsigned nr_workers;
+static uint32_t first_seed = 1;
+static struct result *results;
+
+/* the next game of w, -1 if it has none */
+static long
+take(struct worker *w)
+{
+	uint64_t r = __atomic_load_n(&w->range, __ATOMIC_ACQUIRE);
+
+	while (RANGE_NEXT(r) < RANGE_END(r)) {
+		if (__atomic_compare_exchange_n(&w->range, &r,
+				RANGE(RANGE_NEXT(r) + 1, RANGE_END(r)), 0,
+				__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			return RANGE_NEXT(r);
+	}
+	return -1;
+}
+
+/* moves the upper half of a victim's games to w, returns the first one */
+static long
+steal(struct worker *w)
+{
+	struct worker *v;
+	uint64_t r;
+	uint32_t half;
+	unsigned i;
+
+	for (i = 1; i < nr_workers; i++) {
+		v = &workers[(w->id + i) % nr_workers];
+		r = __atomic_load_n(&v->range, __ATOMIC_ACQUIRE);
+		while (RANGE_NEXT(r) < RANGE_END(r)) {
+			half = (RANGE_END(r) - RANGE_NEXT(r) + 1) / 2;
+			if (!__atomic_compare_exchange_n(&v->range, &r,
+					RANGE(RANGE_NEXT(r), RANGE_END(r) - half),
+					0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+				continue;
+			/* w's range is empty, nobody else changes it */
+			__atomic_store_n(&w->range,
+					 RANGE(RANGE_END(r) - half + 1,
+					       RANGE_END(r)), __ATOMIC_RELEASE);
+			w->stolen += half;
+			return RANGE_END(r) - half;
+		}
+	}
+	return -1;
+}
+
+static void *
+work(void *arg)
+{
+	struct worker *w = (struct worker *)arg;
+	struct result r;
+	struct timespec ts;
+	long n;
+
+	while ((n = take(w)) >= 0 || (n = steal(w)) >= 0) {
+		play(first_seed + n, &r, &w->frames);
+		w->games++;
+		__atomic_fetch_add(&outcomes[r.result], 1, __ATOMIC_RELAXED);
+		hist_add(&hists[HIST_SCORE], r.score);
+		hist_add(&hists[HIST_STAGE], r.stage);
+		hist_add(&hists[HIST_FRAMES], r.frames);
+		hist_add(&hists[HIST_DAMAGE], r.door_damage);
+		if (results)
+			results[n] = r;
+	}
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	w->cpu = ts.tv_sec + ts.tv_nsec * 1e-9;
+	return NULL;
+}
+
+/*---------------------------------------------------------------------------
+ * output
+ *---------------------------------------------------------------------------*/
+static const char *result_names[] = { "running", "lost", "won", };
+
+static int
+write_csv(const char *path, unsigned long games)
+{
+	FILE *f = strcmp(path, "-") ? fopen(path, "w") : stdout;
+	unsigned long i;
+	struct result *r;
+
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+	fprintf(f, "game,seed,result,stage,score,frames,door_damage\n");
+	for (i = 0; i < games; i++) {
+		r = &results[i];
+		fprintf(f, "%lu,%u,%s,%u,%d,%u,%u\n", i, r->seed,
+			result_names[r->result], r->stage, r->score, r->frames,
+			r->door_damage);
+	}
+	if (f != stdout ? fclose(f) : fflush(f)) {
+		perror(path);
+		return -1;
+	}
+	return 0;
+}
+
+static int
+write_json(const char *path, unsigned long games, double secs, double cpu,
+	   unsigned long frames)
+{
+	FILE *f = strcmp(path, "-") ? fopen(path, "w") : stdout;
+	struct hist *h;
+	int i, j, last;
+
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+	fprintf(f, "{\n  \"policy\": \"%s\",\n  \"games\": %lu,\n"
+		"  \"first_seed\": %u,\n  \"max_frames\": %lu,\n"
+		"  \"threads\": %u,\n  \"seconds\": %.3f,\n"
+		"  \"cpu_seconds\": %.3f,\n  \"games_per_second\": %.1f,\n"
+		"  \"games_per_cpu_second\": %.1f,\n"
+		"  \"frames_per_second\": %.0f,\n",
+		policy->name, games, first_seed, max_frames, nr_workers, secs,
+		cpu, secs > 0 ? games / secs : 0, cpu > 0 ? games / cpu : 0,
+		secs > 0 ? frames / secs : 0);
+	fprintf(f, "  \"results\": { \"running\": %lu, \"lost\": %lu, "
+		"\"won\": %lu },\n", outcomes[GAME_RUNNING],
+		outcomes[GAME_LOST], outcomes[GAME_WON]);
+	for (i = 0; i < NR_HISTS; i++) {
+		h = &hists[i];
+		for (last = HIST_BINS - 1; last > 0 && !h->bins[last]; last--)
+			;
+		fprintf(f, "  \"%s\": { \"min\": %ld, \"max\": %ld, "
+			"\"mean\": %.2f,\n    \"bin_min\": %ld, "
+			"\"bin_width\": %ld, \"bins\": [", h->name,
+			games ? h->lo : 0, games ? h->hi : 0,
+			games ? (double)h->sum / games : 0, h->min, h->width);
+		for (j = 0; j <= last; j++)
+			fprintf(f, "%s%lu", j ? ", " : "", h->bins[j]);
+		fprintf(f, "] }%s\n", i + 1 < NR_HISTS ? "," : "");
+	}
+	fprintf(f, "}\n");
+	if (f != stdout ? fclose(f) : fflush(f)) {
+		perror(path);
+		return -1;
+	}
+	return 0;
+}
+
+static void
+print_hist(const struct hist *h, unsigned long games)
+{
+	unsigned long most = 0;
+	int i, last;
+
+	fprintf(stderr, "%s: min %ld, max %ld, mean %.1f\n", h->name,
+		games ? h->lo : 0, games ? h->hi : 0,
+		games ? (double)h->sum / games : 0);
+	for (last = HIST_BINS - 1; last > 0 && !h->bins[last]; last--)
+		;
+	for (i = 0; i <= last; i++)
+		if (h->bins[i] > most)
+			most = h->bins[i];
+	for (i = 0; i <= last; i++)
+		fprintf(stderr, "  %8ld%s %8lu %.*s\n", h->min + i * h->width,
+			i == HIST_BINS - 1 ? "+" : " ", h->bins[i],
+			(int)(most ? h->bins[i] * 50 / most : 0),
+			"##################################################");
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *csv_path = NULL, *json_path = NULL, *script_path = NULL;
+	const char *policy_name = "hunt";
+	unsigned long games = 1000, frames = 0, stolen = 0, i;
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	double start, secs, cpu = 0;
+	int opt;
+
+	nr_workers = cpus > 0 ? cpus : 1;
+	while ((opt = getopt(argc, argv, "c:g:i:j:n:o:p:s:")) != -1) {
+		switch (opt) {
+		case 'c':
+			csv_path = optarg;
+			break;
+		case 'g':
+			games = strtoul(optarg, NULL, 0);
+			break;
+		case 'i':
+			script_path = optarg;
+			break;
+		case 'j':
+			nr_workers = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			max_frames = strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			json_path = optarg;
+			break;
+		case 'p':
+			policy_name = optarg;
+			break;
+		case 's':
+			first_seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-g games] [-j threads] "
+				"[-p idle|random|spam|hunt|script] [-i script] "
+				"[-n frames] [-s first seed] [-c csv] "
+				"[-o json]\n", argv[0]);
+			return 1;
+		}
+	}
+	for (i = 0; i < NR_POLICIES; i++)
+		if (!strcmp(policies[i].name, policy_name))
+			policy = &policies[i];
+	if (!policy) {
+		fprintf(stderr, "policies: idle random spam hunt script\n");
+		return 1;
+	}
+	if (policy->buttons == script_policy_buttons && !script_path) {
+		fprintf(stderr, "the script policy needs -i\n");
+		return 1;
+	}
+	if (script_path && script_load(&script, script_path) < 0)
+		return 1;
+	if (!nr_workers || games > 0xffffffffUL) {
+		fprintf(stderr, "need a thread and at most 2^32 - 1 games\n");
+		return 1;
+	}
+	if (nr_workers > games)
+		nr_workers = games ? games : 1;
+	if (csv_path) {
+		results = (struct result *)calloc(games, sizeof(*results));
+		if (!results) {
+			fprintf(stderr, "no memory for %lu results\n", games);
+			return 1;
+		}
+	}
+	/* a cache line each, they are written all the time */
+	if (posix_memalign((void **)&workers, 64,
+			   nr_workers * sizeof(*workers)))
+		return 1;
+	memset(workers, 0, nr_workers * sizeof(*workers));
+	for (i = 0; i < NR_HISTS; i++)
+		hist_init(&hists[i]);
+
+	start = now();
+	for (i = 0; i < nr_workers; i++) {
+		workers[i].id = i;
+		workers[i].range = RANGE(games * i / nr_workers,
+					 games * (i + 1) / nr_workers);
+	}
+	for (i = 0; i < nr_workers; i++) {
+		if (pthread_create(&workers[i].thread, NULL, work,
+				   &workers[i])) {
+			fprintf(stderr, "batch: no thread\n");
+			return 1;
+		}
+	}
+	for (i = 0; i < nr_workers; i++) {
+		pthread_join(workers[i].thread, NULL);
+		frames += workers[i].frames;
+		stolen += workers[i].stolen;
+		cpu += workers[i].cpu;
+	}
+	secs = now() - start;
+
+	fprintf(stderr, "%lu games of %s on %u threads in %.3f s, %lu stolen\n",
+		games, policy->name, nr_workers, secs, stolen);
+	fprintf(stderr, "%.1f games per second, %.1f per core, "
+		"%.0f frames per second\n", secs > 0 ? games / secs : 0,
+		cpu > 0 ? games / cpu : 0, secs > 0 ? frames / secs : 0);
+	fprintf(stderr, "%lu lost, %lu won, %lu still running after %lu "
+		"frames\n", outcomes[GAME_LOST], outcomes[GAME_WON],
+		outcomes[GAME_RUNNING], max_frames);
+	for (i = 0; i < NR_HISTS; i++)
+		print_hist(&hists[i], games);
+
+	if (csv_path && write_csv(csv_path, games) < 0)
+		return 1;
+	if (json_path && write_json(json_path, games, secs, cpu, frames) < 0)
+		return 1;
+	free(results);
+	free(workers);
+	script_free(&script);
+	return 0;
+}
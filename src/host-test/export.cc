@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "export.h"
+#include "fbconv.h"
+
+#define EXPORT_BUFFER		(256 * 1024)
+#define EXPORT_QUEUE		64		/* frames */
+
+struct exporter {
+	FILE *file;
+	int piped;
+	int fd;
+	int format;
+	int width, pages;
+	int failed;
+
+	/* output buffer */
+	uint8_t *out;
+	size_t len;
+
+	/* linear frame */
+	uint8_t *linear;
+	size_t frame_size;
+
+	/* queue of page-format frames for the writer thread */
+	int threaded;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t more, room;
+	uint8_t *queue;
+	unsigned head, tail;		/* frames queued and written */
+	int closing;
+
+	struct export_stats stats;
+};
+
+static const char *format_names[] = {
+	"pbm", "y4m", "raw1", "raw8",
+};
+
+int
+export_format(const char *name)
+{
+	int i;
+
+	for (i = 0; i < (int)(sizeof(format_names) / sizeof(format_names[0])); i++)
+		if (!strcmp(name, format_names[i]))
+			return i;
+	return -1;
+}
+
+static unsigned long long
+now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static void
+flush(struct exporter *e)
+{
+	size_t done = 0;
+	ssize_t n;
+
+	while (done < e->len && !e->failed) {
+		n = write(e->fd, e->out + done, e->len - done);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			perror("export");
+			e->failed = 1;
+			break;
+		}
+		done += n;
+	}
+	e->len = 0;
+}
+
+static void
+put(struct exporter *e, const void *data, size_t size)
+{
+	if (e->len + size > EXPORT_BUFFER)
+		flush(e);
+	memcpy(e->out + e->len, data, size);
+	e->len += size;
+	e->stats.bytes += size;
+}
+
+static void
+write_frame(struct exporter *e, const uint8_t *frame)
+{
+	char header[64];
+	int n;
+
+	switch (e->format) {
+	case EXPORT_PBM:
+		n = snprintf(header, sizeof(header), "P4\n%d %d\n",
+			     e->width, e->pages * 8);
+		put(e, header, n);
+		/* fall through */
+	case EXPORT_RAW1:
+		fbconv_linear1(e->linear, frame, e->width, e->pages);
+		break;
+	case EXPORT_Y4M:
+		put(e, "FRAME\n", 6);
+		/* fall through */
+	case EXPORT_RAW8:
+		fbconv_linear8(e->linear, frame, e->width, e->pages, 0, 255);
+		break;
+	}
+	put(e, e->linear, e->frame_size);
+}
+
+static void *
+writer(void *arg)
+{
+	struct exporter *e = (struct exporter *)arg;
+	uint8_t *frame;
+
+	pthread_mutex_lock(&e->lock);
+	for (;;) {
+		while (e->head == e->tail && !e->closing)
+			pthread_cond_wait(&e->more, &e->lock);
+		if (e->head == e->tail)
+			break;
+		frame = e->queue + (e->tail % EXPORT_QUEUE) *
+			e->width * e->pages;
+		pthread_mutex_unlock(&e->lock);
+
+		write_frame(e, frame);
+
+		pthread_mutex_lock(&e->lock);
+		e->tail++;
+		pthread_cond_signal(&e->room);
+	}
+	pthread_mutex_unlock(&e->lock);
+	flush(e);
+	return NULL;
+}
+
+struct exporter *
+export_open(const char *path, int format, int width, int pages, int fps,
+	    int threaded)
+{
+	struct exporter *e;
+	char header[128];
+	int n;
+
+	e = (struct exporter *)calloc(1, sizeof(*e));
+	if (!e)
+		return NULL;
+	e->format = format;
+	e->width = width;
+	e->pages = pages;
+	if (format == EXPORT_PBM || format == EXPORT_RAW1)
+		e->frame_size = width / 8 * pages * 8;
+	else
+		e->frame_size = width * pages * 8;
+	e->out = (uint8_t *)malloc(EXPORT_BUFFER);
+	e->linear = (uint8_t *)malloc(e->frame_size);
+	if (!e->out || !e->linear)
+		goto fail;
+
+	if (!strcmp(path, "-")) {
+		e->fd = STDOUT_FILENO;
+	} else if (path[0] == '|') {
+		e->file = popen(path + 1, "w");
+		e->piped = 1;
+	} else {
+		e->file = fopen(path, "wb");
+	}
+	if (e->fd != STDOUT_FILENO) {
+		if (!e->file) {
+			perror(path);
+			goto fail;
+		}
+		e->fd = fileno(e->file);
+	}
+
+	if (format == EXPORT_Y4M) {
+		n = snprintf(header, sizeof(header),
+			     "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 Cmono\n",
+			     width, pages * 8, fps);
+		put(e, header, n);
+	}
+
+	e->threaded = threaded;
+	if (threaded) {
+		e->queue = (uint8_t *)malloc(EXPORT_QUEUE * width * pages);
+		if (!e->queue)
+			goto fail;
+		pthread_mutex_init(&e->lock, NULL);
+		pthread_cond_init(&e->more, NULL);
+		pthread_cond_init(&e->room, NULL);
+		if (pthread_create(&e->thread, NULL, writer, e)) {
+			fprintf(stderr, "export: no writer thread\n");
+			e->threaded = 0;
+		}
+	}
+	return e;
+
+fail:
+	if (e->file)
+		e->piped ? pclose(e->file) : fclose(e->file);
+	free(e->out);
+	free(e->linear);
+	free(e->queue);
+	free(e);
+	return NULL;
+}
+
+void
+export_frame(struct exporter *e, const uint8_t *frame)
+{
+	size_t size = e->width * e->pages;
+	unsigned long long start;
+
+	e->stats.frames++;
+	if (!e->threaded) {
+		write_frame(e, frame);
+		return;
+	}
+
+	pthread_mutex_lock(&e->lock);
+	if (e->head - e->tail == EXPORT_QUEUE) {
+		start = now_us();
+		e->stats.stalls++;
+		while (e->head - e->tail == EXPORT_QUEUE)
+			pthread_cond_wait(&e->room, &e->lock);
+		e->stats.stall_us += now_us() - start;
+	}
+	pthread_mutex_unlock(&e->lock);
+
+	/* only the game thread writes the head slot */
+	memcpy(e->queue + (e->head % EXPORT_QUEUE) * size, frame, size);
+
+	pthread_mutex_lock(&e->lock);
+	e->head++;
+	pthread_cond_signal(&e->more);
+	pthread_mutex_unlock(&e->lock);
+}
+
+int
+export_close(struct exporter *e, struct export_stats *stats)
+{
+	int failed;
+
+	if (e->threaded) {
+		pthread_mutex_lock(&e->lock);
+		e->closing = 1;
+		pthread_cond_signal(&e->more);
+		pthread_mutex_unlock(&e->lock);
+		pthread_join(e->thread, NULL);
+		pthread_mutex_destroy(&e->lock);
+		pthread_cond_destroy(&e->more);
+		pthread_cond_destroy(&e->room);
+	} else {
+		flush(e);
+	}
+
+	if (stats)
+		*stats = e->stats;
+	failed = e->failed;
+	if (e->file && (e->piped ? pclose(e->file) : fclose(e->file)))
+		failed = 1;
+	free(e->out);
+	free(e->linear);
+	free(e->queue);
+	free(e);
+	return failed ? -1 : 0;
+}
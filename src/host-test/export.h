@@ -0,0 +1,50 @@
+/*
+ * Streams frames of the host build to a file or a pipe.
+ *
+ * Frames are taken in page format and written as a PBM sequence, a Y4M
+ * stream, or as raw linear frames with 1 or 8 bits per pixel.  Output is
+ * collected in a large buffer.  With a writer thread, converting and writing
+ * happen in the background, and the game only copies the frame into a
+ * queue.  It waits only when the queue is full, which is counted.
+ */
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include <stdint.h>
+
+enum export_formats {
+	EXPORT_PBM,		/* P4 images one after the other */
+	EXPORT_Y4M,		/* mono YUV4MPEG2, 0 or 255 */
+	EXPORT_RAW1,		/* linear 1 bpp, msb first */
+	EXPORT_RAW8,		/* linear 8 bpp, 0 or 255 */
+};
+
+struct exporter;
+
+/*
+ * opens path, "-" for stdout or "|command" for a pipe into command, returns
+ * NULL on errors.  fps goes into the Y4M header.
+ */
+struct exporter *export_open(const char *path, int format, int width,
+			     int pages, int fps, int threaded);
+
+/* returns the format named name, -1 if there is none */
+int export_format(const char *name);
+
+/* queues a frame of pages * width page-format bytes */
+void export_frame(struct exporter *e, const uint8_t *frame);
+
+struct export_stats {
+	unsigned long frames;
+	unsigned long long bytes;
+	unsigned long stalls;		/* frames that waited for the queue */
+	unsigned long long stall_us;
+};
+
+/*
+ * writes what is left, closes and fills in stats if not NULL.  Returns -1
+ * if anything failed.
+ */
+int export_close(struct exporter *e, struct export_stats *stats);
+
+#endif
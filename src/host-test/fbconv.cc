@@ -0,0 +1,297 @@
+#include <string.h>
+
+#include "fbconv.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FBCONV_X86
+#include <immintrin.h>
+#endif
+
+/* one pixel at a time, what everything else is checked against */
+static void
+pixel_linear1(uint8_t *dst, const uint8_t *src, int width, int pages)
+{
+	int x, y, bit;
+
+	memset(dst, 0, width / 8 * pages * 8);
+	for (y = 0; y < pages * 8; y++)
+		for (x = 0; x < width; x++) {
+			bit = (src[(y / 8) * width + x] >> (y % 8)) & 1;
+			dst[y * (width / 8) + x / 8] |= bit << (7 - x % 8);
+		}
+}
+
+static void
+pixel_linear8(uint8_t *dst, const uint8_t *src, int width, int pages,
+	      uint8_t off, uint8_t on)
+{
+	int x, y;
+
+	for (y = 0; y < pages * 8; y++)
+		for (x = 0; x < width; x++)
+			dst[y * width + x] =
+				(src[(y / 8) * width + x] >> (y % 8)) & 1 ?
+				on : off;
+}
+
+static int
+always(void)
+{
+	return 1;
+}
+
+/*
+ * Transposes the 8x8 bit matrix of 8 column bytes.  The columns are loaded
+ * with the leftmost one in the top byte, afterwards byte r holds pixel row r
+ * with the leftmost pixel in bit 7.  Three delta swaps, see Hacker's Delight
+ * 7-3.
+ */
+static inline uint64_t
+transpose8(const uint8_t *col)
+{
+	uint64_t x, t;
+
+	memcpy(&x, col, 8);
+	x = __builtin_bswap64(x);
+
+	t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000cccc0000ccccULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ULL;
+	x = x ^ t ^ (t << 28);
+	return x;
+}
+
+/* converts the 8 pixel wide blocks from column x0 on */
+static void
+transpose_linear1(uint8_t *dst, const uint8_t *src, int width, int pages,
+		  int x0)
+{
+	int page, x, r, stride = width / 8;
+	uint64_t rows;
+
+	for (page = 0; page < pages; page++)
+		for (x = x0; x < width; x += 8) {
+			rows = transpose8(src + page * width + x);
+			for (r = 0; r < 8; r++)
+				dst[(page * 8 + r) * stride + x / 8] =
+					rows >> (r * 8);
+		}
+}
+
+/* the 8 bytes, 0x00 or 0xff, for the bits of a row byte, msb first */
+static uint64_t expand[256];
+
+static int
+init_expand(void)
+{
+	int b, i;
+
+	for (b = 0; b < 256; b++)
+		for (i = 0; i < 8; i++)
+			if (b & (0x80 >> i))
+				expand[b] |= 0xffULL << (i * 8);
+	return 1;
+}
+
+/* filled before main(), so threads can convert right away */
+static int expand_ready = init_expand();
+
+static void
+transpose_linear8(uint8_t *dst, const uint8_t *src, int width, int pages,
+		  uint8_t off, uint8_t on, int x0)
+{
+	int page, x, r;
+	uint64_t rows, m, on8, off8;
+
+	(void)expand_ready;
+	on8 = on * 0x0101010101010101ULL;
+	off8 = off * 0x0101010101010101ULL;
+	for (page = 0; page < pages; page++)
+		for (x = x0; x < width; x += 8) {
+			rows = transpose8(src + page * width + x);
+			for (r = 0; r < 8; r++) {
+				m = expand[(rows >> (r * 8)) & 0xff];
+				m = (m & on8) | (~m & off8);
+				memcpy(dst + (page * 8 + r) * width + x, &m, 8);
+			}
+		}
+}
+
+static void
+scalar_linear1(uint8_t *dst, const uint8_t *src, int width, int pages)
+{
+	transpose_linear1(dst, src, width, pages, 0);
+}
+
+static void
+scalar_linear8(uint8_t *dst, const uint8_t *src, int width, int pages,
+	       uint8_t off, uint8_t on)
+{
+	transpose_linear8(dst, src, width, pages, off, on, 0);
+}
+
+#ifdef FBCONV_X86
+/* movemask gives the leftmost pixel in bit 0, linear1 wants it in bit 7 */
+static inline uint32_t
+reverse_bits(uint32_t m)
+{
+	m = ((m >> 1) & 0x55555555) | ((m & 0x55555555) << 1);
+	m = ((m >> 2) & 0x33333333) | ((m & 0x33333333) << 2);
+	m = ((m >> 4) & 0x0f0f0f0f) | ((m & 0x0f0f0f0f) << 4);
+	return m;
+}
+
+/*
+ * movemask collects the sign bits of all bytes, that is pixel row 7 of 16
+ * columns.  Adding the bytes to themselves moves the next row up into the
+ * sign bits.
+ */
+__attribute__((target("sse2")))
+static void
+sse2_linear1(uint8_t *dst, const uint8_t *src, int width, int pages)
+{
+	int page, x, r, stride = width / 8;
+	uint16_t m;
+	__m128i v;
+
+	for (page = 0; page < pages; page++)
+		for (x = 0; x + 16 <= width; x += 16) {
+			v = _mm_loadu_si128((const __m128i *)(src + page * width + x));
+			for (r = 7; r >= 0; r--) {
+				m = reverse_bits(_mm_movemask_epi8(v));
+				memcpy(dst + (page * 8 + r) * stride + x / 8, &m, 2);
+				v = _mm_add_epi8(v, v);
+			}
+		}
+	if (width % 16)
+		transpose_linear1(dst, src, width, pages, width & ~15);
+}
+
+/* comparing against the bit of a row selects on or off for 16 pixels */
+__attribute__((target("sse2")))
+static void
+sse2_linear8(uint8_t *dst, const uint8_t *src, int width, int pages,
+	     uint8_t off, uint8_t on)
+{
+	int page, x, r;
+	__m128i v, bit, m;
+	__m128i von = _mm_set1_epi8(on), voff = _mm_set1_epi8(off);
+
+	for (page = 0; page < pages; page++)
+		for (x = 0; x + 16 <= width; x += 16) {
+			v = _mm_loadu_si128((const __m128i *)(src + page * width + x));
+			for (r = 0; r < 8; r++) {
+				bit = _mm_set1_epi8(1 << r);
+				m = _mm_cmpeq_epi8(_mm_and_si128(v, bit), bit);
+				m = _mm_or_si128(_mm_and_si128(m, von),
+						 _mm_andnot_si128(m, voff));
+				_mm_storeu_si128((__m128i *)(dst + (page * 8 + r) * width + x), m);
+			}
+		}
+	if (width % 16)
+		transpose_linear8(dst, src, width, pages, off, on, width & ~15);
+}
+
+static int
+has_sse2(void)
+{
+	return __builtin_cpu_supports("sse2");
+}
+
+/*
+ * The same with 32 columns at once, mirroring every 8 columns first makes
+ * movemask put the leftmost pixel into bit 7.
+ */
+__attribute__((target("avx2")))
+static void
+avx2_linear1(uint8_t *dst, const uint8_t *src, int width, int pages)
+{
+	int page, x, r, stride = width / 8;
+	uint32_t m;
+	__m256i v;
+	const __m256i mirror = _mm256_set_epi8(
+		8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+		8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+
+	for (page = 0; page < pages; page++)
+		for (x = 0; x + 32 <= width; x += 32) {
+			v = _mm256_loadu_si256((const __m256i *)(src + page * width + x));
+			v = _mm256_shuffle_epi8(v, mirror);
+			for (r = 7; r >= 0; r--) {
+				m = _mm256_movemask_epi8(v);
+				memcpy(dst + (page * 8 + r) * stride + x / 8, &m, 4);
+				v = _mm256_add_epi8(v, v);
+			}
+		}
+	if (width % 32)
+		transpose_linear1(dst, src, width, pages, width & ~31);
+}
+
+__attribute__((target("avx2")))
+static void
+avx2_linear8(uint8_t *dst, const uint8_t *src, int width, int pages,
+	     uint8_t off, uint8_t on)
+{
+	int page, x, r;
+	__m256i v, bit, m;
+	__m256i von = _mm256_set1_epi8(on), voff = _mm256_set1_epi8(off);
+
+	for (page = 0; page < pages; page++)
+		for (x = 0; x + 32 <= width; x += 32) {
+			v = _mm256_loadu_si256((const __m256i *)(src + page * width + x));
+			for (r = 0; r < 8; r++) {
+				bit = _mm256_set1_epi8(1 << r);
+				m = _mm256_cmpeq_epi8(_mm256_and_si256(v, bit), bit);
+				m = _mm256_blendv_epi8(voff, von, m);
+				_mm256_storeu_si256((__m256i *)(dst + (page * 8 + r) * width + x), m);
+			}
+		}
+	if (width % 32)
+		transpose_linear8(dst, src, width, pages, off, on, width & ~31);
+}
+
+static int
+has_avx2(void)
+{
+	return __builtin_cpu_supports("avx2");
+}
+#endif
+
+const struct fbconv_impl fbconv_impls[] = {
+	{ "pixel", always, pixel_linear1, pixel_linear8 },
+	{ "transpose", always, scalar_linear1, scalar_linear8 },
+#ifdef FBCONV_X86
+	{ "sse2", has_sse2, sse2_linear1, sse2_linear8 },
+	{ "avx2", has_avx2, avx2_linear1, avx2_linear8 },
+#endif
+	{ NULL, NULL, NULL, NULL },
+};
+
+const struct fbconv_impl *
+fbconv_best(void)
+{
+	static const struct fbconv_impl *best;
+	const struct fbconv_impl *impl;
+
+	if (best)
+		return best;
+	for (impl = fbconv_impls; impl->name; impl++)
+		if (impl->supported())
+			best = impl;
+	return best;
+}
+
+void
+fbconv_linear1(uint8_t *dst, const uint8_t *src, int width, int pages)
+{
+	fbconv_best()->linear1(dst, src, width, pages);
+}
+
+void
+fbconv_linear8(uint8_t *dst, const uint8_t *src, int width, int pages,
+	       uint8_t off, uint8_t on)
+{
+	fbconv_best()->linear8(dst, src, width, pages, off, on);
+}
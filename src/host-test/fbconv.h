@@ -0,0 +1,45 @@
+/*
+ * Conversion of page-format frames into linear rows.
+ *
+ * The Arduboy library and the SSD1306 keep pictures in pages: every byte
+ * holds 8 vertical pixels, bit 0 on top, and a page is a row of such bytes.
+ * Terminals, image files and frame hashes want rows of pixels instead.  The
+ * conversion transposes 8x8 bit blocks, with SSE2 or AVX2 if the CPU has
+ * them, into either
+ *
+ *   linear1: 1 bit per pixel, width / 8 bytes per row, the leftmost pixel
+ *            in the most significant bit like PBM
+ *   linear8: 1 byte per pixel, width bytes per row, off or on
+ *
+ * The width has to be a multiple of 8.
+ */
+#ifndef FBCONV_H
+#define FBCONV_H
+
+#include <stdint.h>
+
+typedef void (*fbconv_linear1_fn)(uint8_t *dst, const uint8_t *src,
+				  int width, int pages);
+typedef void (*fbconv_linear8_fn)(uint8_t *dst, const uint8_t *src,
+				  int width, int pages, uint8_t off,
+				  uint8_t on);
+
+struct fbconv_impl {
+	const char *name;
+	int (*supported)(void);
+	fbconv_linear1_fn linear1;
+	fbconv_linear8_fn linear8;
+};
+
+/* all implementations, slowest first, terminated by a NULL name */
+extern const struct fbconv_impl fbconv_impls[];
+
+/* the fastest implementation the CPU supports */
+const struct fbconv_impl *fbconv_best(void);
+
+/* convert with the fastest implementation */
+void fbconv_linear1(uint8_t *dst, const uint8_t *src, int width, int pages);
+void fbconv_linear8(uint8_t *dst, const uint8_t *src, int width, int pages,
+		    uint8_t off, uint8_t on);
+
+#endif
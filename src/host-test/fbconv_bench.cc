@@ -0,0 +1,92 @@
+/*
+ * Checks every conversion against the pixel by pixel one and measures how
+ * long each takes for a full 128x64 frame.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fbconv.h"
+
+#define WIDTH		128
+#define PAGES		8
+#define HEIGHT		(PAGES * 8)
+#define FRAMES		64
+
+static uint8_t frames[FRAMES][WIDTH * PAGES];
+static uint8_t want1[FRAMES][WIDTH / 8 * HEIGHT], got1[WIDTH / 8 * HEIGHT];
+static uint8_t want8[FRAMES][WIDTH * HEIGHT], got8[WIDTH * HEIGHT];
+
+static double
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int
+check(const struct fbconv_impl *impl)
+{
+	int i;
+
+	for (i = 0; i < FRAMES; i++) {
+		impl->linear1(got1, frames[i], WIDTH, PAGES);
+		impl->linear8(got8, frames[i], WIDTH, PAGES, ' ', '#');
+		if (memcmp(got1, want1[i], sizeof(got1)) ||
+		    memcmp(got8, want8[i], sizeof(got8))) {
+			printf("%-10s differs from pixel in frame %d\n",
+			       impl->name, i);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int
+main(int argc, char *argv[])
+{
+	const struct fbconv_impl *impl;
+	long loops = argc > 1 ? atol(argv[1]) : 200000;
+	double t, ns1, ns8;
+	long n;
+	int i, failed = 0;
+
+	srand(1);
+	for (i = 0; i < FRAMES; i++) {
+		for (n = 0; n < WIDTH * PAGES; n++)
+			frames[i][n] = rand();
+		fbconv_impls[0].linear1(want1[i], frames[i], WIDTH, PAGES);
+		fbconv_impls[0].linear8(want8[i], frames[i], WIDTH, PAGES,
+					' ', '#');
+	}
+
+	printf("%-10s %12s %12s\n", "", "linear1 ns", "linear8 ns");
+	for (impl = fbconv_impls; impl->name; impl++) {
+		if (!impl->supported()) {
+			printf("%-10s not supported\n", impl->name);
+			continue;
+		}
+		if (!check(impl)) {
+			failed = 1;
+			continue;
+		}
+
+		t = now_ns();
+		for (n = 0; n < loops; n++)
+			impl->linear1(got1, frames[n % FRAMES], WIDTH, PAGES);
+		ns1 = (now_ns() - t) / loops;
+
+		t = now_ns();
+		for (n = 0; n < loops; n++)
+			impl->linear8(got8, frames[n % FRAMES], WIDTH, PAGES,
+				      ' ', '#');
+		ns8 = (now_ns() - t) / loops;
+
+		printf("%-10s %12.1f %12.1f%s\n", impl->name, ns1, ns8,
+		       impl == fbconv_best() ? "  (used)" : "");
+	}
+	return failed;
+}
@@ -0,0 +1,199 @@
+/*
+ * Checks game_snapshot(), game_restore() and game_fork() and times them.
+ *
+ * Plays a game with the seed up to the frame, takes a snapshot and plays on
+ * for the rollout frames as the reference.  The game restored from the
+ * snapshot, a new game it is restored into and a fork taken at the frame
+ * all have to play on to the same checksum and screen.  Then snapshots,
+ * restores, forks and forks played on for the rollout frames are timed.
+ *
+ *   forks [-f frame] [-n rollout frames] [-r repeats] [-s seed]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Fatsche.h"
+
+/* frames pressing a in the menu */
+#define START_FRAMES		60
+/* frames the same buttons are held */
+#define HOLD_FRAMES		8
+
+static unsigned long step;
+
+uint8_t
+get_inputs(void)
+{
+	static const uint8_t moves[] = {
+		0, LEFT_BUTTON, RIGHT_BUTTON, DOWN_BUTTON,
+	};
+	static const uint8_t throws[] = {
+		0, A_BUTTON, B_BUTTON, A_BUTTON | B_BUTTON,
+	};
+	uint32_t h;
+
+	if (step < START_FRAMES)
+		return step & 1 ? A_BUTTON : 0;
+	h = (uint32_t)(step / HOLD_FRAMES) * 0x9e3779b9U;
+	h ^= h >> 15;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	return moves[h % 4] | throws[(h >> 8) % 4];
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* loop()s g from frame first up to last */
+static void
+play(struct game_context *g, unsigned long first, unsigned long last)
+{
+	struct game_context *selected = game_selected();
+
+	game_select(g);
+	for (step = first; step < last; step++)
+		loop();
+	game_select(selected);
+}
+
+static uint64_t
+screen_hash(struct game_context *g)
+{
+	const uint8_t *p = game_arduboy(g)->getBuffer();
+	uint64_t h = 0xcbf29ce484222325ULL;
+	unsigned i;
+
+	for (i = 0; i < (HEIGHT * WIDTH) / 8; i++)
+		h = (h ^ p[i]) * 0x100000001b3ULL;
+	return h;
+}
+
+static int
+check(const char *what, struct game_context *g, uint64_t sum, uint64_t screen)
+{
+	if (game_checksum(g) == sum && screen_hash(g) == screen)
+		return 0;
+	fprintf(stderr, "forks: %s plays on differently\n", what);
+	return -1;
+}
+
+static void
+report(const char *what, unsigned long n, double t)
+{
+	fprintf(stderr, "%-10s %8.0f per second, %6.2f us each\n", what,
+		t > 0 ? n / t : 0, n ? t * 1e6 / n : 0);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long frame = 600, rollout = 30, repeats = 100000, i;
+	uint32_t seed = 1;
+	struct game_context *g, *f;
+	struct game_snapshot *s;
+	uint64_t sum, screen;
+	double t;
+	int opt, err = 0;
+
+	while ((opt = getopt(argc, argv, "f:n:r:s:")) != -1) {
+		switch (opt) {
+		case 'f':
+			frame = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			rollout = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			repeats = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-f frame] [-n rollout "
+				"frames] [-r repeats] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+	s = (struct game_snapshot *)malloc(sizeof(*s));
+	g = game_create(seed);
+	if (!s || !g)
+		return 1;
+
+	/* setup() reads the buttons too */
+	step = 0;
+	game_select(g);
+	set_render(1);
+	setup();
+	game_select(NULL);
+	play(g, 0, frame);
+	game_snapshot(g, s);
+	f = game_fork(g);
+	if (!f)
+		return 1;
+
+	play(g, frame, frame + rollout);
+	sum = game_checksum(g);
+	screen = screen_hash(g);
+
+	play(f, frame, frame + rollout);
+	err |= check("a fork", f, sum, screen);
+	game_destroy(f);
+
+	if (game_restore(g, s) < 0)
+		return 1;
+	play(g, frame, frame + rollout);
+	err |= check("a restored game", g, sum, screen);
+
+	f = game_create(seed + 1);
+	if (!f || game_restore(f, s) < 0)
+		return 1;
+	play(f, frame, frame + rollout);
+	err |= check("a new game restored", f, sum, screen);
+	game_destroy(f);
+	if (err)
+		return 1;
+	fprintf(stderr, "restores and forks at frame %lu the same for %lu "
+		"frames\n", frame, rollout);
+
+	/* the way a search uses them, without drawing */
+	game_restore(g, s);
+	game_select(g);
+	set_render(0);
+	game_select(NULL);
+
+	t = now();
+	for (i = 0; i < repeats; i++)
+		game_snapshot(g, s);
+	report("snapshot", repeats, now() - t);
+
+	t = now();
+	for (i = 0; i < repeats; i++)
+		game_restore(g, s);
+	report("restore", repeats, now() - t);
+
+	t = now();
+	for (i = 0; i < repeats; i++)
+		game_destroy(game_fork(g));
+	report("fork", repeats, now() - t);
+
+	t = now();
+	for (i = 0; i < repeats / rollout + 1; i++) {
+		f = game_fork(g);
+		play(f, frame, frame + rollout);
+		game_destroy(f);
+	}
+	report("rollout", repeats / rollout + 1, now() - t);
+
+	game_destroy(g);
+	free(s);
+	return 0;
+}
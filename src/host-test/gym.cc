@@ -0,0 +1,316 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "Fatsche.h"
+#include "fbconv.h"
+#include "gym.h"
+
+/* give up on the menu after this */
+#define MENU_FRAMES		300
+
+static_assert(FATSCHE_OBS_FLOATS == GAME_FEATURES, "gym.h is out of date");
+
+struct fatsche_env {
+	struct game_context *game;
+	int obs;
+	uint8_t buttons;		/* held in the frame played */
+	int32_t score;
+	uint8_t done;
+	void *obs_buffer;		/* the caller's or own */
+	union {
+		uint8_t frame[FATSCHE_OBS_FRAME_BYTES];
+		float features[FATSCHE_OBS_FLOATS];
+	} own;
+};
+
+uint8_t
+get_inputs(void)
+{
+	struct fatsche_env *env;
+
+	env = (struct fatsche_env *)game_user(game_selected());
+	return env->buttons;
+}
+
+static uint8_t
+buttons(uint8_t action)
+{
+	return (action & FATSCHE_UP ? UP_BUTTON : 0) |
+		(action & FATSCHE_DOWN ? DOWN_BUTTON : 0) |
+		(action & FATSCHE_LEFT ? LEFT_BUTTON : 0) |
+		(action & FATSCHE_RIGHT ? RIGHT_BUTTON : 0) |
+		(action & FATSCHE_A ? A_BUTTON : 0) |
+		(action & FATSCHE_B ? B_BUTTON : 0);
+}
+
+struct fatsche_env *
+fatsche_create(int obs)
+{
+	struct fatsche_env *env;
+
+	if (obs != FATSCHE_OBS_FRAME && obs != FATSCHE_OBS_VECTOR)
+		return NULL;
+	env = (struct fatsche_env *)calloc(1, sizeof(*env));
+	if (!env)
+		return NULL;
+	env->obs = obs;
+	env->obs_buffer = &env->own;
+	return env;
+}
+
+void
+fatsche_destroy(struct fatsche_env *env)
+{
+	if (!env)
+		return;
+	if (env->game)
+		game_destroy(env->game);
+	free(env);
+}
+
+size_t
+fatsche_obs_size(int obs)
+{
+	return obs == FATSCHE_OBS_FRAME ? FATSCHE_OBS_FRAME_BYTES :
+		FATSCHE_OBS_FLOATS * sizeof(float);
+}
+
+void
+fatsche_set_obs_buffer(struct fatsche_env *env, void *buffer)
+{
+	if (buffer && env->obs_buffer != buffer)
+		memcpy(buffer, env->obs_buffer, fatsche_obs_size(env->obs));
+	env->obs_buffer = buffer ? buffer : &env->own;
+}
+
+const void *
+fatsche_observe(struct fatsche_env *env)
+{
+	return env->obs_buffer;
+}
+
+static void
+observe(struct fatsche_env *env)
+{
+	if (env->obs == FATSCHE_OBS_FRAME)
+		fbconv_linear1((uint8_t *)env->obs_buffer,
+			       game_arduboy(env->game)->getBuffer(), 128, 8);
+	else
+		game_features(env->game, (float *)env->obs_buffer);
+}
+
+/* a loop() that finishes a frame, which not every one does */
+static void
+frame(VeritazzExtra *arduboy)
+{
+	do
+		loop();
+	while (!arduboy->post_render);
+}
+
+int
+fatsche_reset(struct fatsche_env *env, uint32_t seed)
+{
+	struct game_context *selected = game_selected();
+	VeritazzExtra *arduboy;
+	struct game_status st;
+	unsigned i;
+
+	if (env->game)
+		game_destroy(env->game);
+	env->game = game_create(seed);
+	if (!env->game)
+		return -1;
+	arduboy = game_arduboy(env->game);
+	game_set_user(env->game, env);
+	game_select(env->game);
+	set_render(env->obs == FATSCHE_OBS_FRAME);
+	/* begin() waits for down while up is held */
+	env->buttons = 0;
+	setup();
+
+	/* a press in the menu starts the game */
+	for (i = 0; i < MENU_FRAMES; i++) {
+		env->buttons = i & 1 ? A_BUTTON : 0;
+		frame(arduboy);
+		game_status(env->game, &st);
+		if (st.playing)
+			break;
+	}
+	env->buttons = 0;
+	env->score = st.score;
+	env->done = st.result;
+	observe(env);
+	game_select(selected);
+	return st.playing ? 0 : -1;
+}
+
+void
+fatsche_step(struct fatsche_env *env, const uint8_t *actions, unsigned n,
+	     struct fatsche_result *result)
+{
+	struct game_context *selected = game_selected();
+	VeritazzExtra *arduboy;
+	struct game_status st;
+	unsigned i;
+
+	memset(result, 0, sizeof(*result));
+	if (!env->game) {
+		result->done = GAME_LOST;
+		return;
+	}
+	game_select(env->game);
+	arduboy = game_arduboy(env->game);
+	game_status(env->game, &st);
+	for (i = 0; i < n && !env->done; i++) {
+		env->buttons = buttons(actions[i]);
+		frame(arduboy);
+		game_status(env->game, &st);
+		env->done = st.result;
+		result->frames++;
+	}
+	result->reward = st.score - env->score;
+	result->score = st.score;
+	result->life = st.life;
+	result->stage = st.stage;
+	result->done = env->done;
+	env->score = st.score;
+	observe(env);
+	game_select(selected);
+}
+
+/*---------------------------------------------------------------------------
+ * pool
+ *---------------------------------------------------------------------------*/
+struct fatsche_pool {
+	pthread_t *threads;
+	unsigned nr_threads;
+	pthread_mutex_t lock;
+	pthread_cond_t start;
+	pthread_cond_t done;
+	unsigned long job;		/* counts the jobs started */
+	unsigned busy;			/* threads still on the job */
+	int stopping;
+
+	/* the job */
+	struct fatsche_env **envs;
+	unsigned nr_envs;
+	const uint8_t *actions;
+	unsigned n;
+	struct fatsche_result *results;
+	unsigned next;			/* environment to take */
+};
+
+static void
+work(struct fatsche_pool *p)
+{
+	unsigned i;
+
+	while ((i = __atomic_fetch_add(&p->next, 1, __ATOMIC_RELAXED)) <
+	       p->nr_envs)
+		fatsche_step(p->envs[i], p->actions + (size_t)i * p->n, p->n,
+			     &p->results[i]);
+}
+
+static void *
+run(void *arg)
+{
+	struct fatsche_pool *p = (struct fatsche_pool *)arg;
+	unsigned long job = 0;
+
+	pthread_mutex_lock(&p->lock);
+	for (;;) {
+		while (p->job == job && !p->stopping)
+			pthread_cond_wait(&p->start, &p->lock);
+		if (p->stopping)
+			break;
+		job = p->job;
+		pthread_mutex_unlock(&p->lock);
+		work(p);
+		pthread_mutex_lock(&p->lock);
+		if (!--p->busy)
+			pthread_cond_signal(&p->done);
+	}
+	pthread_mutex_unlock(&p->lock);
+	return NULL;
+}
+
+struct fatsche_pool *
+fatsche_pool_create(unsigned threads)
+{
+	struct fatsche_pool *p;
+	long cpus;
+
+	if (!threads) {
+		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = cpus > 0 ? cpus : 1;
+	}
+	p = (struct fatsche_pool *)calloc(1, sizeof(*p));
+	if (!p)
+		return NULL;
+	pthread_mutex_init(&p->lock, NULL);
+	pthread_cond_init(&p->start, NULL);
+	pthread_cond_init(&p->done, NULL);
+	/* the caller of fatsche_step_many() is one of them */
+	p->threads = (pthread_t *)calloc(threads, sizeof(*p->threads));
+	if (!p->threads) {
+		fatsche_pool_destroy(p);
+		return NULL;
+	}
+	while (p->nr_threads + 1 < threads) {
+		if (pthread_create(&p->threads[p->nr_threads], NULL, run, p)) {
+			fatsche_pool_destroy(p);
+			return NULL;
+		}
+		p->nr_threads++;
+	}
+	return p;
+}
+
+void
+fatsche_pool_destroy(struct fatsche_pool *p)
+{
+	unsigned i;
+
+	if (!p)
+		return;
+	pthread_mutex_lock(&p->lock);
+	p->stopping = 1;
+	pthread_cond_broadcast(&p->start);
+	pthread_mutex_unlock(&p->lock);
+	for (i = 0; i < p->nr_threads; i++)
+		pthread_join(p->threads[i], NULL);
+	pthread_cond_destroy(&p->done);
+	pthread_cond_destroy(&p->start);
+	pthread_mutex_destroy(&p->lock);
+	free(p->threads);
+	free(p);
+}
+
+void
+fatsche_step_many(struct fatsche_pool *p, struct fatsche_env **envs,
+		  unsigned nr_envs, const uint8_t *actions, unsigned n,
+		  struct fatsche_result *results)
+{
+	pthread_mutex_lock(&p->lock);
+	p->envs = envs;
+	p->nr_envs = nr_envs;
+	p->actions = actions;
+	p->n = n;
+	p->results = results;
+	p->next = 0;
+	p->busy = p->nr_threads;
+	p->job++;
+	pthread_cond_broadcast(&p->start);
+	pthread_mutex_unlock(&p->lock);
+
+	work(p);
+
+	pthread_mutex_lock(&p->lock);
+	while (p->busy)
+		pthread_cond_wait(&p->done, &p->lock);
+	pthread_mutex_unlock(&p->lock);
+}
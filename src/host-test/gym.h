@@ -0,0 +1,103 @@
+/*
+ * C interface to step Fatsche from outside agents, built as
+ * libfatsche_gym.so by make gym.
+ *
+ * An environment is one headless game on its own virtual clock.  reset
+ * starts a new game with a seed and goes through the menu into play, step
+ * plays frames with the buttons given for each.  The reward is the score
+ * gained; a game is done once it is lost or won.  The observation is
+ * either the screen or a vector of numbers (see GAME_FEATURES in
+ * Fatsche.h):
+ *
+ *   FATSCHE_OBS_FRAME   128x64 at 1 bit per pixel, 16 bytes per row, the
+ *                       leftmost pixel in the most significant bit
+ *   FATSCHE_OBS_VECTOR  FATSCHE_OBS_FLOATS floats, the frames are not drawn
+ *
+ * Observations are written to a buffer of the environment, or to one set by
+ * the caller, e.g. a row of a large array shared by all environments, so
+ * nothing needs to be copied out.  A pool of threads steps many
+ * environments at once, each of them in one thread at a time.
+ *
+ * The library is built with -fvisibility=hidden, it only exports the
+ * functions below.
+ */
+#ifndef GYM_H
+#define GYM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FATSCHE_API			__attribute__((visibility("default")))
+
+/* the buttons of an action */
+#define FATSCHE_UP			(1 << 0)
+#define FATSCHE_DOWN			(1 << 1)
+#define FATSCHE_LEFT			(1 << 2)
+#define FATSCHE_RIGHT			(1 << 3)
+#define FATSCHE_A			(1 << 4)
+#define FATSCHE_B			(1 << 5)
+
+enum fatsche_obs {
+	FATSCHE_OBS_FRAME,
+	FATSCHE_OBS_VECTOR,
+};
+
+#define FATSCHE_OBS_FRAME_BYTES		(128 * 64 / 8)
+#define FATSCHE_OBS_FLOATS		178
+
+struct fatsche_env;
+struct fatsche_pool;
+
+struct fatsche_result {
+	int32_t reward;			/* score gained in these frames */
+	int32_t score;
+	int16_t life;			/* of the door */
+	uint8_t stage;			/* cleared */
+	uint8_t done;			/* 1 lost, 2 won */
+	uint32_t frames;		/* played, fewer than asked once done */
+};
+
+/* NULL on errors */
+FATSCHE_API struct fatsche_env *fatsche_create(int obs);
+FATSCHE_API void fatsche_destroy(struct fatsche_env *env);
+
+/* bytes of an observation of the kind */
+FATSCHE_API size_t fatsche_obs_size(int obs);
+
+/* where observations go, NULL for the environment's own buffer */
+FATSCHE_API void fatsche_set_obs_buffer(struct fatsche_env *env,
+					void *buffer);
+
+/* a new game in play, returns -1 if it did not get past the menu */
+FATSCHE_API int fatsche_reset(struct fatsche_env *env, uint32_t seed);
+
+/* plays a frame for each of the n actions, stops when done */
+FATSCHE_API void fatsche_step(struct fatsche_env *env,
+			      const uint8_t *actions, unsigned n,
+			      struct fatsche_result *result);
+
+/* the observation after the last reset or step */
+FATSCHE_API const void *fatsche_observe(struct fatsche_env *env);
+
+/* threads 0 for one per core, NULL on errors */
+FATSCHE_API struct fatsche_pool *fatsche_pool_create(unsigned threads);
+FATSCHE_API void fatsche_pool_destroy(struct fatsche_pool *pool);
+
+/*
+ * fatsche_step() of every environment, actions holds n for each of them one
+ * after the other, results one for each.  Returns when all are done.
+ */
+FATSCHE_API void fatsche_step_many(struct fatsche_pool *pool,
+				   struct fatsche_env **envs, unsigned nr_envs,
+				   const uint8_t *actions, unsigned n,
+				   struct fatsche_result *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,219 @@
+/*
+ * Checks libfatsche_gym.so through gym.h alone, as an agent would use it.
+ *
+ * Environments of both observations are reset with their seeds and played
+ * for rounds of frames with buttons hashed from the environment, round and
+ * frame: once with fatsche_step() one after the other, then with
+ * fatsche_step_many() on a pool of one thread and on one of many.  The
+ * results and observations of every round have to be the same each time.
+ *
+ *   gymcheck [-e environments] [-j threads] [-n frames] [-r rounds]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gym.h"
+
+struct run {
+	struct fatsche_env **envs;
+	struct fatsche_result *results;	/* of every round, one per env */
+	uint64_t *obs;			/* hashes, likewise */
+};
+
+static unsigned nr_envs = 32, frames = 8, rounds = 300;
+
+static uint64_t
+fnv(const void *data, size_t size)
+{
+	const uint8_t *p = (const uint8_t *)data;
+	uint64_t h = 0xcbf29ce484222325ULL;
+
+	while (size--)
+		h = (h ^ *p++) * 0x100000001b3ULL;
+	return h;
+}
+
+static int
+obs_kind(unsigned e)
+{
+	return e & 1 ? FATSCHE_OBS_VECTOR : FATSCHE_OBS_FRAME;
+}
+
+static uint8_t
+action(unsigned e, unsigned round, unsigned frame)
+{
+	static const uint8_t moves[] = {
+		0, FATSCHE_LEFT, FATSCHE_RIGHT, FATSCHE_A, FATSCHE_B,
+		FATSCHE_LEFT | FATSCHE_A, FATSCHE_RIGHT | FATSCHE_B, FATSCHE_UP,
+	};
+	uint32_t h = (e * 2654435761U) ^ (round * 40503U) ^ (frame * 97U);
+
+	h ^= h >> 13;
+	h *= 0x5bd1e995;
+	h ^= h >> 15;
+	/* a move is held for a while, like a player would */
+	return moves[(h >> (round & 8 ? 3 : 5)) % sizeof(moves)];
+}
+
+static int
+start(struct run *r)
+{
+	unsigned e;
+
+	r->envs = (struct fatsche_env **)calloc(nr_envs, sizeof(*r->envs));
+	r->results = (struct fatsche_result *)
+		calloc((size_t)nr_envs * rounds, sizeof(*r->results));
+	r->obs = (uint64_t *)calloc((size_t)nr_envs * rounds, sizeof(*r->obs));
+	if (!r->envs || !r->results || !r->obs)
+		return -1;
+	for (e = 0; e < nr_envs; e++) {
+		r->envs[e] = fatsche_create(obs_kind(e));
+		if (!r->envs[e] || fatsche_reset(r->envs[e], e + 1) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+static void
+finish(struct run *r)
+{
+	unsigned e;
+
+	for (e = 0; r->envs && e < nr_envs; e++)
+		fatsche_destroy(r->envs[e]);
+	free(r->envs);
+	free(r->results);
+	free(r->obs);
+}
+
+static void
+observe(struct run *r, unsigned round)
+{
+	unsigned e;
+
+	for (e = 0; e < nr_envs; e++)
+		r->obs[round * nr_envs + e] =
+			fnv(fatsche_observe(r->envs[e]),
+			    fatsche_obs_size(obs_kind(e)));
+}
+
+static void
+fill_actions(uint8_t *actions, unsigned round)
+{
+	unsigned e, f;
+
+	for (e = 0; e < nr_envs; e++)
+		for (f = 0; f < frames; f++)
+			actions[e * frames + f] = action(e, round, f);
+}
+
+/* pool NULL for fatsche_step() on every environment */
+static int
+play(struct run *r, struct fatsche_pool *pool)
+{
+	uint8_t *actions;
+	unsigned round, e;
+
+	if (start(r) < 0)
+		return -1;
+	actions = (uint8_t *)malloc((size_t)nr_envs * frames);
+	if (!actions)
+		return -1;
+	for (round = 0; round < rounds; round++) {
+		fill_actions(actions, round);
+		if (pool)
+			fatsche_step_many(pool, r->envs, nr_envs, actions,
+					  frames, r->results + round * nr_envs);
+		else
+			for (e = 0; e < nr_envs; e++)
+				fatsche_step(r->envs[e], actions + e * frames,
+					     frames,
+					     &r->results[round * nr_envs + e]);
+		observe(r, round);
+	}
+	free(actions);
+	return 0;
+}
+
+/* returns 0 if b played just like a */
+static int
+compare(const struct run *a, const struct run *b, const char *what)
+{
+	unsigned i;
+
+	for (i = 0; i < nr_envs * rounds; i++) {
+		if (!memcmp(&a->results[i], &b->results[i],
+			    sizeof(a->results[i])) && a->obs[i] == b->obs[i])
+			continue;
+		fprintf(stderr, "%s: environment %u differs in round %u, "
+			"score %d instead of %d\n", what, i % nr_envs,
+			i / nr_envs, b->results[i].score, a->results[i].score);
+		return -1;
+	}
+	return 0;
+}
+
+static void
+usage(const char *name)
+{
+	fprintf(stderr, "usage: %s [-e environments] [-j threads] "
+		"[-n frames] [-r rounds]\n", name);
+	exit(2);
+}
+
+int
+main(int argc, char **argv)
+{
+	struct run ref = {}, one = {}, many = {};
+	struct fatsche_pool *pool1, *pool;
+	unsigned threads = 4, e, done = 0;
+	int c, ret = 1;
+
+	while ((c = getopt(argc, argv, "e:j:n:r:")) != -1) {
+		switch (c) {
+		case 'e':
+			nr_envs = atoi(optarg);
+			break;
+		case 'j':
+			threads = atoi(optarg);
+			break;
+		case 'n':
+			frames = atoi(optarg);
+			break;
+		case 'r':
+			rounds = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (!nr_envs || !frames || !rounds || threads < 2)
+		usage(argv[0]);
+
+	pool1 = fatsche_pool_create(1);
+	pool = fatsche_pool_create(threads);
+	if (!pool1 || !pool || play(&ref, NULL) < 0 ||
+	    play(&one, pool1) < 0 || play(&many, pool) < 0) {
+		fprintf(stderr, "gymcheck: no environments\n");
+		goto out;
+	}
+	if (compare(&ref, &one, "1 thread") < 0 ||
+	    compare(&ref, &many, "many threads") < 0)
+		goto out;
+
+	for (e = 0; e < nr_envs; e++)
+		done += ref.results[(rounds - 1) * nr_envs + e].done != 0;
+	fprintf(stderr, "%u environments the same with fatsche_step() and "
+		"1 and %u threads for %u frames, %u of them done\n",
+		nr_envs, threads, rounds * frames, done);
+	ret = 0;
+out:
+	fatsche_pool_destroy(pool);
+	fatsche_pool_destroy(pool1);
+	finish(&many);
+	finish(&one);
+	finish(&ref);
+	return ret;
+}
@@ -0,0 +1,188 @@
+/*
+ * Runs the game without a terminal and as fast as it goes.
+ *
+ * Built with HOST_HEADLESS, millis() reads a virtual clock that only moves
+ * when the game waits: nextFrame() jumps it to the next frame, delay() by
+ * the time asked for.  The buttons come from a script, so a run is the
+ * same every time for the same script and seed.  With -k n only every nth
+ * frame is drawn, and the last one, with -k 0 only the last one.  The game
+ * runs the same either way, only the fades between screens hold the last
+ * frame drawn instead of the one before.  Scripts are described in
+ * script.h, -p records a replay of the run as described in replay.h.
+ *
+ *   headless [-n frames] [-k n] [-i script] [-s seed] [-o file [-f format]]
+ *            [-r file] [-p file]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Fatsche.h"
+#include "ssd1306.h"
+#include "export.h"
+#include "rec.h"
+#include "replay.h"
+#include "script.h"
+
+static struct ssd1306 oled;
+
+static struct script script;
+static unsigned long script_next;
+
+static unsigned long frames;
+static uint8_t buttons;
+
+
+void
+oled_transfer(const uint8_t *data, uint16_t size, bool command)
+{
+	ssd1306_write(&oled, data, size, command);
+}
+
+uint8_t
+get_inputs(void)
+{
+	buttons = script_buttons(&script, &script_next, frames, buttons);
+	return buttons;
+}
+
+static uint64_t
+frame_hash(const uint8_t *data, size_t size)
+{
+	uint64_t h = 0xcbf29ce484222325ULL;
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		h = (h ^ data[i]) * 0x100000001b3ULL;
+	return h;
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *export_path = NULL, *rec_path = NULL, *script_path = NULL;
+	const char *replay_path = NULL;
+	int export_fmt = EXPORT_PBM, opt;
+	unsigned long max_frames = 1800, every = 1, drawn = 0;
+	int render;
+	struct exporter *exporter = NULL;
+	struct rec_writer *recording = NULL;
+	struct replay_writer *replay = NULL;
+	struct game_context *game;
+	VeritazzExtra *arduboy;
+	uint32_t seed = 1;
+	double start, secs;
+
+	while ((opt = getopt(argc, argv, "f:i:k:n:o:p:r:s:")) != -1) {
+		switch (opt) {
+		case 'f':
+			export_fmt = export_format(optarg);
+			if (export_fmt < 0) {
+				fprintf(stderr, "formats: pbm y4m raw1 raw8\n");
+				return 1;
+			}
+			break;
+		case 'i':
+			script_path = optarg;
+			break;
+		case 'k':
+			every = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			max_frames = strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			export_path = optarg;
+			break;
+		case 'p':
+			replay_path = optarg;
+			break;
+		case 'r':
+			rec_path = optarg;
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-n frames] [-k n] [-i script|-] "
+				"[-s seed] [-o file|-|'|command' [-f format]] "
+				"[-r file] [-p file]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (script_path && script_load(&script, script_path) < 0)
+		return 1;
+	ssd1306_reset(&oled, 8000000);
+	if (export_path) {
+		exporter = export_open(export_path, export_fmt, WIDTH,
+				       HEIGHT / 8, 30, 0);
+		if (!exporter)
+			return 1;
+	}
+	if (rec_path) {
+		recording = rec_create(rec_path, WIDTH, HEIGHT / 8, 30, 300);
+		if (!recording)
+			return 1;
+	}
+
+	game = game_create(seed);
+	if (!game)
+		return 1;
+	arduboy = game_arduboy(game);
+	game_select(game);
+
+	start = now();
+	setup();
+	if (replay_path) {
+		replay = replay_create(replay_path, game, seed, 300);
+		if (!replay)
+			return 1;
+	}
+	while (frames < max_frames) {
+		/* frames counts the ones done, this is for the next */
+		render = frames + 1 == max_frames ||
+			(every && (frames + 1) % every == 0);
+		set_render(render);
+		loop();
+		if (arduboy->post_render) {
+			frames++;
+			if (replay)
+				replay_frame(replay, game, buttons);
+			if (!render)
+				continue;
+			drawn++;
+			if (exporter)
+				export_frame(exporter, oled.gddram);
+			if (recording)
+				rec_frame(recording, oled.gddram);
+		}
+	}
+	secs = now() - start;
+
+	if (exporter && export_close(exporter, NULL) < 0)
+		fprintf(stderr, "export to %s failed\n", export_path);
+	if (recording && rec_close(recording, NULL) < 0)
+		fprintf(stderr, "recording to %s failed\n", rec_path);
+	if (replay && replay_close(replay, NULL) < 0)
+		fprintf(stderr, "replay to %s failed\n", replay_path);
+	/* stdout may carry the export */
+	fprintf(stderr, "%lu frames, %lu drawn, %lu ms of game time in %.3f s, "
+		"%.0f frames per second\n", frames, drawn, host_millis, secs,
+		secs > 0 ? frames / secs : 0);
+	fprintf(stderr, "last frame %016llx\n",
+		(unsigned long long)frame_hash(oled.gddram,
+					       sizeof(oled.gddram)));
+	game_destroy(game);
+	script_free(&script);
+	return 0;
+}
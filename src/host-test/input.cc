@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+
+#include "input.h"
+
+#define INPUT_QUEUE		256		/* a power of two */
+
+/* a terminal key is held until it stops repeating */
+#define HOLD_FIRST_US		500000		/* until the first repeat */
+#define HOLD_REPEAT_US		100000
+
+/* an escape on its own quits when nothing follows it for this long */
+#define ESC_WAIT_US		50000
+
+/* how often the thread looks whether it should stop */
+#define STOP_POLL_MS		50
+
+struct input {
+	int fd;
+	int evdev;
+	pthread_t thread;
+	int stopping;
+
+	/* written by the thread only */
+	unsigned head;
+	/* written by the game only */
+	unsigned tail;
+	struct input_key queue[INPUT_QUEUE];
+
+	/* terminal keys held and when they are released */
+	uint64_t release_us[INPUT_KEYS];
+
+	/* the bytes of an escape sequence seen so far, it may span reads */
+	int esc;
+	uint64_t esc_us;
+
+	struct input_stats stats;
+};
+
+static uint64_t
+now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static void
+push(struct input *in, int key, int down, uint64_t time_us)
+{
+	unsigned head = in->head;
+	struct input_key *k;
+
+	if (head - __atomic_load_n(&in->tail, __ATOMIC_ACQUIRE) == INPUT_QUEUE) {
+		in->stats.overflows++;
+		return;
+	}
+	k = &in->queue[head % INPUT_QUEUE];
+	k->time_us = time_us;
+	k->key = key;
+	k->down = down;
+	__atomic_store_n(&in->head, head + 1, __ATOMIC_RELEASE);
+	in->stats.keys++;
+}
+
+/* a character for key arrived from the terminal */
+static void
+term_key(struct input *in, int key, uint64_t now)
+{
+	if (key == INPUT_QUIT) {
+		push(in, key, 1, now);
+		return;
+	}
+	if (in->release_us[key]) {
+		in->release_us[key] = now + HOLD_REPEAT_US;
+		return;
+	}
+	in->release_us[key] = now + HOLD_FIRST_US;
+	push(in, key, 1, now);
+}
+
+/* the character after ESC [ or ESC O */
+static void
+term_arrow(struct input *in, unsigned char c, uint64_t now)
+{
+	switch (c) {
+	case 'A':
+		term_key(in, INPUT_UP, now);
+		break;
+	case 'B':
+		term_key(in, INPUT_DOWN, now);
+		break;
+	case 'C':
+		term_key(in, INPUT_RIGHT, now);
+		break;
+	case 'D':
+		term_key(in, INPUT_LEFT, now);
+		break;
+	}
+}
+
+static void
+term_read(struct input *in)
+{
+	unsigned char buf[256];
+	uint64_t now;
+	ssize_t n;
+	int i;
+
+	n = read(in->fd, buf, sizeof(buf));
+	if (n <= 0)
+		return;
+	now = now_us();
+	for (i = 0; i < n; i++) {
+		/* arrows are ESC [ x or ESC O x */
+		if (in->esc == 2) {
+			in->esc = 0;
+			term_arrow(in, buf[i], now);
+			continue;
+		}
+		if (in->esc == 1) {
+			if (buf[i] == '[' || buf[i] == 'O') {
+				in->esc = 2;
+				continue;
+			}
+			/* an escape on its own quits */
+			in->esc = 0;
+			term_key(in, INPUT_QUIT, now);
+		}
+		switch (buf[i]) {
+		case 'a':
+		case 'A':
+			term_key(in, INPUT_A, now);
+			break;
+		case 'b':
+		case 'B':
+			term_key(in, INPUT_B, now);
+			break;
+		case 27:
+			/* the rest may come with the next read */
+			in->esc = 1;
+			in->esc_us = now + ESC_WAIT_US;
+			break;
+		}
+	}
+}
+
+/*
+ * releases the terminal keys that stopped repeating and quits on an escape
+ * nothing followed, returns the next wait
+ */
+static int
+term_release(struct input *in)
+{
+	uint64_t now = now_us(), wait = STOP_POLL_MS * 1000;
+	int key;
+
+	/* nothing came after an escape, or a sequence broke off */
+	if (in->esc) {
+		if (in->esc_us <= now) {
+			if (in->esc == 1)
+				push(in, INPUT_QUIT, 1, now);
+			in->esc = 0;
+		} else {
+			wait = in->esc_us - now;
+		}
+	}
+
+	for (key = 0; key < INPUT_KEYS; key++) {
+		if (!in->release_us[key])
+			continue;
+		if (in->release_us[key] <= now) {
+			in->release_us[key] = 0;
+			push(in, key, 0, now);
+		} else if (in->release_us[key] - now < wait) {
+			wait = in->release_us[key] - now;
+		}
+	}
+	return (wait + 999) / 1000;
+}
+
+static int
+evdev_key(int code)
+{
+	switch (code) {
+	case KEY_UP:
+		return INPUT_UP;
+	case KEY_DOWN:
+		return INPUT_DOWN;
+	case KEY_LEFT:
+		return INPUT_LEFT;
+	case KEY_RIGHT:
+		return INPUT_RIGHT;
+	case KEY_A:
+		return INPUT_A;
+	case KEY_B:
+		return INPUT_B;
+	case KEY_ESC:
+		return INPUT_QUIT;
+	}
+	return -1;
+}
+
+static void
+evdev_read(struct input *in)
+{
+	struct input_event ev[64];
+	ssize_t n;
+	int i, key;
+
+	n = read(in->fd, ev, sizeof(ev));
+	for (i = 0; i < n / (ssize_t)sizeof(ev[0]); i++) {
+		/* 2 is an autorepeat */
+		if (ev[i].type != EV_KEY || ev[i].value > 1)
+			continue;
+		key = evdev_key(ev[i].code);
+		if (key < 0)
+			continue;
+		push(in, key, ev[i].value, ev[i].input_event_sec * 1000000ULL +
+		     ev[i].input_event_usec);
+	}
+}
+
+static void *
+run(void *arg)
+{
+	struct input *in = (struct input *)arg;
+	struct pollfd pfd;
+	int wait;
+
+	pfd.fd = in->fd;
+	pfd.events = POLLIN;
+	while (!__atomic_load_n(&in->stopping, __ATOMIC_ACQUIRE)) {
+		wait = in->evdev ? STOP_POLL_MS : term_release(in);
+		if (poll(&pfd, 1, wait) <= 0)
+			continue;
+		if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			/* nothing more to read, closing ends the game */
+			push(in, INPUT_QUIT, 1, now_us());
+			break;
+		}
+		if (in->evdev)
+			evdev_read(in);
+		else
+			term_read(in);
+	}
+	return NULL;
+}
+
+struct input *
+input_start(const char *device)
+{
+	struct input *in;
+	int clock = CLOCK_MONOTONIC;
+
+	in = (struct input *)calloc(1, sizeof(*in));
+	if (!in)
+		return NULL;
+	if (device) {
+		in->fd = open(device, O_RDONLY);
+		if (in->fd < 0) {
+			perror(device);
+			free(in);
+			return NULL;
+		}
+		/* the same clock as the frames */
+		ioctl(in->fd, EVIOCSCLOCKID, &clock);
+		in->evdev = 1;
+	} else {
+		in->fd = STDIN_FILENO;
+	}
+	if (pthread_create(&in->thread, NULL, run, in)) {
+		fprintf(stderr, "input: no thread\n");
+		if (in->evdev)
+			close(in->fd);
+		free(in);
+		return NULL;
+	}
+	return in;
+}
+
+int
+input_peek(struct input *in, struct input_key *key)
+{
+	if (__atomic_load_n(&in->head, __ATOMIC_ACQUIRE) == in->tail)
+		return 0;
+	*key = in->queue[in->tail % INPUT_QUEUE];
+	return 1;
+}
+
+void
+input_pop(struct input *in)
+{
+	__atomic_store_n(&in->tail, in->tail + 1, __ATOMIC_RELEASE);
+}
+
+void
+input_stop(struct input *in, struct input_stats *stats)
+{
+	__atomic_store_n(&in->stopping, 1, __ATOMIC_RELEASE);
+	pthread_join(in->thread, NULL);
+	if (in->evdev)
+		close(in->fd);
+	if (stats)
+		*stats = in->stats;
+	free(in);
+}
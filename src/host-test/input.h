@@ -0,0 +1,52 @@
+/*
+ * Reads the keys of the host build in a thread of its own.
+ *
+ * Every key is timestamped when it is read and pushed into a lock-free
+ * single producer, single consumer queue that the game drains once per
+ * frame.  The events come either from the terminal or from an evdev device
+ * such as /dev/input/event3.  A terminal only sends characters, repeated
+ * while a key is held, so a release is made up once a key stops repeating.
+ * evdev has real presses and releases but needs read access to the device.
+ */
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+
+enum input_keys {
+	INPUT_UP,
+	INPUT_DOWN,
+	INPUT_LEFT,
+	INPUT_RIGHT,
+	INPUT_A,
+	INPUT_B,
+	INPUT_QUIT,
+	INPUT_KEYS,
+};
+
+struct input_key {
+	uint64_t time_us;		/* CLOCK_MONOTONIC */
+	uint8_t key;
+	uint8_t down;			/* pressed or released */
+};
+
+struct input;
+
+/* reads the terminal on fd 0 with device NULL, NULL on errors */
+struct input *input_start(const char *device);
+
+/* the oldest key without removing it, returns 0 if there is none */
+int input_peek(struct input *in, struct input_key *key);
+
+/* removes the oldest key */
+void input_pop(struct input *in);
+
+struct input_stats {
+	unsigned long keys;
+	unsigned long overflows;	/* lost to a full queue */
+};
+
+/* stops the thread and fills in stats if not NULL */
+void input_stop(struct input *in, struct input_stats *stats);
+
+#endif
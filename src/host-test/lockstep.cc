@@ -0,0 +1,289 @@
+/*
+ * Checks game_lockstep_step() against loop() and times both.
+ *
+ * Plays games with the seeds first.. twice, once with a loop() for every
+ * game in turn as the reference and once in groups of up to
+ * GAME_LOCKSTEP_LANES in lockstep.  The buttons are a hash of the game and
+ * the frame, the same for both, and now and then some games are drawn for a
+ * while.  The checksums of every game have to be the same after every
+ * frame; the first game and frame that differ are reported.  Then both are
+ * timed without the checks and without drawing.
+ *
+ *   lockstep [-g games] [-n frames] [-s first seed]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Fatsche.h"
+
+/* frames pressing a in the menu */
+#define START_FRAMES		60
+/* frames the same buttons are held */
+#define HOLD_FRAMES		8
+/* every DRAW_GAMES-th game is drawn for DRAW_FRAMES of every DRAW_PERIOD */
+#define DRAW_GAMES		4
+#define DRAW_FRAMES		30
+#define DRAW_PERIOD		600
+
+/* what get_inputs() needs to know of a game */
+struct pad {
+	unsigned index;
+};
+
+/* games played the one or the other way */
+struct run {
+	struct game_context **g;
+	struct game_lockstep **groups;
+	unsigned n;
+	unsigned nr_groups;
+};
+
+static unsigned long step;
+
+static uint8_t
+buttons_at(unsigned index, unsigned long frame)
+{
+	static const uint8_t moves[] = {
+		0, LEFT_BUTTON, RIGHT_BUTTON, UP_BUTTON, DOWN_BUTTON,
+	};
+	static const uint8_t throws[] = {
+		0, A_BUTTON, B_BUTTON, A_BUTTON | B_BUTTON,
+	};
+	uint32_t h;
+	uint8_t b;
+
+	if (frame < START_FRAMES)
+		return frame & 1 ? A_BUTTON : 0;
+	h = (index * 0x9e3779b9U) ^ (uint32_t)(frame / HOLD_FRAMES);
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	b = moves[h % 5] | throws[(h >> 8) % 4];
+	/* up and a pause it, only sometimes */
+	if ((b & UP_BUTTON) && ((h >> 12) & 15))
+		b &= ~A_BUTTON;
+	return b;
+}
+
+uint8_t
+get_inputs(void)
+{
+	struct pad *p = (struct pad *)game_user(game_selected());
+
+	return buttons_at(p->index, step);
+}
+
+static void
+create(struct run *r, unsigned n, uint32_t first_seed, struct pad *pads)
+{
+	unsigned i;
+
+	r->n = n;
+	r->nr_groups = 0;
+	r->groups = NULL;
+	r->g = (struct game_context **)calloc(n ? n : 1, sizeof(*r->g));
+	if (!r->g)
+		goto oom;
+	for (i = 0; i < n; i++) {
+		r->g[i] = game_create(first_seed + i);
+		if (!r->g[i])
+			goto oom;
+		game_set_user(r->g[i], &pads[i]);
+		game_select(r->g[i]);
+		set_render(0);
+		setup();
+	}
+	game_select(NULL);
+	return;
+oom:
+	fprintf(stderr, "lockstep: out of memory\n");
+	exit(1);
+}
+
+/* puts the games of r into groups */
+static void
+group(struct run *r)
+{
+	unsigned i, n;
+
+	r->nr_groups = (r->n + GAME_LOCKSTEP_LANES - 1) / GAME_LOCKSTEP_LANES;
+	r->groups = (struct game_lockstep **)calloc(r->nr_groups ? r->nr_groups :
+						    1, sizeof(*r->groups));
+	if (!r->groups)
+		goto oom;
+	for (i = 0; i < r->nr_groups; i++) {
+		n = r->n - i * GAME_LOCKSTEP_LANES;
+		if (n > GAME_LOCKSTEP_LANES)
+			n = GAME_LOCKSTEP_LANES;
+		r->groups[i] = game_lockstep_create(&r->g[i *
+						      GAME_LOCKSTEP_LANES], n);
+		if (!r->groups[i])
+			goto oom;
+	}
+	return;
+oom:
+	fprintf(stderr, "lockstep: out of memory\n");
+	exit(1);
+}
+
+static void
+destroy(struct run *r)
+{
+	unsigned i;
+
+	for (i = 0; i < r->nr_groups; i++)
+		game_lockstep_destroy(r->groups[i]);
+	for (i = 0; i < r->n; i++)
+		game_destroy(r->g[i]);
+	free(r->groups);
+	free(r->g);
+}
+
+/* a loop() of every game, one after the other */
+static void
+step_scalar(struct run *r)
+{
+	unsigned i;
+
+	for (i = 0; i < r->n; i++) {
+		game_select(r->g[i]);
+		loop();
+	}
+	game_select(NULL);
+}
+
+static void
+step_lockstep(struct run *r)
+{
+	unsigned i;
+
+	for (i = 0; i < r->nr_groups; i++)
+		game_lockstep_step(r->groups[i]);
+}
+
+/* the games to draw in this frame are drawn */
+static void
+draw_some(struct run *r)
+{
+	unsigned i;
+
+	for (i = 0; i < r->n; i++) {
+		game_select(r->g[i]);
+		set_render(i % DRAW_GAMES == 0 &&
+			   step % DRAW_PERIOD < DRAW_FRAMES);
+	}
+	game_select(NULL);
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double
+timed(void (*fn)(struct run *), int lockstep, unsigned n,
+      unsigned long frames, uint32_t first_seed, struct pad *pads)
+{
+	struct run r;
+	double start;
+
+	/* setup() reads the buttons too */
+	step = 0;
+	create(&r, n, first_seed, pads);
+	if (lockstep)
+		group(&r);
+	start = now();
+	for (step = 0; step < frames; step++)
+		fn(&r);
+	start = now() - start;
+	destroy(&r);
+	return start;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long frames = 9000;
+	unsigned n = 64, i;
+	uint32_t first_seed = 1;
+	struct run ref, ls;
+	struct game_lockstep_stats st, sum;
+	struct pad *pads;
+	double scalar, lockstep;
+	unsigned long steps;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "g:n:s:")) != -1) {
+		switch (opt) {
+		case 'g':
+			n = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			frames = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			first_seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-g games] [-n frames] "
+				"[-s first seed]\n", argv[0]);
+			return 1;
+		}
+	}
+	pads = (struct pad *)calloc(n ? n : 1, sizeof(*pads));
+	if (!pads)
+		return 1;
+	for (i = 0; i < n; i++)
+		pads[i].index = i;
+
+	step = 0;
+	create(&ref, n, first_seed, pads);
+	create(&ls, n, first_seed, pads);
+	group(&ls);
+	for (step = 0; step < frames; step++) {
+		draw_some(&ref);
+		draw_some(&ls);
+		step_scalar(&ref);
+		step_lockstep(&ls);
+		for (i = 0; i < ls.nr_groups; i++)
+			game_lockstep_sync(ls.groups[i]);
+		for (i = 0; i < n; i++) {
+			if (game_checksum(ref.g[i]) == game_checksum(ls.g[i]))
+				continue;
+			fprintf(stderr, "game %u (seed %u) differs after "
+				"frame %lu\n", i, first_seed + i, step);
+			return 1;
+		}
+	}
+	memset(&sum, 0, sizeof(sum));
+	for (i = 0; i < ls.nr_groups; i++) {
+		game_lockstep_stats(ls.groups[i], &st);
+		sum.in_lanes += st.in_lanes;
+		sum.alone += st.alone;
+		sum.enemies += st.enemies;
+		sum.diverged += st.diverged;
+	}
+	destroy(&ref);
+	destroy(&ls);
+	steps = sum.in_lanes + sum.alone;
+	fprintf(stderr, "%u games the same for %lu frames, %.0f%% of the "
+		"steps in lanes, %.1f%% of %lu enemy updates lane by lane\n",
+		n, frames, steps ? 100.0 * sum.in_lanes / steps : 0,
+		sum.enemies ? 100.0 * sum.diverged / sum.enemies : 0,
+		sum.enemies);
+
+	scalar = timed(step_scalar, 0, n, frames, first_seed, pads);
+	lockstep = timed(step_lockstep, 1, n, frames, first_seed, pads);
+	fprintf(stderr, "loop()   %.3f s, %.0f game frames per second\n",
+		scalar, scalar > 0 ? n * frames / scalar : 0);
+	fprintf(stderr, "lockstep %.3f s, %.0f game frames per second\n",
+		lockstep, lockstep > 0 ? n * frames / lockstep : 0);
+	free(pads);
+	return 0;
+}
@@ -2,9 +2,20 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <time.h>
+
+#include <unistd.h>
 
 #include <ncurses.h>
-#include "VeritazzExtra.h"
+#include "Fatsche.h"
+#include "ssd1306.h"
+#include "term.h"
+#include "export.h"
+#include "rec.h"
+#include "replay.h"
+#include "shm.h"
+#include "output.h"
+#include "input.h"
 
 #define __flag_none                  (0)
 #define __flag_color_invert          (1 << 0)
@@ -14,99 +25,410 @@
 #define __flag_white                 (1 << 4)
 
 static char fb[WIDTH * HEIGHT];
-static uint8_t *sBuffer;
 
+/* the OLED, fed with what the library sends over SPI */
+static struct ssd1306 oled;
+
+/* frames go to -o in the format of -f, -w writes them from a thread */
+static struct exporter *exporter;
+
+/* delta coded recording of -r */
+static struct rec_writer *recording;
+
+/* buttons and checksums of -p, to play the game again */
+static struct replay_writer *replay;
+
+/* frame ring in shared memory named by -m */
+static struct shm_ring *ring;
+static uint8_t buttons;
+
+/* braille cells unless -a asks for a character per pixel */
+static struct term term;
+static int term_mode = TERM_BRAILLE;
+
+/* with -t the terminal is written by a thread of its own */
+static struct output *output;
+
+/* keys from the terminal or the evdev device of -e */
+static struct input *input;
+static unsigned long input_keys;
+static unsigned long long input_latency;	/* key to the frame that sees it */
+static unsigned long input_max;
+
+static unsigned long long
+now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+/* lets the panel catch up with the time that really passed */
 static void
-convert_sbuffer(void)
+advance_oled(void)
 {
-	int i, o, bit, x, y;
-
-	for (i = 0; i < (WIDTH * HEIGHT); i++) {
-		o = i / 8;
-		bit = i % 8;
-		x = o % WIDTH;
-		y = (i / (WIDTH * 8)) * 8 + (i % 8);
-		fb[y * WIDTH + x] = sBuffer[o] & (0x1 << bit)?'+': ' ';
-	}
+	static unsigned long long last;
+	unsigned long long now = now_us();
+
+	if (last)
+		ssd1306_advance(&oled, now - last);
+	last = now;
 }
 
+void
+oled_transfer(const uint8_t *data, uint16_t size, bool command)
+{
+	advance_oled();
+	ssd1306_write(&oled, data, size, command);
+}
 
+/* called by display() once a frame has been sent */
 void
 update_screen(void)
 {
-	int x, y;
-
-	convert_sbuffer();
-	printf("\x1b[%d;%df", 0, 0);
-	for (y = 0; y < HEIGHT; y++) {
-		for (x = 0; x < WIDTH; x++)
-			printf("%c", fb[y * WIDTH + x]);
-		printf("\n\r");
-	}
+}
+
+static void
+convert_gddram(uint8_t *pixels)
+{
+#ifdef ARDUBOY_GRAYSCALE
+	int x, y, level;
+
+	/* the planes change faster than the terminal, show what the eye sees */
+	for (y = 0; y < HEIGHT; y++)
+		for (x = 0; x < WIDTH; x++) {
+			level = ssd1306_level(&oled, x, y);
+			pixels[y * WIDTH + x] = level < 0x20 ? ' ' :
+				level < 0x60 ? '.' : level < 0xa0 ? ':' : '+';
+		}
+	ssd1306_reset_levels(&oled);
+#else
+	/* a dim screen gets lighter characters */
+	char on = oled.contrast >= 0x80 ? '+' : oled.contrast >= 0x20 ? ':' : '.';
+
+	ssd1306_picture(&oled, pixels, ' ', on);
+#endif
+}
+
+static void
+show(const uint8_t *pixels, void *arg)
+{
+	term_frame((struct term *)arg, pixels, ' ');
+}
+
+/* shows what the panel shows, or hands it to the output thread */
+static void
+render(void)
+{
+	uint8_t *pixels = output ? output_back(output) : (uint8_t *)fb;
+
+	advance_oled();
+	convert_gddram(pixels);
+	if (output)
+		output_publish(output);
+	else
+		show(pixels, &term);
 }
 
 static int done = 0;
 
+static struct game_context *game;
+static VeritazzExtra *arduboy;
+
+/* cost of the frames, game logic and rendering */
+static unsigned long frames;
+static unsigned long long frame_us;
+
+/* traffic to the OLED */
+static unsigned long long oled_data, oled_cmds;
+static unsigned long oled_max;
+
+/* SPI clock of the Arduboy, F_CPU / 2 */
+static uint32_t spi_hz = 8000000;
+
+static void
+count_traffic(void)
+{
+	unsigned long bytes = oled.data_bytes + oled.cmd_bytes;
+
+	oled_data += oled.data_bytes;
+	oled_cmds += oled.cmd_bytes;
+	if (bytes > oled_max)
+		oled_max = bytes;
+	oled.data_bytes = 0;
+	oled.cmd_bytes = 0;
+}
+
+static void
+print_stats(void)
+{
+	if (frames)
+		printf("%lu frames, %llu us per frame\n", frames,
+		       frame_us / frames);
+#ifdef ARDUBOY_STRIP_RENDERING
+	printf("strip rendering: %u + %u * %u bytes instead of %u bytes "
+	       "frame buffer\n", WIDTH, DRAW_LIST_SIZE,
+	       (unsigned)sizeof(DrawCommand), WIDTH * HEIGHT / 8);
+	printf("draw list peak %u of %u commands, %u dropped\n",
+	       arduboy->drawListPeak, DRAW_LIST_SIZE,
+	       arduboy->drawListOverflows);
+#endif
+	if (frames) {
+		unsigned long avg = (oled_data + oled_cmds) / frames;
+
+		printf("oled: %llu data + %llu command bytes per frame, "
+		       "max %lu\n", oled_data / frames, oled_cmds / frames,
+		       oled_max);
+		printf("oled: %lu us per frame on the bus at %u Hz, max %lu us\n",
+		       ssd1306_bus_ns(&oled, avg) / 1000, spi_hz,
+		       ssd1306_bus_ns(&oled, oled_max) / 1000);
+	}
+	if (term.frames)
+		printf("terminal: %llu bytes per frame, max %lu\n",
+		       term.bytes / term.frames, term.max_bytes);
+	if (oled.bad_cmds || oled.scroll_writes)
+		printf("oled: %lu unknown commands, %lu writes while scrolling\n",
+		       oled.bad_cmds, oled.scroll_writes);
+#ifdef ARDUBOY_ASYNC_DISPLAY
+	if (frames)
+		printf("async transfer: %llu bytes per frame did not fit "
+		       "the %u byte queue\n",
+		       (unsigned long long)arduboy->syncBytes / frames,
+		       DISPLAY_QUEUE_SIZE);
+#endif
+}
+
+/* buttons of the input keys, in the order of enum input_keys */
+static const uint8_t key_buttons[INPUT_KEYS] = {
+	UP_BUTTON, DOWN_BUTTON, LEFT_BUTTON, RIGHT_BUTTON, A_BUTTON, B_BUTTON,
+};
+
+/* turns the keys read so far into the buttons held in this frame */
 uint8_t
 get_inputs(void)
 {
-	int key;
-	uint8_t keys = 0;
+	struct input_key key;
+	unsigned long long now = now_us();
+	uint8_t pressed = 0, mask;
 
-	do {
-		key = getch();
-		switch (key) {
-		case KEY_UP:
-			keys |= 1;
-			break;
-		case KEY_DOWN:
-			keys |= 2;
-			break;
-		case KEY_LEFT:
-			keys |= 4;
-			break;
-		case KEY_RIGHT:
-			keys |= 8;
-			break;
-		case 'a':
-			keys |= 16;
-			break;
-		case 'b':
-			keys |= 32;
-			break;
-		case 27:
+	while (input_peek(input, &key)) {
+		if (key.key == INPUT_QUIT) {
 			done = 1;
-			break;
+		} else {
+			mask = key_buttons[key.key];
+			/* a tap within a frame is still held for one */
+			if (!key.down && (pressed & mask))
+				break;
+			if (key.down) {
+				buttons |= mask;
+				pressed |= mask;
+			} else {
+				buttons &= ~mask;
+			}
 		}
-	} while (key != ERR);
+		input_pop(input);
 
-	return keys;
+		input_latency += now - key.time_us;
+		if (now - key.time_us > input_max)
+			input_max = now - key.time_us;
+		input_keys++;
+	}
+	return buttons;
 }
 
-extern void setup(void);
-extern void loop(void);
-extern VeritazzExtra arduboy;
 
 int main(int argc, char *argv[])
 {
-	int ret;
-	int c;
-	int key = 0;
+	unsigned long long start;
+	int opt;
+
+	const char *export_path = NULL, *rec_path = NULL, *shm_name = NULL;
+	const char *input_device = NULL, *replay_path = NULL;
+	int export_fmt = EXPORT_PBM, export_thread = 0;
+	struct export_stats export_stats;
+	struct rec_stats rec_stats;
+	struct replay_stats replay_stats;
+	struct output_stats output_stats;
+	struct input_stats input_stats;
+	int threaded = 0;
+	uint32_t seed;
 
-	sBuffer = arduboy.getBuffer();
+	while ((opt = getopt(argc, argv, "ac:e:f:m:o:p:r:tw")) != -1) {
+		switch (opt) {
+		case 'a':
+			term_mode = TERM_ASCII;
+			break;
+		case 'e':
+			input_device = optarg;
+			break;
+		case 'f':
+			export_fmt = export_format(optarg);
+			if (export_fmt < 0) {
+				fprintf(stderr, "formats: pbm y4m raw1 raw8\n");
+				return 1;
+			}
+			break;
+		case 'm':
+			shm_name = optarg;
+			break;
+		case 'o':
+			export_path = optarg;
+			break;
+		case 'p':
+			replay_path = optarg;
+			break;
+		case 'r':
+			rec_path = optarg;
+			break;
+		case 't':
+			threaded = 1;
+			break;
+		case 'w':
+			export_thread = 1;
+			break;
+		case 'c':
+			spi_hz = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-a] [-t] [-e /dev/input/eventN] "
+				"[-c spi_clock_hz] "
+				"[-o file|-|'|command' [-f format] [-w]] [-r file] "
+				"[-p file] [-m /shm_name]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+	ssd1306_reset(&oled, spi_hz);
+	if (export_path) {
+		exporter = export_open(export_path, export_fmt, WIDTH,
+				       HEIGHT / 8, 30, export_thread);
+		if (!exporter)
+			return 1;
+	}
+	if (rec_path) {
+		/* a keyframe every 10 seconds */
+		recording = rec_create(rec_path, WIDTH, HEIGHT / 8, 30, 300);
+		if (!recording)
+			return 1;
+	}
+	if (shm_name) {
+		ring = shm_publish_open(shm_name, WIDTH, HEIGHT / 8);
+		if (!ring)
+			return 1;
+	}
+	if (term_init(&term, STDOUT_FILENO, term_mode, WIDTH, HEIGHT) < 0) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	if (threaded) {
+		output = output_start(WIDTH * HEIGHT, show, &term);
+		if (!output)
+			return 1;
+	}
 
 	initscr();
+	cbreak();
+	noecho();
 	clear();
-	nodelay(stdscr, TRUE);
-	keypad(stdscr, TRUE);
+	curs_set(0);
+	/* curses must not clear the screen again behind term's back */
+	refresh();
+	input = input_start(input_device);
+	if (!input) {
+		endwin();
+		return 1;
+	}
 
 	memset(fb, ' ', sizeof(fb));
-	update_screen();
+	render();
+	/* a different game every time, like the noise of the ADC */
+	seed = time(NULL);
+	game = game_create(seed);
+	if (!game) {
+		endwin();
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	arduboy = game_arduboy(game);
+	game_select(game);
 	setup();
+	if (replay_path) {
+		/* a keyframe every 10 seconds */
+		replay = replay_create(replay_path, game, seed, 300);
+		if (!replay) {
+			endwin();
+			return 1;
+		}
+	}
+	/* the boot commands are not part of any frame */
+	oled.data_bytes = 0;
+	oled.cmd_bytes = 0;
 	do {
+		start = now_us();
 		loop();
+		/* post_render is set while a frame has been drawn */
+		if (arduboy->post_render) {
+			frame_us += now_us() - start;
+			frames++;
+			count_traffic();
+			render();
+			if (exporter)
+				export_frame(exporter, oled.gddram);
+			if (recording)
+				rec_frame(recording, oled.gddram);
+			if (replay)
+				replay_frame(replay, game, buttons);
+			if (ring)
+				shm_publish(ring, frames, buttons, now_us(),
+					    oled.gddram);
+		}
 	} while (!done);
+	input_stop(input, &input_stats);
+	if (output) {
+		output_stop(output, &output_stats);
+		output = NULL;
+	}
 	clrtoeol();
 	endwin();
+	print_stats();
+	if (input_keys)
+		printf("input: %lu keys, %llu us until a frame saw them, "
+		       "max %lu us, %lu lost\n", input_keys,
+		       input_latency / input_keys, input_max,
+		       input_stats.overflows);
+	if (threaded && output_stats.shown)
+		printf("output thread: %lu of %lu frames shown, %lu dropped, "
+		       "%llu us in the queue, max %lu us\n", output_stats.shown,
+		       output_stats.published, output_stats.dropped,
+		       output_stats.latency_us / output_stats.shown,
+		       output_stats.max_latency_us);
+	if (exporter) {
+		if (export_close(exporter, &export_stats) < 0)
+			fprintf(stderr, "export to %s failed\n", export_path);
+		printf("export: %lu frames, %llu bytes, %lu frames waited "
+		       "%llu us for the writer\n", export_stats.frames,
+		       export_stats.bytes, export_stats.stalls,
+		       export_stats.stall_us);
+	}
+	if (ring)
+		shm_publish_close(ring, shm_name);
+	if (recording) {
+		if (rec_close(recording, &rec_stats) < 0)
+			fprintf(stderr, "recording to %s failed\n", rec_path);
+		if (rec_stats.frames)
+			printf("recording: %lu frames, %llu bytes, "
+			       "%llu per minute instead of %llu raw\n",
+			       rec_stats.frames, rec_stats.bytes,
+			       rec_stats.bytes * 30 * 60 / rec_stats.frames,
+			       rec_stats.raw_bytes * 30 * 60 / rec_stats.frames);
+	}
+	if (replay) {
+		if (replay_close(replay, &replay_stats) < 0)
+			fprintf(stderr, "replay to %s failed\n", replay_path);
+		printf("replay: %lu frames, %lu runs of buttons, %llu bytes\n",
+		       replay_stats.frames, replay_stats.runs,
+		       replay_stats.bytes);
+	}
 	return 0;
 }
@@ -0,0 +1,19 @@
+/*
+ * What the headless tools share: the virtual clock of ArduboyCoreVeritazz.h
+ * and no screen.  Each tool brings its own get_inputs(), one that keeps an
+ * emulated OLED its own oled_transfer().
+ */
+#include <stdint.h>
+
+__thread unsigned long host_millis;
+
+/* the bytes for the OLED go nowhere, unless the tool has one */
+__attribute__((weak)) void
+oled_transfer(const uint8_t *data, uint16_t size, bool command)
+{
+}
+
+void
+update_screen(void)
+{
+}
@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "output.h"
+
+/* the middle buffer index and whether it holds an unseen frame */
+#define OUTPUT_INDEX		3
+#define OUTPUT_FRESH		4
+
+struct output {
+	uint8_t *buffer[3];
+	unsigned long long time_us[3];	/* when each was published */
+	int back;			/* owned by the game */
+	int front;			/* owned by the output thread */
+	int middle;			/* swapped by both */
+
+	output_show show;
+	void *arg;
+	pthread_t thread;
+	sem_t wake;
+	int stopping;
+
+	/* published and dropped are counted by the game, the rest by the thread */
+	struct output_stats stats;
+};
+
+static unsigned long long
+now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static void *
+run(void *arg)
+{
+	struct output *o = (struct output *)arg;
+	unsigned long latency;
+	int middle, stop;
+
+	for (;;) {
+		while (sem_wait(&o->wake) < 0)
+			;
+		/* read first, so the last frame is seen before stopping */
+		stop = __atomic_load_n(&o->stopping, __ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&o->middle, __ATOMIC_ACQUIRE) & OUTPUT_FRESH) {
+			middle = __atomic_exchange_n(&o->middle, o->front,
+						     __ATOMIC_ACQ_REL);
+			o->front = middle & OUTPUT_INDEX;
+
+			latency = now_us() - o->time_us[o->front];
+			o->stats.latency_us += latency;
+			if (latency > o->stats.max_latency_us)
+				o->stats.max_latency_us = latency;
+			o->stats.shown++;
+			o->show(o->buffer[o->front], o->arg);
+		}
+		if (stop)
+			break;
+	}
+	return NULL;
+}
+
+struct output *
+output_start(size_t size, output_show show, void *arg)
+{
+	struct output *o;
+	int i;
+
+	o = (struct output *)calloc(1, sizeof(*o));
+	if (!o)
+		return NULL;
+	for (i = 0; i < 3; i++) {
+		o->buffer[i] = (uint8_t *)calloc(1, size);
+		if (!o->buffer[i])
+			goto fail;
+	}
+	o->back = 0;
+	o->middle = 1;
+	o->front = 2;
+	o->show = show;
+	o->arg = arg;
+	sem_init(&o->wake, 0, 0);
+	if (pthread_create(&o->thread, NULL, run, o)) {
+		fprintf(stderr, "output: no thread\n");
+		sem_destroy(&o->wake);
+		goto fail;
+	}
+	return o;
+
+fail:
+	for (i = 0; i < 3; i++)
+		free(o->buffer[i]);
+	free(o);
+	return NULL;
+}
+
+uint8_t *
+output_back(struct output *o)
+{
+	return o->buffer[o->back];
+}
+
+void
+output_publish(struct output *o)
+{
+	int middle;
+
+	o->time_us[o->back] = now_us();
+	middle = __atomic_exchange_n(&o->middle, o->back | OUTPUT_FRESH,
+				     __ATOMIC_ACQ_REL);
+	o->back = middle & OUTPUT_INDEX;
+	if (middle & OUTPUT_FRESH)
+		o->stats.dropped++;
+	o->stats.published++;
+	sem_post(&o->wake);
+}
+
+void
+output_stop(struct output *o, struct output_stats *stats)
+{
+	int i;
+
+	__atomic_store_n(&o->stopping, 1, __ATOMIC_RELEASE);
+	sem_post(&o->wake);
+	pthread_join(o->thread, NULL);
+	sem_destroy(&o->wake);
+
+	if (stats)
+		*stats = o->stats;
+	for (i = 0; i < 3; i++)
+		free(o->buffer[i]);
+	free(o);
+}
@@ -0,0 +1,42 @@
+/*
+ * Hands finished frames to an output thread through a triple buffer.
+ *
+ * The game fills the back buffer and publishes it, which swaps it with the
+ * middle buffer and never waits.  The output thread swaps the middle buffer
+ * with its front buffer when there is a fresh one and shows it.  If the
+ * output is slower than the game, a frame in the middle buffer is replaced
+ * before it is picked up; those frames are counted as dropped and the
+ * output always shows the newest one.
+ */
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+struct output;
+
+/* called from the output thread for every frame it picks up */
+typedef void (*output_show)(const uint8_t *frame, void *arg);
+
+/* starts the thread for frames of size bytes, NULL on errors */
+struct output *output_start(size_t size, output_show show, void *arg);
+
+/* the buffer to fill for the next frame, it changes with every publish */
+uint8_t *output_back(struct output *o);
+
+/* hands the back buffer to the output thread, never blocks */
+void output_publish(struct output *o);
+
+struct output_stats {
+	unsigned long published;
+	unsigned long shown;
+	unsigned long dropped;		/* replaced before they were shown */
+	unsigned long long latency_us;	/* publish to pick up, all frames */
+	unsigned long max_latency_us;
+};
+
+/* shows the last frame, stops the thread and fills in stats if not NULL */
+void output_stop(struct output *o, struct output_stats *stats);
+
+#endif
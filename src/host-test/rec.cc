@@ -0,0 +1,381 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "rec.h"
+
+#define REC_HEADER		16
+#define REC_TRAILER		16
+#define REC_BUFFER		(256 * 1024)
+
+struct rec_writer {
+	FILE *file;
+	int width, pages, interval;
+	uint8_t *prev;
+	uint8_t *delta;			/* one page */
+	uint8_t *coded;			/* one record */
+	uint64_t *offsets;
+	unsigned long alloced;
+	struct rec_stats stats;
+};
+
+static void
+put16(uint8_t *p, uint16_t v)
+{
+	p[0] = v;
+	p[1] = v >> 8;
+}
+
+static void
+put32(uint8_t *p, uint32_t v)
+{
+	put16(p, v);
+	put16(p + 2, v >> 16);
+}
+
+static void
+put64(uint8_t *p, uint64_t v)
+{
+	put32(p, v);
+	put32(p + 4, v >> 32);
+}
+
+static uint16_t
+get16(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static uint32_t
+get32(const uint8_t *p)
+{
+	return get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+static uint64_t
+get64(const uint8_t *p)
+{
+	return get32(p) | ((uint64_t)get32(p + 4) << 32);
+}
+
+struct rec_writer *
+rec_create(const char *path, int width, int pages, int fps, int interval)
+{
+	struct rec_writer *w;
+	uint8_t header[REC_HEADER];
+
+	w = (struct rec_writer *)calloc(1, sizeof(*w));
+	if (!w)
+		return NULL;
+	w->width = width;
+	w->pages = pages;
+	w->interval = interval > 0 ? interval : 1;
+	w->prev = (uint8_t *)calloc(width, pages);
+	w->delta = (uint8_t *)malloc(width);
+	/* worst case a literal token for every 128 bytes */
+	w->coded = (uint8_t *)malloc(1 + pages * (width + width / 128 + 1));
+	w->file = fopen(path, "wb");
+	if (!w->prev || !w->delta || !w->coded || !w->file) {
+		if (!w->file)
+			perror(path);
+		rec_close(w, NULL);
+		return NULL;
+	}
+	setvbuf(w->file, NULL, _IOFBF, REC_BUFFER);
+
+	memcpy(header, "FREC", 4);
+	put16(header + 4, REC_VERSION);
+	put16(header + 6, width);
+	put16(header + 8, pages);
+	put16(header + 10, fps);
+	put16(header + 12, w->interval);
+	put16(header + 14, 0);
+	fwrite(header, 1, sizeof(header), w->file);
+	w->stats.bytes = sizeof(header);
+	return w;
+}
+
+/* run-length codes n bytes, returns the coded size */
+static size_t
+code_page(uint8_t *out, const uint8_t *b, int n)
+{
+	uint8_t *start = out;
+	int i = 0, j;
+
+	while (i < n) {
+		j = i;
+		if (!b[i]) {
+			while (j < n && j - i < 128 && !b[j])
+				j++;
+			*out++ = j - i - 1;
+		} else {
+			/* a single zero is cheaper as a literal */
+			while (j < n && j - i < 128 &&
+			       (b[j] || (j + 1 < n && b[j + 1])))
+				j++;
+			*out++ = 0x80 + j - i - 1;
+			memcpy(out, b + i, j - i);
+			out += j - i;
+		}
+		i = j;
+	}
+	return out - start;
+}
+
+void
+rec_frame(struct rec_writer *w, const uint8_t *frame)
+{
+	uint8_t *p = w->coded, *prev;
+	const uint8_t *src;
+	int key, page, x;
+
+	if (w->stats.frames == w->alloced) {
+		w->alloced = w->alloced ? w->alloced * 2 : 1024;
+		w->offsets = (uint64_t *)realloc(w->offsets,
+						 w->alloced * sizeof(uint64_t));
+	}
+	w->offsets[w->stats.frames] = w->stats.bytes;
+
+	key = w->stats.frames % w->interval == 0;
+	*p++ = key ? REC_KEY : REC_DELTA;
+	for (page = 0; page < w->pages; page++) {
+		src = frame + page * w->width;
+		prev = w->prev + page * w->width;
+		if (key) {
+			p += code_page(p, src, w->width);
+			continue;
+		}
+		for (x = 0; x < w->width; x++)
+			w->delta[x] = src[x] ^ prev[x];
+		p += code_page(p, w->delta, w->width);
+	}
+	memcpy(w->prev, frame, w->width * w->pages);
+
+	fwrite(w->coded, 1, p - w->coded, w->file);
+	w->stats.bytes += p - w->coded;
+	w->stats.raw_bytes += w->width * w->pages;
+	w->stats.keyframes += key;
+	w->stats.frames++;
+}
+
+int
+rec_close(struct rec_writer *w, struct rec_stats *stats)
+{
+	uint8_t b[REC_TRAILER];
+	unsigned long i;
+	int failed = 0;
+
+	if (w->file) {
+		for (i = 0; i < w->stats.frames; i++) {
+			put64(b, w->offsets[i]);
+			fwrite(b, 1, 8, w->file);
+		}
+		put64(b, w->stats.bytes);
+		put32(b + 8, w->stats.frames);
+		memcpy(b + 12, "FIDX", 4);
+		fwrite(b, 1, REC_TRAILER, w->file);
+		w->stats.bytes += w->stats.frames * 8 + REC_TRAILER;
+		if (ferror(w->file) | fclose(w->file))
+			failed = 1;
+	}
+	if (stats)
+		*stats = w->stats;
+	free(w->prev);
+	free(w->delta);
+	free(w->coded);
+	free(w->offsets);
+	free(w);
+	return failed ? -1 : 0;
+}
+
+/*
+ * Applies a coded page to out, or only checks it with out NULL.  Returns the
+ * bytes of p used, 0 if it is broken.
+ */
+static size_t
+decode_page(uint8_t *out, const uint8_t *p, size_t size, int n)
+{
+	size_t used = 0;
+	int i = 0, run, k;
+
+	while (i < n) {
+		if (used >= size)
+			return 0;
+		run = (p[used] & 0x7f) + 1;
+		if (i + run > n)
+			return 0;
+		if (!(p[used++] & 0x80)) {
+			i += run;
+			continue;
+		}
+		if (used + run > size)
+			return 0;
+		if (out)
+			for (k = 0; k < run; k++)
+				out[i + k] ^= p[used + k];
+		used += run;
+		i += run;
+	}
+	return used;
+}
+
+/* applies the record at offset, returns its size or 0 if broken */
+static size_t
+decode_record(const struct rec_reader *r, uint64_t offset, uint8_t *frame)
+{
+	const uint8_t *p = r->data + offset;
+	size_t size = r->size - offset, used = 1, n;
+	int page;
+
+	if (offset >= r->size || (p[0] != REC_KEY && p[0] != REC_DELTA))
+		return 0;
+	if (frame && p[0] == REC_KEY)
+		memset(frame, 0, r->width * r->pages);
+	for (page = 0; page < r->pages; page++) {
+		n = decode_page(frame ? frame + page * r->width : NULL,
+				p + used, size - used, r->width);
+		if (!n)
+			return 0;
+		used += n;
+	}
+	return used;
+}
+
+/* finds the records without an index */
+static int
+scan(struct rec_reader *r)
+{
+	uint64_t offset = REC_HEADER;
+	unsigned long alloced = 0;
+	size_t n;
+
+	r->frames = 0;
+	while ((n = decode_record(r, offset, NULL))) {
+		if (r->frames == alloced) {
+			alloced = alloced ? alloced * 2 : 1024;
+			r->offsets = (uint64_t *)realloc(r->offsets,
+							 alloced * sizeof(uint64_t));
+			if (!r->offsets)
+				return -1;
+		}
+		r->offsets[r->frames++] = offset;
+		offset += n;
+	}
+	return 0;
+}
+
+int
+rec_open(struct rec_reader *r, const char *path)
+{
+	const uint8_t *t;
+	struct stat st;
+	uint64_t index;
+	unsigned long i;
+	int fd;
+
+	memset(r, 0, sizeof(*r));
+	r->current = -1;
+	fd = open(path, O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) < 0) {
+		perror(path);
+		if (fd >= 0)
+			close(fd);
+		return -1;
+	}
+	r->size = st.st_size;
+	if (r->size < REC_HEADER) {
+		fprintf(stderr, "%s: too short\n", path);
+		close(fd);
+		return -1;
+	}
+	r->data = (const uint8_t *)mmap(NULL, r->size, PROT_READ, MAP_PRIVATE,
+				      fd, 0);
+	close(fd);
+	if (r->data == MAP_FAILED) {
+		perror(path);
+		r->data = NULL;
+		return -1;
+	}
+	if (memcmp(r->data, "FREC", 4) || get16(r->data + 4) != REC_VERSION) {
+		fprintf(stderr, "%s: not a recording\n", path);
+		rec_release(r);
+		return -1;
+	}
+	r->width = get16(r->data + 6);
+	r->pages = get16(r->data + 8);
+	r->fps = get16(r->data + 10);
+	r->interval = get16(r->data + 12);
+	r->frame = (uint8_t *)malloc(r->width * r->pages);
+	if (!r->frame) {
+		rec_release(r);
+		return -1;
+	}
+
+	if (r->size >= REC_HEADER + REC_TRAILER &&
+	    !memcmp(r->data + r->size - 4, "FIDX", 4)) {
+		t = r->data + r->size - REC_TRAILER;
+		index = get64(t);
+		r->frames = get32(t + 8);
+		if (index + r->frames * 8 + REC_TRAILER == r->size) {
+			r->offsets = (uint64_t *)malloc(r->frames * sizeof(uint64_t) + 1);
+			if (!r->offsets) {
+				rec_release(r);
+				return -1;
+			}
+			for (i = 0; i < r->frames; i++) {
+				r->offsets[i] = get64(r->data + index + i * 8);
+				if (r->offsets[i] < REC_HEADER ||
+				    r->offsets[i] >= index)
+					break;
+			}
+			if (i == r->frames)
+				return 0;
+			free(r->offsets);
+			r->offsets = NULL;
+		}
+	}
+	/* not closed properly */
+	if (scan(r) < 0) {
+		rec_release(r);
+		return -1;
+	}
+	return 0;
+}
+
+void
+rec_release(struct rec_reader *r)
+{
+	if (r->data)
+		munmap((void *)r->data, r->size);
+	free(r->offsets);
+	free(r->frame);
+	memset(r, 0, sizeof(*r));
+}
+
+const uint8_t *
+rec_read(struct rec_reader *r, unsigned long nr)
+{
+	unsigned long key;
+
+	if (nr >= r->frames)
+		return NULL;
+	/* the keyframe at or before nr */
+	for (key = nr; key > 0; key--)
+		if (r->data[r->offsets[key]] == REC_KEY)
+			break;
+	/* reading forward from the last frame is cheaper */
+	if (r->current >= (long)key && r->current <= (long)nr)
+		key = r->current + 1;
+	for (; key <= nr; key++) {
+		if (!decode_record(r, r->offsets[key], r->frame)) {
+			r->current = -1;
+			return NULL;
+		}
+		r->current = key;
+	}
+	return r->frame;
+}
@@ -0,0 +1,71 @@
+/*
+ * Recording format for the frames of long host runs.
+ *
+ * A file starts with a header, followed by one record per frame and ends
+ * with an index of the record offsets.
+ *
+ *   header   "FREC", version, width, pages, fps, keyframe interval
+ *   record   type (REC_KEY or REC_DELTA), then every page run-length coded
+ *   index    uint64 offset of every record
+ *   trailer  uint64 index offset, uint32 frames, "FIDX"
+ *
+ * A keyframe codes the frame itself, a delta the XOR with the frame
+ * before, so unchanged bytes are zero.  Pages are coded as tokens:
+ *
+ *   0x00 - 0x7f   n + 1 zero bytes
+ *   0x80 - 0xff   n - 0x7f literal bytes follow
+ *
+ * so an unchanged page takes one byte.  Every interval frames is a keyframe
+ * and the index gives the offset of any frame, so seeking decodes at most
+ * interval frames.  Without the index, e.g. after a crash, the reader scans
+ * the records instead.  All numbers are little endian.
+ */
+#ifndef REC_H
+#define REC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define REC_VERSION		1
+#define REC_KEY			'K'
+#define REC_DELTA		'D'
+
+struct rec_writer;
+
+/* returns NULL on errors */
+struct rec_writer *rec_create(const char *path, int width, int pages,
+			      int fps, int interval);
+
+/* appends a frame of pages * width page-format bytes */
+void rec_frame(struct rec_writer *w, const uint8_t *frame);
+
+struct rec_stats {
+	unsigned long frames;
+	unsigned long keyframes;
+	unsigned long long bytes;	/* whole file */
+	unsigned long long raw_bytes;	/* the frames uncoded */
+};
+
+/* writes the index, closes and fills in stats if not NULL */
+int rec_close(struct rec_writer *w, struct rec_stats *stats);
+
+struct rec_reader {
+	const uint8_t *data;
+	size_t size;
+	int width, pages, fps, interval;
+	unsigned long frames;
+	uint64_t *offsets;		/* of every record */
+
+	/* the last decoded frame, for reading in order */
+	uint8_t *frame;
+	long current;
+};
+
+/* maps path, returns -1 on errors */
+int rec_open(struct rec_reader *r, const char *path);
+void rec_release(struct rec_reader *r);
+
+/* decodes frame nr, the result stays valid until the next call */
+const uint8_t *rec_read(struct rec_reader *r, unsigned long nr);
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Shows what is in a frame recording of the host build.
+ *
+ *   rectool file            sizes and compression
+ *   rectool file frame      draws a frame
+ *   rectool -s file         times reading in order and seeking
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "rec.h"
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void
+info(const struct rec_reader *r)
+{
+	unsigned long keys = 0, i;
+	double minutes = r->fps ? r->frames / (r->fps * 60.0) : 0;
+	unsigned long long raw = (unsigned long long)r->frames * r->width *
+		r->pages;
+
+	for (i = 0; i < r->frames; i++)
+		keys += r->data[r->offsets[i]] == REC_KEY;
+	printf("%dx%d at %d fps, %lu frames, %lu keyframes every %d\n",
+	       r->width, r->pages * 8, r->fps, r->frames, keys, r->interval);
+	printf("%zu bytes, %.1f per frame, %.1f%% of %llu raw bytes\n",
+	       r->size, r->frames ? (double)r->size / r->frames : 0,
+	       raw ? r->size * 100.0 / raw : 0, raw);
+	if (minutes > 0)
+		printf("%.1f KB per minute, raw %.1f KB per minute\n",
+		       r->size / minutes / 1024, raw / minutes / 1024);
+}
+
+static void
+draw(const struct rec_reader *r, const uint8_t *frame)
+{
+	int x, y;
+
+	for (y = 0; y < r->pages * 8; y++) {
+		for (x = 0; x < r->width; x++)
+			putchar((frame[(y / 8) * r->width + x] >> (y % 8)) & 1 ?
+				'#' : ' ');
+		putchar('\n');
+	}
+}
+
+static int
+speed(struct rec_reader *r)
+{
+	unsigned long i, n = r->frames;
+	double t;
+
+	if (!n)
+		return 0;
+	t = now();
+	for (i = 0; i < n; i++)
+		if (!rec_read(r, i))
+			return 1;
+	printf("in order: %.2f us per frame\n", (now() - t) * 1e6 / n);
+
+	srand(1);
+	t = now();
+	for (i = 0; i < n; i++)
+		if (!rec_read(r, rand() % n))
+			return 1;
+	printf("seeking:  %.2f us per frame\n", (now() - t) * 1e6 / n);
+	return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+	struct rec_reader r;
+	const uint8_t *frame;
+	int opt, timing = 0, ret = 0;
+
+	while ((opt = getopt(argc, argv, "s")) != -1) {
+		switch (opt) {
+		case 's':
+			timing = 1;
+			break;
+		default:
+			goto usage;
+		}
+	}
+	if (optind >= argc)
+		goto usage;
+	if (rec_open(&r, argv[optind]) < 0)
+		return 1;
+
+	if (timing) {
+		ret = speed(&r);
+	} else if (optind + 1 < argc) {
+		frame = rec_read(&r, strtoul(argv[optind + 1], NULL, 0));
+		if (frame)
+			draw(&r, frame);
+		else
+			ret = 1;
+	} else {
+		info(&r);
+	}
+	if (ret)
+		fprintf(stderr, "%s: broken recording\n", argv[optind]);
+	rec_release(&r);
+	return ret;
+
+usage:
+	fprintf(stderr, "usage: %s [-s] file [frame]\n", argv[0]);
+	return 1;
+}
@@ -0,0 +1,436 @@
+/*
+ * Golden frame hashes of recorded sessions, to catch any change of pixels.
+ *
+ * regress/corpus lists the sessions, each a window of frames of a script
+ * played from a seed:
+ *
+ *   # name  script  seed  first frame  frames
+ *   menu    menu    1     0            600
+ *
+ * A session plays regress/<script>.script on the virtual clock, without
+ * drawing up to its first frame, then hashes the screen buffer after every
+ * frame and compares it with the line of regress/<name>.golden for it.  The
+ * first frame that differs is shown next to the one expected and written
+ * to regress/<name>.diff.pbm as expected, actual and their difference.
+ * Goldens only hold hashes.  Every run that matches keeps the frames of a
+ * session in regress/<name>.frec, and when that does not hold the frame
+ * expected, a reference build plays the session again to write it: -r
+ * names its host_regress, make regress builds the one of the commit that
+ * last changed the goldens.
+ *
+ *   regress [-u] [-d dir] [-r reference] [session...]
+ *
+ * -u writes the goldens of the sessions anew, after a change of the
+ * pixels that was meant.  Scripts are described in script.h, replays of
+ * -p turn into scripts with host_replay -s.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Fatsche.h"
+#include "rec.h"
+#include "script.h"
+
+#define FRAME_BYTES		(WIDTH * HEIGHT / 8)
+
+struct session {
+	char name[32];
+	char script[32];
+	uint32_t seed;
+	unsigned long first, nr;
+};
+
+static uint8_t buttons;
+
+/* host_regress of a build that matches the goldens, NULL if none */
+static const char *reference;
+
+uint8_t
+get_inputs(void)
+{
+	return buttons;
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t
+frame_hash(const uint8_t *data)
+{
+	uint64_t h = 0xcbf29ce484222325ULL;
+	size_t i;
+
+	for (i = 0; i < FRAME_BYTES; i++)
+		h = (h ^ data[i]) * 0x100000001b3ULL;
+	return h;
+}
+
+static int
+pixel(const uint8_t *frame, int x, int y)
+{
+	return (frame[(y / 8) * WIDTH + x] >> (y & 7)) & 1;
+}
+
+/* a row of 2x4 pixel braille cells */
+static void
+braille_row(const uint8_t *frame, int row)
+{
+	static const uint8_t dots[4][2] = {
+		{ 0x01, 0x08 }, { 0x02, 0x10 }, { 0x04, 0x20 }, { 0x40, 0x80 },
+	};
+	uint8_t bits;
+	int x, dy;
+
+	for (x = 0; x < WIDTH; x += 2) {
+		bits = 0;
+		for (dy = 0; dy < 4; dy++) {
+			if (pixel(frame, x, row * 4 + dy))
+				bits |= dots[dy][0];
+			if (pixel(frame, x + 1, row * 4 + dy))
+				bits |= dots[dy][1];
+		}
+		printf("%c%c%c", 0xe2, 0xa0 | (bits >> 6), 0x80 | (bits & 0x3f));
+	}
+}
+
+/* expected, actual and what differs side by side */
+static void
+write_diff(const char *path, const uint8_t *expected, const uint8_t *actual)
+{
+	const uint8_t *panels[2] = { expected, actual };
+	FILE *f = fopen(path, "wb");
+	int width = WIDTH * 3 + 16, x, y, p, px, bit;
+	uint8_t byte;
+
+	if (!f) {
+		perror(path);
+		return;
+	}
+	fprintf(f, "P4\n%d %d\n", width, HEIGHT);
+	for (y = 0; y < HEIGHT; y++) {
+		byte = 0;
+		bit = 7;
+		for (x = 0; x < width; x++) {
+			p = x / (WIDTH + 8);
+			px = x % (WIDTH + 8);
+			/* a bar between the panels */
+			if (px >= WIDTH)
+				byte |= px < WIDTH + 4 ? 0 : 1 << bit;
+			else if (p < 2 && panels[p])
+				byte |= pixel(panels[p], px, y) << bit;
+			else if (p == 2 && expected)
+				byte |= (pixel(expected, px, y) ^
+					 pixel(actual, px, y)) << bit;
+			if (bit-- == 0 || x == width - 1) {
+				fputc(byte, f);
+				byte = 0;
+				bit = 7;
+			}
+		}
+	}
+	fclose(f);
+}
+
+/* frame nr of the frames kept of a session, if it is the golden one */
+static int
+kept_frame(const char *dir, const struct session *s, unsigned long nr,
+	   uint64_t golden, uint8_t *expected)
+{
+	char path[256];
+	struct rec_reader r;
+	const uint8_t *kept = NULL;
+
+	snprintf(path, sizeof(path), "%s/%s.frec", dir, s->name);
+	if (access(path, R_OK) || rec_open(&r, path))
+		return -1;
+	if (r.frames == s->nr)
+		kept = rec_read(&r, nr - s->first);
+	if (kept && frame_hash(kept) == golden)
+		memcpy(expected, kept, FRAME_BYTES);
+	else
+		kept = NULL;
+	rec_release(&r);
+	return kept ? 0 : -1;
+}
+
+/* the reference build plays the session, it keeps the frames if they match */
+static int
+replay_reference(const char *dir, const struct session *s)
+{
+	char cmd[768];
+
+	if (!reference || access(reference, X_OK))
+		return -1;
+	printf("%s: playing the session with %s\n", s->name, reference);
+	fflush(stdout);
+	snprintf(cmd, sizeof(cmd), "'%s' -d '%s' '%s' > /dev/null", reference,
+		 dir, s->name);
+	return system(cmd) ? -1 : 0;
+}
+
+static void
+report(const char *dir, const struct session *s, unsigned long nr,
+       const uint8_t *actual, uint64_t hash, uint64_t golden)
+{
+	char path[256];
+	uint8_t expected[FRAME_BYTES];
+	int x, y, x0 = WIDTH, y0 = HEIGHT, x1 = -1, y1 = -1, n = 0, row;
+
+	printf("%s: frame %lu differs, %016llx instead of %016llx\n", s->name,
+	       nr, (unsigned long long)hash, (unsigned long long)golden);
+
+	if (kept_frame(dir, s, nr, golden, expected) < 0 &&
+	    (replay_reference(dir, s) < 0 ||
+	     kept_frame(dir, s, nr, golden, expected) < 0)) {
+		printf("%s: no frame to compare with, make regress builds a "
+		       "reference of the commit of the goldens\n", s->name);
+		for (row = 0; row < HEIGHT / 4; row++) {
+			braille_row(actual, row);
+			printf("\n");
+		}
+		return;
+	}
+
+	for (y = 0; y < HEIGHT; y++)
+		for (x = 0; x < WIDTH; x++) {
+			if (pixel(expected, x, y) == pixel(actual, x, y))
+				continue;
+			n++;
+			x0 = x < x0 ? x : x0;
+			x1 = x > x1 ? x : x1;
+			y0 = y < y0 ? y : y0;
+			y1 = y > y1 ? y : y1;
+		}
+	printf("%s: %d pixels differ in %d,%d - %d,%d\n", s->name, n, x0, y0,
+	       x1, y1);
+	printf("%-64s   %s\n", "expected", "actual");
+	for (row = 0; row < HEIGHT / 4; row++) {
+		braille_row(expected, row);
+		printf(" %c ", row * 4 <= y1 && row * 4 + 3 >= y0 ? '>' : '|');
+		braille_row(actual, row);
+		printf("\n");
+	}
+	snprintf(path, sizeof(path), "%s/%s.diff.pbm", dir, s->name);
+	write_diff(path, expected, actual);
+	printf("%s: written to %s\n", s->name, path);
+}
+
+static int
+load_golden(const char *path, uint64_t *hashes, unsigned long nr)
+{
+	FILE *f = fopen(path, "r");
+	char line[64];
+	unsigned long n = 0;
+	unsigned long long h;
+
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+	while (fgets(line, sizeof(line), f)) {
+		if (line[0] == '#')
+			continue;
+		if (sscanf(line, "%llx", &h) != 1 || n == nr) {
+			fprintf(stderr, "%s:%lu: expected %lu hashes\n", path,
+				n + 1, nr);
+			fclose(f);
+			return -1;
+		}
+		hashes[n++] = h;
+	}
+	fclose(f);
+	if (n == nr)
+		return 0;
+	fprintf(stderr, "%s: %lu hashes, not %lu\n", path, n, nr);
+	return -1;
+}
+
+static int
+write_golden(const char *path, const struct session *s,
+	     const uint64_t *hashes)
+{
+	FILE *f = fopen(path, "w");
+	unsigned long i;
+
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+	fprintf(f, "# %s: %s.script with seed %u, frames %lu - %lu\n",
+		s->name, s->script, s->seed, s->first, s->first + s->nr - 1);
+	for (i = 0; i < s->nr; i++)
+		fprintf(f, "%016llx\n", (unsigned long long)hashes[i]);
+	if (ferror(f) | fclose(f)) {
+		fprintf(stderr, "%s: write failed\n", path);
+		return -1;
+	}
+	return 0;
+}
+
+/* plays a session, returns -1 if it differs or fails */
+static int
+run(const char *dir, const struct session *s, int update)
+{
+	char path[256], kept[256];
+	struct script script;
+	unsigned long cursor = 0, nr, last = s->first + s->nr;
+	uint64_t *hashes, hash;
+	struct game_context *g;
+	VeritazzExtra *arduboy;
+	struct rec_writer *rec;
+	int err = 0;
+
+	snprintf(path, sizeof(path), "%s/%s.script", dir, s->script);
+	if (script_load(&script, path) < 0)
+		return -1;
+	hashes = (uint64_t *)calloc(s->nr ? s->nr : 1, sizeof(*hashes));
+	g = game_create(s->seed);
+	if (!hashes || !g) {
+		fprintf(stderr, "regress: out of memory\n");
+		exit(1);
+	}
+	snprintf(path, sizeof(path), "%s/%s.golden", dir, s->name);
+	if (!update && load_golden(path, hashes, s->nr) < 0) {
+		err = -1;
+		goto out;
+	}
+	/* kept for the next run that differs, if this one matches */
+	snprintf(kept, sizeof(kept), "%s/%s.frec.tmp", dir, s->name);
+	rec = rec_create(kept, WIDTH, HEIGHT / 8, 30, 300);
+
+	arduboy = game_arduboy(g);
+	game_select(g);
+	set_render(0);
+	buttons = script_buttons(&script, &cursor, 0, 0);
+	setup();
+	for (nr = 0; nr < last; nr++) {
+		/* the first frame drawn is drawn whole */
+		set_render(nr >= s->first);
+		buttons = script_buttons(&script, &cursor, nr, buttons);
+		do
+			loop();
+		while (!arduboy->post_render);
+		if (nr < s->first)
+			continue;
+		if (rec)
+			rec_frame(rec, arduboy->getBuffer());
+		hash = frame_hash(arduboy->getBuffer());
+		if (update) {
+			hashes[nr - s->first] = hash;
+		} else if (hash != hashes[nr - s->first]) {
+			/* out of the way of a reference that keeps its own */
+			if (rec)
+				rec_close(rec, NULL);
+			rec = NULL;
+			unlink(kept);
+			report(dir, s, nr, arduboy->getBuffer(), hash,
+			       hashes[nr - s->first]);
+			err = -1;
+			break;
+		}
+	}
+	game_select(NULL);
+
+	if (!err && update)
+		err = write_golden(path, s, hashes);
+	if (rec && !rec_close(rec, NULL) && !err) {
+		snprintf(path, sizeof(path), "%s/%s.frec", dir, s->name);
+		rename(kept, path);
+	} else if (rec) {
+		unlink(kept);
+	}
+out:
+	game_destroy(g);
+	free(hashes);
+	script_free(&script);
+	return err;
+}
+
+static int
+selected(const struct session *s, int argc, char *argv[])
+{
+	int i;
+
+	if (!argc)
+		return 1;
+	for (i = 0; i < argc; i++)
+		if (!strcmp(argv[i], s->name))
+			return 1;
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *dir = "regress";
+	char path[256], line[256];
+	struct session s;
+	unsigned long lines = 0, frames = 0;
+	int update = 0, opt, n, ran = 0, failed = 0;
+	double start, t;
+	FILE *corpus;
+
+	while ((opt = getopt(argc, argv, "d:r:u")) != -1) {
+		switch (opt) {
+		case 'd':
+			dir = optarg;
+			break;
+		case 'r':
+			reference = optarg;
+			break;
+		case 'u':
+			update = 1;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-u] [-d dir] "
+				"[-r reference] [session...]\n", argv[0]);
+			return 1;
+		}
+	}
+	snprintf(path, sizeof(path), "%s/corpus", dir);
+	corpus = fopen(path, "r");
+	if (!corpus) {
+		perror(path);
+		return 1;
+	}
+
+	start = now();
+	while (fgets(line, sizeof(line), corpus)) {
+		lines++;
+		n = sscanf(line, "%31s %31s %u %lu %lu", s.name, s.script,
+			   &s.seed, &s.first, &s.nr);
+		if (n <= 0 || s.name[0] == '#')
+			continue;
+		if (n != 5) {
+			fprintf(stderr, "%s:%lu: expected a name, a script, "
+				"the seed, the first frame and frames\n",
+				path, lines);
+			return 1;
+		}
+		if (!selected(&s, argc - optind, argv + optind))
+			continue;
+		t = now();
+		if (run(dir, &s, update) < 0) {
+			failed++;
+			continue;
+		}
+		ran++;
+		frames += s.first + s.nr;
+		printf("%-10s %6lu frames from %6lu %s in %.3f s\n", s.name,
+		       s.nr, s.first, update ? "written" : "match",
+		       now() - t);
+	}
+	fclose(corpus);
+	printf("%d sessions %s, %d failed, %lu frames played in %.3f s\n",
+	       ran, update ? "written" : "match", failed, frames,
+	       now() - start);
+	return failed ? 1 : 0;
+}
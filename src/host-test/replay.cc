@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "replay.h"
+
+#define REPLAY_HEADER		16
+#define REPLAY_BLOCK		9	/* before the snapshot */
+#define REPLAY_RUN		3
+
+struct replay_writer {
+	FILE *file;
+	unsigned interval;
+	struct game_snapshot key;	/* before the frames of the block */
+	unsigned long first;
+	unsigned nr;			/* frames in the block */
+	uint8_t *runs;
+	unsigned nr_runs;
+	uint8_t *checksums;
+	struct replay_stats stats;
+};
+
+static void
+put16(uint8_t *p, uint16_t v)
+{
+	p[0] = v;
+	p[1] = v >> 8;
+}
+
+static void
+put32(uint8_t *p, uint32_t v)
+{
+	put16(p, v);
+	put16(p + 2, v >> 16);
+}
+
+static uint16_t
+get16(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static uint32_t
+get32(const uint8_t *p)
+{
+	return get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+struct replay_writer *
+replay_create(const char *path, struct game_context *g, uint32_t seed,
+	      unsigned interval)
+{
+	struct replay_writer *w;
+	uint8_t header[REPLAY_HEADER];
+
+	w = (struct replay_writer *)calloc(1, sizeof(*w));
+	if (!w)
+		return NULL;
+	w->interval = interval < 1 ? 1 : interval > 0xffff ? 0xffff : interval;
+	/* at worst a run for every frame */
+	w->runs = (uint8_t *)malloc(w->interval * REPLAY_RUN);
+	w->checksums = (uint8_t *)malloc(w->interval * 4);
+	w->file = fopen(path, "wb");
+	if (!w->runs || !w->checksums || !w->file) {
+		if (!w->file)
+			perror(path);
+		replay_close(w, NULL);
+		return NULL;
+	}
+
+	memcpy(header, "FRPL", 4);
+	put16(header + 4, REPLAY_VERSION);
+	put32(header + 6, seed);
+	put16(header + 10, w->interval);
+	put16(header + 12, GAME_SNAPSHOT_SIZE);
+	put16(header + 14, 0);
+	fwrite(header, 1, sizeof(header), w->file);
+	w->stats.bytes = sizeof(header);
+	game_snapshot(g, &w->key);
+	return w;
+}
+
+static void
+write_block(struct replay_writer *w)
+{
+	uint8_t b[REPLAY_BLOCK];
+
+	b[0] = REPLAY_KEY;
+	put32(b + 1, w->first);
+	put16(b + 5, w->nr);
+	put16(b + 7, w->nr_runs);
+	fwrite(b, 1, sizeof(b), w->file);
+	fwrite(&w->key, 1, sizeof(w->key), w->file);
+	fwrite(w->runs, REPLAY_RUN, w->nr_runs, w->file);
+	fwrite(w->checksums, 4, w->nr, w->file);
+	/* what is written survives a crash of the game */
+	fflush(w->file);
+
+	w->stats.bytes += sizeof(b) + sizeof(w->key) +
+		w->nr_runs * REPLAY_RUN + w->nr * 4;
+	w->stats.keyframes++;
+	w->stats.runs += w->nr_runs;
+	w->first += w->nr;
+	w->nr = 0;
+	w->nr_runs = 0;
+}
+
+void
+replay_frame(struct replay_writer *w, struct game_context *g, uint8_t buttons)
+{
+	uint8_t *run = w->runs + w->nr_runs * REPLAY_RUN;
+
+	if (w->nr_runs && run[-REPLAY_RUN] == buttons) {
+		run -= REPLAY_RUN;
+		put16(run + 1, get16(run + 1) + 1);
+	} else {
+		run[0] = buttons;
+		put16(run + 1, 1);
+		w->nr_runs++;
+	}
+	put32(w->checksums + w->nr * 4, game_checksum(g));
+	w->stats.frames++;
+	if (++w->nr < w->interval)
+		return;
+	write_block(w);
+	game_snapshot(g, &w->key);
+}
+
+int
+replay_close(struct replay_writer *w, struct replay_stats *stats)
+{
+	int failed = 0;
+
+	if (w->file) {
+		if (w->nr || !w->stats.keyframes)
+			write_block(w);
+		if (ferror(w->file) | fclose(w->file))
+			failed = 1;
+	}
+	if (stats)
+		*stats = w->stats;
+	free(w->runs);
+	free(w->checksums);
+	free(w);
+	return failed ? -1 : 0;
+}
+
+static void *
+grow(void *p, unsigned long nr, size_t size)
+{
+	void *q = realloc(p, nr * size);
+
+	if (!q)
+		free(p);
+	return q;
+}
+
+/* adds the block at p, returns its size, 0 if broken, -1 out of memory */
+static long
+load_block(struct replay *r, const uint8_t *p, size_t size)
+{
+	unsigned long first, nr, nr_runs, i, len, f;
+	size_t used;
+
+	if (size < REPLAY_BLOCK || p[0] != REPLAY_KEY)
+		return 0;
+	first = get32(p + 1);
+	nr = get16(p + 5);
+	nr_runs = get16(p + 7);
+	used = REPLAY_BLOCK + sizeof(struct game_snapshot) +
+		nr_runs * REPLAY_RUN + nr * 4;
+	if (first != r->frames || nr > r->interval || used > size)
+		return 0;
+
+	r->keys = (struct game_snapshot *)grow(r->keys, r->nr_keys + 1,
+					       sizeof(*r->keys));
+	r->buttons = (uint8_t *)grow(r->buttons, first + nr + 1, 1);
+	r->checksums = (uint32_t *)grow(r->checksums, first + nr + 1, 4);
+	if (!r->keys || !r->buttons || !r->checksums)
+		return -1;
+	memcpy(&r->keys[r->nr_keys], p + REPLAY_BLOCK, sizeof(*r->keys));
+	p += REPLAY_BLOCK + sizeof(*r->keys);
+
+	f = first;
+	for (i = 0; i < nr_runs; i++, p += REPLAY_RUN) {
+		len = get16(p + 1);
+		if (f + len > first + nr)
+			return 0;
+		memset(r->buttons + f, p[0], len);
+		f += len;
+	}
+	if (f != first + nr)
+		return 0;
+	for (i = 0; i < nr; i++, p += 4)
+		r->checksums[first + i] = get32(p);
+	r->nr_keys++;
+	r->frames += nr;
+	r->stats.runs += nr_runs;
+	return used;
+}
+
+int
+replay_load(struct replay *r, const char *path)
+{
+	FILE *f = fopen(path, "rb");
+	uint8_t *data = NULL;
+	size_t size = 0, alloced = 0, n, used;
+	long block;
+
+	memset(r, 0, sizeof(*r));
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+	do {
+		if (size == alloced) {
+			alloced = alloced ? alloced * 2 : 64 * 1024;
+			data = (uint8_t *)grow(data, alloced, 1);
+			if (!data) {
+				fclose(f);
+				fprintf(stderr, "%s: out of memory\n", path);
+				return -1;
+			}
+		}
+		n = fread(data + size, 1, alloced - size, f);
+		size += n;
+	} while (n);
+	fclose(f);
+
+	if (size < REPLAY_HEADER || memcmp(data, "FRPL", 4) ||
+	    get16(data + 4) != REPLAY_VERSION) {
+		fprintf(stderr, "%s: not a replay of version %d\n", path,
+			REPLAY_VERSION);
+		goto fail;
+	}
+	if (get16(data + 12) != GAME_SNAPSHOT_SIZE) {
+		fprintf(stderr, "%s: snapshots of %u bytes, not %u\n", path,
+			get16(data + 12), GAME_SNAPSHOT_SIZE);
+		goto fail;
+	}
+	r->seed = get32(data + 6);
+	r->interval = get16(data + 10);
+	r->stats.bytes = size;
+	for (used = REPLAY_HEADER; used < size; used += block) {
+		block = load_block(r, data + used, size - used);
+		if (block < 0) {
+			fprintf(stderr, "%s: out of memory\n", path);
+			goto fail;
+		}
+		if (!block)
+			break;
+	}
+	if (!r->nr_keys || !r->buttons) {
+		fprintf(stderr, "%s: no frames\n", path);
+		goto fail;
+	}
+	/* e.g. the game crashed while writing the last block */
+	if (used < size)
+		fprintf(stderr, "%s: broken after frame %lu, the rest is "
+			"left out\n", path, r->frames);
+	r->stats.frames = r->frames;
+	r->stats.keyframes = r->nr_keys;
+	free(data);
+	return 0;
+
+fail:
+	free(data);
+	replay_free(r);
+	return -1;
+}
+
+void
+replay_free(struct replay *r)
+{
+	free(r->buttons);
+	free(r->checksums);
+	free(r->keys);
+	memset(r, 0, sizeof(*r));
+}
@@ -0,0 +1,68 @@
+/*
+ * Replay files of the buttons of a game, to play it again exactly.
+ *
+ * A game only depends on its seed and the buttons of every frame, so that
+ * is what a replay keeps, with a snapshot of the whole game every interval
+ * frames to start from anywhere and the checksum of every frame to find
+ * where a replay goes its own way.
+ *
+ *   header   "FRPL", version, seed, keyframe interval, snapshot size
+ *   block    REPLAY_KEY, first frame, frames, runs, the snapshot taken
+ *            before the first frame, the runs of buttons, the checksums
+ *
+ * A block holds interval frames, the last one fewer.  A run is the buttons
+ * and the frames they are held, 1 - 65535.  The checksums are the low 32
+ * bits of game_checksum() after each frame.  Blocks are written once they
+ * are full, so a run that crashes loses at most the frames of the last
+ * one.  All numbers are little endian, apart from those in the snapshots.
+ *
+ * A snapshot is the struct game_snapshot as game_snapshot() leaves it in
+ * memory, in the byte order and layout of the build.  Snapshots are only
+ * valid for builds of the same source on the same kind of machine.
+ */
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+
+#include "Fatsche.h"
+
+#define REPLAY_VERSION		1
+#define REPLAY_KEY		'K'
+
+struct replay_writer;
+
+/* starts with a snapshot of g as it is, returns NULL on errors */
+struct replay_writer *replay_create(const char *path, struct game_context *g,
+				    uint32_t seed, unsigned interval);
+
+/* appends the frame g just played with buttons */
+void replay_frame(struct replay_writer *w, struct game_context *g,
+		  uint8_t buttons);
+
+struct replay_stats {
+	unsigned long frames;
+	unsigned long keyframes;
+	unsigned long runs;
+	unsigned long long bytes;
+};
+
+/* writes the last block, closes and fills in stats if not NULL */
+int replay_close(struct replay_writer *w, struct replay_stats *stats);
+
+struct replay {
+	uint32_t seed;
+	unsigned interval;
+	unsigned long frames;
+	uint8_t *buttons;		/* of every frame */
+	uint32_t *checksums;		/* after every frame */
+	struct game_snapshot *keys;	/* before every interval frames */
+	unsigned long nr_keys;
+	struct replay_stats stats;
+};
+
+/* reads path, returns -1 after printing an error */
+int replay_load(struct replay *r, const char *path);
+void replay_free(struct replay *r);
+
+#endif
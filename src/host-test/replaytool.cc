@@ -0,0 +1,222 @@
+/*
+ * Plays a replay file again, headless and as fast as it goes.
+ *
+ * Every frame is checked against the checksum recorded for it and every
+ * keyframe against the game at that point; the first frame that differs
+ * stops the replay with an error.  With -f the replay starts from the last
+ * keyframe before the frame and stops after it, -o exports the screen of
+ * that frame.  -s prints the buttons as a script instead, e.g. to add a
+ * session to the regression corpus.  Replays are described in replay.h
+ * and recorded by the -p option of host_test and host_headless.
+ *
+ *   replay [-f frame [-o file [-t format]]] [-s] file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Fatsche.h"
+#include "export.h"
+#include "replay.h"
+
+static uint8_t buttons;
+
+uint8_t
+get_inputs(void)
+{
+	return buttons;
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* a loop() that finishes a frame, which not every one does */
+static void
+frame(VeritazzExtra *arduboy)
+{
+	do
+		loop();
+	while (!arduboy->post_render);
+}
+
+/* the checksum of a keyframe, as the game restored from it has it */
+static uint32_t
+key_checksum(const struct game_snapshot *key)
+{
+	struct game_context *g = game_create(1);
+	uint32_t sum;
+
+	if (!g || game_restore(g, key) < 0) {
+		fprintf(stderr, "replay: a keyframe of a different build\n");
+		exit(1);
+	}
+	sum = game_checksum(g);
+	game_destroy(g);
+	return sum;
+}
+
+/* the buttons of every frame as a script, see script.h */
+static void
+print_script(const struct replay *r)
+{
+	static const char names[] = "udlrab";
+	static const uint8_t masks[] = {
+		UP_BUTTON, DOWN_BUTTON, LEFT_BUTTON, RIGHT_BUTTON, A_BUTTON,
+		B_BUTTON,
+	};
+	unsigned long nr;
+	int i;
+
+	printf("# seed %u\n", r->seed);
+	for (nr = 0; nr < r->frames; nr++) {
+		if (nr && r->buttons[nr] == r->buttons[nr - 1])
+			continue;
+		printf("%lu\t", nr);
+		for (i = 0; i < 6; i++)
+			if (r->buttons[nr] & masks[i])
+				putchar(names[i]);
+		printf("%s\n", r->buttons[nr] ? "" : "-");
+	}
+}
+
+/* starts a game like the recording did and checks it against the replay */
+static void
+check_seed(const struct replay *r)
+{
+	struct game_context *g = game_create(r->seed);
+
+	if (!g)
+		exit(1);
+	game_select(g);
+	set_render(0);
+	buttons = 0;
+	setup();
+	game_select(NULL);
+	if ((uint32_t)game_checksum(g) != key_checksum(&r->keys[0]))
+		fprintf(stderr, "replay: seed %u starts another game than the "
+			"recording, going on from its first keyframe\n",
+			r->seed);
+	game_destroy(g);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *export_path = NULL;
+	int export_fmt = EXPORT_PBM, opt;
+	unsigned long seek = 0, first, last, nr;
+	int seeking = 0, script = 0;
+	struct exporter *exporter;
+	struct replay r;
+	struct game_context *g;
+	VeritazzExtra *arduboy;
+	uint32_t sum;
+	double start, secs;
+
+	while ((opt = getopt(argc, argv, "f:o:st:")) != -1) {
+		switch (opt) {
+		case 'f':
+			seek = strtoul(optarg, NULL, 0);
+			seeking = 1;
+			break;
+		case 'o':
+			export_path = optarg;
+			break;
+		case 's':
+			script = 1;
+			break;
+		case 't':
+			export_fmt = export_format(optarg);
+			if (export_fmt < 0) {
+				fprintf(stderr, "formats: pbm y4m raw1 raw8\n");
+				return 1;
+			}
+			break;
+		default:
+			goto usage;
+		}
+	}
+	if (optind + 1 != argc || (export_path && !seeking))
+		goto usage;
+	if (replay_load(&r, argv[optind]) < 0)
+		return 1;
+	if (script) {
+		print_script(&r);
+		replay_free(&r);
+		return 0;
+	}
+	fprintf(stderr, "seed %u, %lu frames, %lu keyframes every %u, %lu "
+		"runs of buttons, %llu bytes\n", r.seed, r.frames, r.nr_keys,
+		r.interval, r.stats.runs, r.stats.bytes);
+	if (seeking && seek >= r.frames) {
+		fprintf(stderr, "replay: frame %lu is past the end\n", seek);
+		return 1;
+	}
+	last = seeking ? seek + 1 : r.frames;
+	first = seeking ? seek / r.interval * r.interval : 0;
+	if (!first)
+		check_seed(&r);
+
+	g = game_create(r.seed);
+	if (!g || game_restore(g, &r.keys[first / r.interval]) < 0) {
+		fprintf(stderr, "replay: a keyframe of a different build\n");
+		return 1;
+	}
+	arduboy = game_arduboy(g);
+	game_select(g);
+	set_render(0);
+
+	start = now();
+	for (nr = first; nr < last; nr++) {
+		if (nr % r.interval == 0 &&
+		    (uint32_t)game_checksum(g) !=
+		    key_checksum(&r.keys[nr / r.interval])) {
+			fprintf(stderr, "replay: keyframe before frame %lu "
+				"differs from the game played up to it\n", nr);
+			return 1;
+		}
+		/* the frame sought is drawn, whole */
+		set_render(seeking && nr + 1 == last);
+		buttons = r.buttons[nr];
+		frame(arduboy);
+		sum = game_checksum(g);
+		if (sum == r.checksums[nr])
+			continue;
+		fprintf(stderr, "replay: frame %lu differs, checksum %08x "
+			"instead of %08x, %lu frames after the keyframe at "
+			"%lu\n", nr, sum, r.checksums[nr], nr % r.interval,
+			nr / r.interval * r.interval);
+		return 1;
+	}
+	secs = now() - start;
+	fprintf(stderr, "frames %lu - %lu the same in %.3f s, %.0f frames per "
+		"second\n", first, last - 1, secs,
+		secs > 0 ? (last - first) / secs : 0);
+
+	if (export_path) {
+		exporter = export_open(export_path, export_fmt, WIDTH,
+				       HEIGHT / 8, 30, 0);
+		if (!exporter)
+			return 1;
+		export_frame(exporter, arduboy->getBuffer());
+		if (export_close(exporter, NULL) < 0) {
+			fprintf(stderr, "export to %s failed\n", export_path);
+			return 1;
+		}
+	}
+	game_destroy(g);
+	replay_free(&r);
+	return 0;
+
+usage:
+	fprintf(stderr, "usage: %s [-f frame [-o file|-|'|command' "
+		"[-t format]]] [-s] file\n", argv[0]);
+	return 1;
+}
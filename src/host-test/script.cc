@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ArduboyCoreVeritazz.h"
+#include "script.h"
+
+int
+script_parse_buttons(const char *str, uint8_t *buttons)
+{
+	uint8_t b = 0;
+
+	if (!strcmp(str, "-")) {
+		*buttons = 0;
+		return 0;
+	}
+	for (; *str; str++) {
+		switch (*str) {
+		case 'u':
+			b |= UP_BUTTON;
+			break;
+		case 'd':
+			b |= DOWN_BUTTON;
+			break;
+		case 'l':
+			b |= LEFT_BUTTON;
+			break;
+		case 'r':
+			b |= RIGHT_BUTTON;
+			break;
+		case 'a':
+			b |= A_BUTTON;
+			break;
+		case 'b':
+			b |= B_BUTTON;
+			break;
+		default:
+			return -1;
+		}
+	}
+	*buttons = b;
+	return 0;
+}
+
+int
+script_load(struct script *s, const char *path)
+{
+	FILE *f = strcmp(path, "-") ? fopen(path, "r") : stdin;
+	char line[256], keys[64];
+	unsigned long alloced = 0, nr = 0, frame;
+	struct script_line *l;
+	int n;
+
+	s->lines = NULL;
+	s->nr = 0;
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+	while (fgets(line, sizeof(line), f)) {
+		nr++;
+		n = sscanf(line, "%lu %63s", &frame, keys);
+		if (line[strspn(line, " \t")] == '#' || n <= 0)
+			continue;
+		if (s->nr == alloced) {
+			alloced = alloced ? alloced * 2 : 256;
+			l = (struct script_line *)realloc(s->lines,
+					alloced * sizeof(*l));
+			if (!l) {
+				fprintf(stderr, "%s: out of memory\n", path);
+				goto fail;
+			}
+			s->lines = l;
+		}
+		if (n != 2 ||
+		    script_parse_buttons(keys, &s->lines[s->nr].buttons) < 0 ||
+		    (s->nr && frame < s->lines[s->nr - 1].frame)) {
+			fprintf(stderr, "%s:%lu: expected a frame, not before "
+				"the last, and buttons of udlrab or -\n",
+				path, nr);
+			goto fail;
+		}
+		s->lines[s->nr++].frame = frame;
+	}
+	if (f != stdin)
+		fclose(f);
+	return 0;
+
+fail:
+	if (f != stdin)
+		fclose(f);
+	script_free(s);
+	return -1;
+}
+
+void
+script_free(struct script *s)
+{
+	free(s->lines);
+	s->lines = NULL;
+	s->nr = 0;
+}
+
+uint8_t
+script_buttons(const struct script *s, unsigned long *cursor,
+	       unsigned long frame, uint8_t held)
+{
+	while (*cursor < s->nr && s->lines[*cursor].frame <= frame)
+		held = s->lines[(*cursor)++].buttons;
+	return held;
+}
@@ -0,0 +1,46 @@
+/*
+ * Button scripts for the simulations of the host build.
+ *
+ * A script has a line for every change of the buttons held:
+ *
+ *   # frame  buttons (of udlrab, - for none)
+ *   0        -
+ *   120      a
+ *   122      -
+ *   300      ra
+ *
+ * A loaded script is only read, so many games may play it at once, each
+ * with a cursor of its own.
+ */
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include <stdint.h>
+
+/* the buttons held from a frame on */
+struct script_line {
+	unsigned long frame;
+	uint8_t buttons;
+};
+
+struct script {
+	struct script_line *lines;
+	unsigned long nr;
+};
+
+/* reads path, "-" for stdin, returns -1 after printing an error */
+int script_load(struct script *s, const char *path);
+
+void script_free(struct script *s);
+
+/*
+ * the buttons held at frame, which must not go back.  cursor starts at 0,
+ * held with the buttons before the first line.
+ */
+uint8_t script_buttons(const struct script *s, unsigned long *cursor,
+		       unsigned long frame, uint8_t held);
+
+/* the buttons of udlrab in str or "-", returns -1 on others */
+int script_parse_buttons(const char *str, uint8_t *buttons);
+
+#endif
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "shm.h"
+
+struct shm_ring *
+shm_publish_open(const char *name, int width, int pages)
+{
+	struct shm_ring *r;
+	int fd;
+
+	if (width * pages > SHM_FRAME_SIZE)
+		return NULL;
+	fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		perror(name);
+		return NULL;
+	}
+	if (ftruncate(fd, sizeof(*r)) < 0) {
+		perror(name);
+		close(fd);
+		return NULL;
+	}
+	r = (struct shm_ring *)mmap(NULL, sizeof(*r), PROT_READ | PROT_WRITE,
+				    MAP_SHARED, fd, 0);
+	close(fd);
+	if (r == MAP_FAILED) {
+		perror(name);
+		return NULL;
+	}
+
+	/* readers of an old run see the magic vanish first */
+	__atomic_store_n(&r->magic, 0, __ATOMIC_RELEASE);
+	memset((char *)r + sizeof(r->magic), 0, sizeof(*r) - sizeof(r->magic));
+	r->version = SHM_VERSION;
+	r->width = width;
+	r->pages = pages;
+	r->slots = SHM_SLOTS;
+	__atomic_store_n(&r->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+	return r;
+}
+
+void
+shm_publish(struct shm_ring *r, uint64_t frame, uint32_t buttons,
+	    uint64_t time_us, const uint8_t *data)
+{
+	uint64_t nr = r->published;
+	struct shm_slot *slot = &r->slot[nr % SHM_SLOTS];
+	uint32_t seq = slot->seq;
+
+	__atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+	/* readers must not see the new data with the old counter */
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	slot->frame = frame;
+	slot->buttons = buttons;
+	slot->time_us = time_us;
+	memcpy(slot->data, data, r->width * r->pages);
+	__atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
+	__atomic_store_n(&r->published, nr + 1, __ATOMIC_RELEASE);
+}
+
+void
+shm_publish_close(struct shm_ring *r, const char *name)
+{
+	munmap(r, sizeof(*r));
+	shm_unlink(name);
+}
+
+const struct shm_ring *
+shm_attach(const char *name)
+{
+	const struct shm_ring *r;
+	struct stat st;
+	int fd;
+
+	fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0) {
+		perror(name);
+		return NULL;
+	}
+	if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(*r)) {
+		fprintf(stderr, "%s: not a frame ring\n", name);
+		close(fd);
+		return NULL;
+	}
+	r = (const struct shm_ring *)mmap(NULL, sizeof(*r), PROT_READ,
+					  MAP_SHARED, fd, 0);
+	close(fd);
+	if (r == MAP_FAILED) {
+		perror(name);
+		return NULL;
+	}
+	if (__atomic_load_n(&r->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC ||
+	    r->version != SHM_VERSION || r->slots != SHM_SLOTS) {
+		fprintf(stderr, "%s: not a frame ring\n", name);
+		shm_detach(r);
+		return NULL;
+	}
+	return r;
+}
+
+void
+shm_detach(const struct shm_ring *r)
+{
+	munmap((void *)r, sizeof(*r));
+}
+
+uint64_t
+shm_published(const struct shm_ring *r)
+{
+	return __atomic_load_n(&r->published, __ATOMIC_ACQUIRE);
+}
+
+int
+shm_read(const struct shm_ring *r, uint64_t nr, struct shm_slot *out)
+{
+	const struct shm_slot *slot = &r->slot[nr % SHM_SLOTS];
+	/* the counter once frame nr is complete */
+	uint32_t want = (nr / SHM_SLOTS + 1) * 2, seq;
+	int spins = 0;
+
+	for (;;) {
+		seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+		if (seq == want - 1) {
+			/* being written right now, unless the game died */
+			if (++spins == 100000)
+				return -1;
+			continue;
+		}
+		if (seq != want)
+			return -1;
+		memcpy(out, slot, sizeof(*out));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq)
+			return 0;
+	}
+}
@@ -0,0 +1,64 @@
+/*
+ * Publishes the frames of a running host instance in POSIX shared memory.
+ *
+ * The segment holds a header and a ring of slots.  Each slot has a frame
+ * number, the buttons and the frame in page format.  There is exactly one
+ * writer, the game, and it never waits: every slot is guarded by a
+ * sequence counter that is odd while the slot is written (a seqlock).  A
+ * reader copies a slot and checks the counter before and after.  If the
+ * counter changed, the copy is torn and the reader tries again.  As slot
+ * n % SHM_SLOTS is written for the published frames n, n + SHM_SLOTS and
+ * so on, its counter also tells which of them it holds.  Readers
+ * that fall more than a ring behind lose frames, the game never notices.
+ */
+#ifndef SHM_H
+#define SHM_H
+
+#include <stdint.h>
+
+#define SHM_MAGIC		0x4d485346	/* "FSHM" */
+#define SHM_VERSION		1
+#define SHM_SLOTS		16
+#define SHM_FRAME_SIZE		1024
+
+struct shm_slot {
+	uint32_t seq;			/* odd while written */
+	uint32_t buttons;
+	uint64_t frame;			/* frame number */
+	uint64_t time_us;		/* CLOCK_MONOTONIC */
+	uint8_t data[SHM_FRAME_SIZE];
+};
+
+struct shm_ring {
+	uint32_t magic;
+	uint32_t version;
+	uint16_t width, pages;
+	uint32_t slots;
+	uint64_t published;		/* frames written so far */
+	struct shm_slot slot[SHM_SLOTS];
+};
+
+/* creates or reuses the segment name, e.g. "/fatsche", NULL on errors */
+struct shm_ring *shm_publish_open(const char *name, int width, int pages);
+
+/* publishes a frame, never blocks */
+void shm_publish(struct shm_ring *r, uint64_t frame, uint32_t buttons,
+		 uint64_t time_us, const uint8_t *data);
+
+/* unmaps and removes the segment */
+void shm_publish_close(struct shm_ring *r, const char *name);
+
+/* maps an existing segment read-only, NULL on errors */
+const struct shm_ring *shm_attach(const char *name);
+void shm_detach(const struct shm_ring *r);
+
+/* frames published so far */
+uint64_t shm_published(const struct shm_ring *r);
+
+/*
+ * copies frame number nr into out, returns 0 on success, -1 if it is no
+ * longer in the ring or not yet published
+ */
+int shm_read(const struct shm_ring *r, uint64_t nr, struct shm_slot *out);
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Reference reader of the frame ring a host instance publishes with -m.
+ *
+ *   shmview [-d] [-n frames] name
+ *
+ * follows the ring and prints a line per second with the frame rate and
+ * the frames it missed.  -d draws the frames as braille instead, -n stops
+ * after that many frames.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "shm.h"
+#include "fbconv.h"
+#include "term.h"
+
+static uint64_t
+now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+int
+main(int argc, char *argv[])
+{
+	const struct shm_ring *r;
+	struct shm_slot slot;
+	struct term term;
+	static uint8_t pixels[SHM_FRAME_SIZE * 8];
+	uint64_t next, published, seen = 0, missed = 0, limit = 0;
+	uint64_t last_print, last_seen = 0;
+	int opt, draw = 0;
+
+	while ((opt = getopt(argc, argv, "dn:")) != -1) {
+		switch (opt) {
+		case 'd':
+			draw = 1;
+			break;
+		case 'n':
+			limit = strtoull(optarg, NULL, 0);
+			break;
+		default:
+			goto usage;
+		}
+	}
+	if (optind >= argc)
+		goto usage;
+	r = shm_attach(argv[optind]);
+	if (!r)
+		return 1;
+	if (draw && term_init(&term, STDOUT_FILENO, TERM_BRAILLE, r->width,
+			      r->pages * 8) < 0)
+		return 1;
+	if (draw)
+		printf("\x1b[2J");
+
+	next = shm_published(r);
+	last_print = now_us();
+	while (!limit || seen < limit) {
+		published = shm_published(r);
+		if (next == published) {
+			usleep(2000);
+			continue;
+		}
+		/* too slow, skip to the oldest frame still there */
+		if (published - next > SHM_SLOTS) {
+			missed += published - next - SHM_SLOTS;
+			next = published - SHM_SLOTS;
+		}
+		if (shm_read(r, next, &slot) < 0) {
+			missed++;
+			next++;
+			continue;
+		}
+		next++;
+		seen++;
+
+		if (draw) {
+			fbconv_linear8(pixels, slot.data, r->width, r->pages,
+				       0, 1);
+			term_frame(&term, pixels, 0);
+			printf("\x1b[%d;1Hframe %llu buttons 0x%02x\x1b[K",
+			       r->pages * 2 + 1, (unsigned long long)slot.frame,
+			       slot.buttons);
+			fflush(stdout);
+		} else if (now_us() - last_print >= 1000000) {
+			printf("frame %llu, %llu fps, buttons 0x%02x, "
+			       "%llu missed\n", (unsigned long long)slot.frame,
+			       (unsigned long long)(seen - last_seen),
+			       slot.buttons, (unsigned long long)missed);
+			last_seen = seen;
+			last_print = now_us();
+		}
+	}
+	printf("%llu frames, %llu missed\n", (unsigned long long)seen,
+	       (unsigned long long)missed);
+	shm_detach(r);
+	return 0;
+
+usage:
+	fprintf(stderr, "usage: %s [-d] [-n frames] name\n", argv[0]);
+	return 1;
+}
@@ -0,0 +1,312 @@
+#include <string.h>
+
+#include "ssd1306.h"
+#include "fbconv.h"
+
+/* panel frames per scroll step for the interval codes of 0x26/0x27 */
+static const uint16_t scroll_intervals[8] = {
+	5, 64, 128, 256, 3, 4, 25, 2,
+};
+
+void
+ssd1306_reset(struct ssd1306 *d, uint32_t spi_hz)
+{
+	memset(d, 0, sizeof(*d));
+	d->mode = SSD1306_PAGE;
+	d->col1 = SSD1306_WIDTH - 1;
+	d->page1 = SSD1306_PAGES - 1;
+	d->contrast = 0x7f;
+	d->spi_hz = spi_hz;
+}
+
+/* number of argument bytes following a command */
+static int
+cmd_args(uint8_t c)
+{
+	switch (c) {
+	case 0x20:	/* addressing mode */
+	case 0x81:	/* contrast */
+	case 0x8d:	/* charge pump */
+	case 0xa8:	/* multiplex ratio */
+	case 0xd3:	/* display offset */
+	case 0xd5:	/* clock divide */
+	case 0xd9:	/* pre-charge */
+	case 0xda:	/* COM pins */
+	case 0xdb:	/* VCOMH */
+		return 1;
+	case 0x21:	/* column address */
+	case 0x22:	/* page address */
+	case 0xa3:	/* vertical scroll area */
+		return 2;
+	case 0x29:	/* vertical and horizontal scroll */
+	case 0x2a:
+		return 5;
+	case 0x26:	/* horizontal scroll */
+	case 0x27:
+		return 6;
+	}
+	return 0;
+}
+
+static void
+run_cmd(struct ssd1306 *d)
+{
+	uint8_t *a = d->cmd;
+
+	if (a[0] < 0x10) {
+		/* lower column start, page mode */
+		d->col = (d->col & 0xf0) | a[0];
+		return;
+	}
+	if (a[0] < 0x20) {
+		d->col = (d->col & 0x0f) | ((a[0] & 0x0f) << 4);
+		return;
+	}
+	if (a[0] >= 0x40 && a[0] < 0x80) {
+		d->start_line = a[0] & 0x3f;
+		return;
+	}
+	if (a[0] >= 0xb0 && a[0] < 0xb8) {
+		d->page = a[0] & 0x07;
+		return;
+	}
+
+	switch (a[0]) {
+	case 0x20:
+		d->mode = a[1] & 3;
+		break;
+	case 0x21:
+		d->col0 = d->col = a[1] & 0x7f;
+		d->col1 = a[2] & 0x7f;
+		break;
+	case 0x22:
+		d->page0 = d->page = a[1] & 0x07;
+		d->page1 = a[2] & 0x07;
+		break;
+	case 0x26:
+	case 0x27:
+		d->scroll_left = a[0] == 0x27;
+		d->scroll_page0 = a[2] & 0x07;
+		d->scroll_interval = scroll_intervals[a[3] & 0x07];
+		d->scroll_page1 = a[4] & 0x07;
+		break;
+	case 0x2e:
+		d->scrolling = 0;
+		break;
+	case 0x2f:
+		d->scrolling = 1;
+		d->scroll_frames = 0;
+		break;
+	case 0x81:
+		d->contrast = a[1];
+		break;
+	case 0xa0:
+	case 0xa1:
+		d->seg_remap = a[0] & 1;
+		break;
+	case 0xa4:
+	case 0xa5:
+		d->all_on = a[0] & 1;
+		break;
+	case 0xa6:
+	case 0xa7:
+		d->inverted = a[0] & 1;
+		break;
+	case 0xae:
+	case 0xaf:
+		d->on = a[0] & 1;
+		break;
+	case 0xc0:
+	case 0xc8:
+		d->com_remap = a[0] == 0xc8;
+		break;
+	case 0xd3:
+		d->offset = a[1] & 0x3f;
+		break;
+	case 0x29:
+	case 0x2a:
+	case 0x8d:
+	case 0xa3:
+	case 0xa8:
+	case 0xd5:
+	case 0xd9:
+	case 0xda:
+	case 0xdb:
+	case 0xe3:	/* nop */
+		/* nothing visible to model */
+		break;
+	default:
+		d->bad_cmds++;
+		break;
+	}
+}
+
+static void
+write_data(struct ssd1306 *d, uint8_t b)
+{
+	if (d->scrolling)
+		d->scroll_writes++;
+	d->gddram[d->page * SSD1306_WIDTH + d->col] = b;
+
+	switch (d->mode) {
+	case SSD1306_HORIZONTAL:
+		if (d->col++ < d->col1)
+			break;
+		d->col = d->col0;
+		if (d->page++ >= d->page1)
+			d->page = d->page0;
+		break;
+	case SSD1306_VERTICAL:
+		if (d->page++ < d->page1)
+			break;
+		d->page = d->page0;
+		if (d->col++ >= d->col1)
+			d->col = d->col0;
+		break;
+	default:
+		/* page mode wraps around within the page */
+		if (d->col++ >= SSD1306_WIDTH - 1)
+			d->col = 0;
+		break;
+	}
+}
+
+void
+ssd1306_write(struct ssd1306 *d, const uint8_t *buf, size_t len, int command)
+{
+	if (!command) {
+		d->data_bytes += len;
+		while (len--)
+			write_data(d, *buf++);
+		return;
+	}
+
+	d->cmd_bytes += len;
+	while (len--) {
+		d->cmd[d->ncmd++] = *buf++;
+		if (d->ncmd <= cmd_args(d->cmd[0]))
+			continue;
+		run_cmd(d);
+		d->ncmd = 0;
+	}
+}
+
+/* moves the scrolled pages of the RAM by one column */
+static void
+scroll_step(struct ssd1306 *d)
+{
+	uint8_t *p, c;
+	int page;
+
+	for (page = d->scroll_page0; page <= d->scroll_page1; page++) {
+		p = d->gddram + page * SSD1306_WIDTH;
+		if (d->scroll_left) {
+			c = p[0];
+			memmove(p, p + 1, SSD1306_WIDTH - 1);
+			p[SSD1306_WIDTH - 1] = c;
+		} else {
+			c = p[SSD1306_WIDTH - 1];
+			memmove(p + 1, p, SSD1306_WIDTH - 1);
+			p[0] = c;
+		}
+	}
+}
+
+void
+ssd1306_advance(struct ssd1306 *d, unsigned long us)
+{
+	int x, y;
+
+	if (us && d->levels) {
+		for (y = 0; y < SSD1306_HEIGHT; y++)
+			for (x = 0; x < SSD1306_WIDTH; x++)
+				if (ssd1306_pixel(d, x, y))
+					d->lit_us[y * SSD1306_WIDTH + x] += us;
+		d->total_us += us;
+	}
+
+	d->frame_us += us;
+	while (d->frame_us >= SSD1306_FRAME_US) {
+		d->frame_us -= SSD1306_FRAME_US;
+		if (!d->scrolling)
+			continue;
+		if (++d->scroll_frames < d->scroll_interval)
+			continue;
+		d->scroll_frames = 0;
+		scroll_step(d);
+	}
+}
+
+int
+ssd1306_pixel(const struct ssd1306 *d, int x, int y)
+{
+	int lit;
+
+	if (!d->on)
+		return 0;
+	/* boot() remaps both directions to get the picture upright */
+	if (!d->seg_remap)
+		x = SSD1306_WIDTH - 1 - x;
+	if (!d->com_remap)
+		y = SSD1306_HEIGHT - 1 - y;
+	y = (y + d->offset + d->start_line) % SSD1306_HEIGHT;
+
+	lit = d->all_on || (d->gddram[(y / 8) * SSD1306_WIDTH + x] >> (y % 8)) & 1;
+	return lit ^ d->inverted;
+}
+
+void
+ssd1306_picture(const struct ssd1306 *d, uint8_t *dst, uint8_t off,
+		uint8_t on)
+{
+	uint8_t rows[SSD1306_WIDTH * SSD1306_HEIGHT];
+	int x, y, first;
+
+	if (!d->on || d->all_on) {
+		memset(dst, d->on && !d->inverted ? on : off, sizeof(rows));
+		return;
+	}
+	if (!d->seg_remap || !d->com_remap) {
+		/* mirrored, not what boot() sets up */
+		for (y = 0; y < SSD1306_HEIGHT; y++)
+			for (x = 0; x < SSD1306_WIDTH; x++)
+				*dst++ = ssd1306_pixel(d, x, y) ? on : off;
+		return;
+	}
+
+	if (d->inverted)
+		fbconv_linear8(rows, d->gddram, SSD1306_WIDTH, SSD1306_PAGES,
+			       on, off);
+	else
+		fbconv_linear8(rows, d->gddram, SSD1306_WIDTH, SSD1306_PAGES,
+			       off, on);
+	/* the display offset and start line rotate the rows */
+	first = (d->offset + d->start_line) % SSD1306_HEIGHT;
+	memcpy(dst, rows + first * SSD1306_WIDTH,
+	       (SSD1306_HEIGHT - first) * SSD1306_WIDTH);
+	memcpy(dst + (SSD1306_HEIGHT - first) * SSD1306_WIDTH, rows,
+	       first * SSD1306_WIDTH);
+}
+
+int
+ssd1306_level(const struct ssd1306 *d, int x, int y)
+{
+	if (!d->total_us)
+		return ssd1306_pixel(d, x, y) * d->contrast;
+	return (unsigned long long)d->lit_us[y * SSD1306_WIDTH + x] *
+		d->contrast / d->total_us;
+}
+
+void
+ssd1306_reset_levels(struct ssd1306 *d)
+{
+	memset(d->lit_us, 0, sizeof(d->lit_us));
+	d->total_us = 0;
+	d->levels = 1;
+}
+
+unsigned long
+ssd1306_bus_ns(const struct ssd1306 *d, unsigned long bytes)
+{
+	return (unsigned long long)bytes * 8 * 1000000000ULL / d->spi_hz;
+}
@@ -0,0 +1,104 @@
+/*
+ * Software model of the SSD1306 OLED controller for the host build.
+ *
+ * It is fed the bytes the library sends over SPI, split into command and data
+ * bytes like the D/C pin does, and keeps its own display RAM.  The picture is
+ * what the panel would show, including inversion, contrast, display offset,
+ * remapping and scrolling.  All traffic is counted so partial updates and
+ * effects can be measured without a device.
+ */
+#ifndef SSD1306_H
+#define SSD1306_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SSD1306_WIDTH			128
+#define SSD1306_PAGES			8
+#define SSD1306_HEIGHT			(SSD1306_PAGES * 8)
+
+/* the panel refreshes at about 100Hz with the clock boot() sets */
+#define SSD1306_FRAME_US		10000
+
+enum ssd1306_modes {
+	SSD1306_HORIZONTAL = 0,
+	SSD1306_VERTICAL,
+	SSD1306_PAGE,
+};
+
+struct ssd1306 {
+	uint8_t gddram[SSD1306_WIDTH * SSD1306_PAGES];
+
+	/* command being parsed */
+	uint8_t cmd[8];
+	uint8_t ncmd;
+
+	/* addressing */
+	uint8_t mode;
+	uint8_t col, page;
+	uint8_t col0, col1;
+	uint8_t page0, page1;
+
+	/* what the panel shows */
+	uint8_t on;
+	uint8_t inverted;
+	uint8_t all_on;
+	uint8_t contrast;
+	uint8_t offset;			/* display offset, 0xD3 */
+	uint8_t start_line;		/* 0x40 - 0x7F */
+	uint8_t seg_remap;		/* 0xA1 */
+	uint8_t com_remap;		/* 0xC8 */
+
+	/* horizontal scroll */
+	uint8_t scrolling;
+	uint8_t scroll_left;
+	uint8_t scroll_page0, scroll_page1;
+	uint16_t scroll_interval;	/* in panel frames */
+	uint16_t scroll_frames;
+	unsigned long frame_us;		/* time not yet turned into frames */
+
+	/* how long each pixel was lit, for what the eye makes of grayscale */
+	uint32_t lit_us[SSD1306_WIDTH * SSD1306_HEIGHT];
+	unsigned long total_us;
+	uint8_t levels;			/* tracked since ssd1306_reset_levels() */
+
+	/* traffic, reset by whoever reads it */
+	uint32_t spi_hz;
+	unsigned long data_bytes;
+	unsigned long cmd_bytes;
+	unsigned long bad_cmds;		/* commands the model does not know */
+	unsigned long scroll_writes;	/* RAM writes while scrolling */
+};
+
+/* puts the controller into its power on state */
+void ssd1306_reset(struct ssd1306 *d, uint32_t spi_hz);
+
+/* feeds bytes sent with D/C low (command) or high (data) */
+void ssd1306_write(struct ssd1306 *d, const uint8_t *buf, size_t len,
+		   int command);
+
+/* lets time pass for the panel, this is what moves scrolling pages */
+void ssd1306_advance(struct ssd1306 *d, unsigned long us);
+
+/* returns 1 if the pixel is lit on the panel */
+int ssd1306_pixel(const struct ssd1306 *d, int x, int y);
+
+/*
+ * writes the whole picture as one byte per pixel, off or on, the rows one
+ * after the other
+ */
+void ssd1306_picture(const struct ssd1306 *d, uint8_t *dst, uint8_t off,
+		     uint8_t on);
+
+/*
+ * returns the brightness of a pixel averaged over the time passed since the
+ * last ssd1306_reset_levels(), 0 - 255 at full contrast.  Nothing is
+ * tracked before the first call, that costs time with every transfer.
+ */
+int ssd1306_level(const struct ssd1306 *d, int x, int y);
+void ssd1306_reset_levels(struct ssd1306 *d);
+
+/* time the given number of bytes takes on the SPI bus */
+unsigned long ssd1306_bus_ns(const struct ssd1306 *d, unsigned long bytes);
+
+#endif
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "term.h"
+
+/* dot bits of U+2800 and up for the pixels of a 2x4 cell */
+static const uint8_t braille_dots[4][2] = {
+	{ 0x01, 0x08 },
+	{ 0x02, 0x10 },
+	{ 0x04, 0x20 },
+	{ 0x40, 0x80 },
+};
+
+int
+term_init(struct term *t, int fd, int mode, int width, int height)
+{
+	memset(t, 0, sizeof(*t));
+	t->fd = fd;
+	t->mode = mode;
+	t->width = width;
+	t->height = height;
+	if (mode == TERM_BRAILLE) {
+		t->cols = (width + 1) / 2;
+		t->rows = (height + 3) / 4;
+	} else {
+		t->cols = width;
+		t->rows = height;
+	}
+	t->cells = (uint32_t *)calloc(t->cols * t->rows, sizeof(uint32_t));
+	t->next = (uint32_t *)calloc(t->cols * t->rows, sizeof(uint32_t));
+	/* worst case every cell with a cursor movement */
+	t->size = t->cols * t->rows * 16 + 64;
+	t->out = (char *)malloc(t->size);
+	if (!t->cells || !t->next || !t->out) {
+		term_free(t);
+		return -1;
+	}
+	return 0;
+}
+
+void
+term_free(struct term *t)
+{
+	free(t->cells);
+	free(t->next);
+	free(t->out);
+	t->cells = t->next = NULL;
+	t->out = NULL;
+}
+
+void
+term_invalidate(struct term *t)
+{
+	memset(t->cells, 0, t->cols * t->rows * sizeof(uint32_t));
+}
+
+static void
+cells_ascii(struct term *t, const uint8_t *pixels)
+{
+	int i;
+
+	for (i = 0; i < t->cols * t->rows; i++)
+		t->next[i] = pixels[i];
+}
+
+static void
+cells_braille(struct term *t, const uint8_t *pixels, uint8_t off)
+{
+	int col, row, x, y, px, py;
+	uint32_t dots;
+
+	for (row = 0; row < t->rows; row++)
+		for (col = 0; col < t->cols; col++) {
+			dots = 0;
+			for (y = 0; y < 4; y++)
+				for (x = 0; x < 2; x++) {
+					px = col * 2 + x;
+					py = row * 4 + y;
+					if (px < t->width && py < t->height &&
+					    pixels[py * t->width + px] != off)
+						dots |= braille_dots[y][x];
+				}
+			t->next[row * t->cols + col] = 0x2800 + dots;
+		}
+}
+
+static size_t
+put_utf8(char *p, uint32_t c)
+{
+	if (c < 0x80) {
+		p[0] = c;
+		return 1;
+	}
+	if (c < 0x800) {
+		p[0] = 0xc0 | (c >> 6);
+		p[1] = 0x80 | (c & 0x3f);
+		return 2;
+	}
+	p[0] = 0xe0 | (c >> 12);
+	p[1] = 0x80 | ((c >> 6) & 0x3f);
+	p[2] = 0x80 | (c & 0x3f);
+	return 3;
+}
+
+static void
+flush(struct term *t)
+{
+	size_t done = 0;
+	ssize_t n;
+
+	while (done < t->len) {
+		n = write(t->fd, t->out + done, t->len - done);
+		if (n < 0) {
+			if (errno == EINTR || errno == EAGAIN)
+				continue;
+			break;
+		}
+		done += n;
+	}
+}
+
+/* bytes needed to rewrite the cells from col0 up to col1 */
+static size_t
+gap_bytes(const struct term *t, int row, int col0, int col1)
+{
+	char buf[4];
+	size_t n = 0;
+
+	for (; col0 < col1; col0++)
+		n += put_utf8(buf, t->cells[row * t->cols + col0]);
+	return n;
+}
+
+size_t
+term_frame(struct term *t, const uint8_t *pixels, uint8_t off)
+{
+	int row, col, i, cursor_row = -1, cursor_col = -1;
+	char move[16];
+	size_t n;
+
+	if (t->mode == TERM_BRAILLE)
+		cells_braille(t, pixels, off);
+	else
+		cells_ascii(t, pixels);
+
+	t->len = 0;
+	for (row = 0; row < t->rows; row++)
+		for (col = 0; col < t->cols; col++) {
+			i = row * t->cols + col;
+			if (t->next[i] == t->cells[i])
+				continue;
+
+			if (row != cursor_row || col != cursor_col) {
+				n = snprintf(move, sizeof(move), "\x1b[%d;%dH",
+					     row + 1, col + 1);
+				/*
+				 * rewriting a few unchanged cells of the row
+				 * can be shorter than moving the cursor
+				 */
+				if (row == cursor_row &&
+				    gap_bytes(t, row, cursor_col, col) < n) {
+					for (; cursor_col < col; cursor_col++)
+						t->len += put_utf8(t->out + t->len,
+							t->cells[row * t->cols + cursor_col]);
+				} else {
+					memcpy(t->out + t->len, move, n);
+					t->len += n;
+				}
+			}
+			t->len += put_utf8(t->out + t->len, t->next[i]);
+			t->cells[i] = t->next[i];
+			cursor_row = row;
+			cursor_col = col + 1;
+		}
+
+	flush(t);
+	t->frames++;
+	t->bytes += t->len;
+	if (t->len > t->max_bytes)
+		t->max_bytes = t->len;
+	return t->len;
+}
@@ -0,0 +1,52 @@
+/*
+ * Terminal output of the host build.
+ *
+ * The picture is turned into character cells, either one character per
+ * pixel or a Unicode braille character for every 2x4 pixels, which fits the
+ * 128x64 screen into 64x16 cells.  The cells of the last frame are kept and
+ * only the ones that changed are sent, with cursor movements in between, in
+ * a single write().  That keeps the traffic low enough for slow links.
+ */
+#ifndef TERM_H
+#define TERM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+enum term_modes {
+	TERM_ASCII,		/* one character per pixel */
+	TERM_BRAILLE,		/* 2x4 pixels per character */
+};
+
+struct term {
+	int fd;
+	int mode;
+	int width, height;	/* in pixels */
+	int cols, rows;		/* in cells */
+	uint32_t *cells;	/* what the terminal shows, 0 if unknown */
+	uint32_t *next;
+
+	char *out;		/* bytes of the frame being built */
+	size_t len, size;
+
+	/* traffic */
+	unsigned long frames;
+	unsigned long long bytes;
+	unsigned long max_bytes;
+};
+
+/* returns -1 if out of memory */
+int term_init(struct term *t, int fd, int mode, int width, int height);
+void term_free(struct term *t);
+
+/* makes the next frame redraw every cell */
+void term_invalidate(struct term *t);
+
+/*
+ * shows a picture of one byte per pixel.  In ASCII mode the bytes are the
+ * characters, in braille mode every byte but off is a lit dot.  Returns the
+ * number of bytes written.
+ */
+size_t term_frame(struct term *t, const uint8_t *pixels, uint8_t off);
+
+#endif
@@ -833,35 +833,35 @@ const uint8_t water_bomb_air_mask_img[24] PROGMEM = {
 	0x05, /* height */
 	0x0a, 0x80, 0x0d, 0x00, 0x11, 0x80, 0x14, 0x00,
 /* [0]
- * _*__
+ * ____
+ * ____
  * __*_
- * _*_*
- * _*_*
  * __*_
+ * ____
  */
 	0x00, 0xf0, 0xc0,
 /* [1]
- * *___
+ * ____
+ * ____
  * _**_
- * *__*
- * *__*
  * _**_
+ * ____
  */
 	0x00, 0x0c, 0x0c, 0x00,
 /* [2]
+ * ____
+ * ____
  * _*__
  * _*__
- * *_*_
- * *_*_
- * _*__
+ * ____
  */
 	0x0f, 0x0c, 0x00,
 /* [3]
- * ___*
+ * ____
+ * ____
  * _**_
- * *__*
- * *__*
  * _**_
+ * ____
  */
 	0x00, 0x0c, 0x0c, 0x00,
 };
@@ -892,307 +892,307 @@ const uint8_t enemy_drunken_punk_mask_img[162] PROGMEM = {
 	0x4d, 0x80, 0x54, 0x80, 0x5b, 0x80, 0x63, 0x80, 0x6b, 0x80, 0x73, 0x80,
 	0x7a, 0x80, 0x84, 0x80, 0x8e, 0x80, 0x98, 0x80,
 /* [0]
- * _____**__*____
- * _______*___*__
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ______**_*_*__
- * ______*__*____
- * ___*___***____
- * __**__***_____
- * __**_****_____
- * ___**_***_____
- * ______***_____
- * ______*_*_____
- * _____*__*_____
- * _____*___*____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [1]
- * ____*_*_*_____
- * ___*_*___*____
- * __**__*_*_____
- * _*__*_*_*_*___
- * _____***_*____
- * ____*__*__*___
- * ____**_*_*____
- * ____*__*______
- * _____***______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * _____**_______
- * ______**______
- * _____****_____
- * __*__****_____
- * *__**_*_*_____
- * ___*_*___*____
- * ______*___*___
+ * ______*_______
+ * _____**_______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x50, 0xfa, 0x0f, 0xe0, 0xd1, 0x50,
 /* [2]
- * _____*__*_*___
- * _______*___*__
- * ____**__*_*___
- * ______*_*_*_*_
- * _______***_*__
- * ______*__*_*__
- * ______**_**___
- * ______*__*____
- * _*_____***____
- * ______***_____
- * __*__****_____
- * __***_***_____
- * __**__***_____
- * ______**______
- * _____*__*_____
- * ____*__*______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [3]
  * ______________
- * __________*___
- * _______**__*__
- * _____**__*__*_
- * ____*__*_*_*_*
- * _*______***_*_
- * ___*___*__*__*
- * _______**_*_*_
- * __*____*__*___
- * __**____***___
- * __***__***____
- * __**_*****____
- * _______***____
- * _______*_*____
- * ______*___*___
- * _____*____*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ________**____
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0x29, 0xd0, 0xc0, 0x11, 0xd0, 0x40,
 /* [4]
- * _____**__*____
- * _______*___*__
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ______**_*____
- * ______*__*____
- * _______***____
- * ________***___
- * _______****___
- * _____**_***___
- * ________***___
- * _______**_*___
- * _______*__*___
- * ______**_**___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [5]
- * __________*___
- * ______***__*__
- * _____**__*_*__
- * _____*_*_*_*_*
- * ________***_*_
- * _______*__**__
- * _______**_*___
- * _______*__*___
- * ________***___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * _____*_****___
- * ______*_***___
- * ________***___
- * _______**_*___
- * ______*___*___
- * _______*__*___
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0xfa, 0x0f, 0xe0, 0xd1, 0x20,
 /* [6]
- * _____*__*_____
- * ____*__*__*___
- * ____*__*_*____
- * _____*_*_*_*__
- * ______***_*___
- * _____*__*__*__
- * _____**_*_____
- * _____*__*_____
- * ______***_____
- * _____*__**____
- * ___*__*****___
- * __*_____***___
- * __*__*__***___
- * ___*_***__*___
- * __________*___
- * __________*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______**______
+ * _______*______
+ * ______**______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x60, 0xfa, 0x0f, 0xe0, 0xd1, 0x40,
 /* [7]
- * _______*_*____
- * _______*___*__
- * ____**__*__*__
- * ______*_*_*___
- * _______***__*_
- * ______*__*_*__
- * ______**_*____
- * ______*__*____
- * _______***____
- * ___*____***___
- * _*____*****___
- * ________***___
- * *_______***___
- * _______*__*___
- * _*____*___*___
- * ___*__*___*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [8]
  * ______________
- * __________*___
- * _______**__*__
- * _____**__*__*_
- * ____*__*_*_*_*
- * ________***_*_
- * _______*__*__*
- * __***__**_*_*_
- * __****_*__*___
- * ___*____***___
- * ____**_***____
- * ______****____
- * _______***____
- * _______*_*____
- * ______*___*___
- * ______*___*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ________**____
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0x29, 0xd0, 0xc0, 0x11, 0xd0, 0x40,
 /* [9]
  * ______________
- * _______*____*_
- * ________*__*__
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________***_*_
- * ___***_*__*__*
- * ___******_*_*_
- * ____*__*__*___
- * ____*___***___
- * _____*_***____
- * ______****____
- * _______***____
- * _______*_*____
- * ______*___*___
- * ______*___*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ________**____
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0x29, 0xd0, 0xc0, 0x11, 0xd0, 0x40,
 /* [10]
  * ______________
- * _______*____*_
- * ________*__*__
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________***_*_
- * _______*__*__*
- * _______**_*_*_
- * _____*_*__*___
- * ___**___***___
- * ___**__***____
- * ____******____
- * _______***____
- * _______*_*____
- * ______*__*____
- * ______*__*____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ________**____
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0x29, 0xd0, 0xc0, 0x11, 0xd0, 0x40,
 /* [11]
- * ______*____*__
- * _______*__*___
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ______**_*_*__
- * ______*__*____
- * _______***____
- * ___*____**____
- * ___**__***____
- * ___**_****____
- * ____**_***____
- * _______*_*____
- * _______*_*____
- * _______*_*____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [12]
- * ______**__*___
- * ________*___*_
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________**__*_
- * _______*__*__*
- * _______**_*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * _______****___
- * _______*_**___
- * ___*____***___
- * _____*_****___
- * _*______*_*___
- * ________*_*___
- * **_____**_*___
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ________*_____
+ * _______*______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0xfa, 0x0f, 0xe0, 0xd0, 0xb0, 0x57, 0xd0, 0x50,
 /* [13]
- * ______**__*___
- * ________*___*_
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________**__*_
- * _______*__*__*
- * _______**_*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * _______****___
- * _______*_**___
- * ____*___***___
- * __*____****___
- * ________*_*___
- * _*______*_*___
- * *_*____**_*___
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ________*_____
+ * _______*______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0xfa, 0x0f, 0xe0, 0xd0, 0xb0, 0x57, 0xd0, 0x50,
 /* [14]
  * ______________
- * ______**__*___
- * ________*___*_
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________**__*_
- * _______*__*__*
- * _______**_*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * _______****___
- * _______*_**___
- * _____*__***___
- * __*____**_*___
- * ________*_*___
- * *_*____**_*___
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ________*_____
+ * _______*______
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0x29, 0xd0, 0xb0, 0x4f, 0x09, 0x1d, 0x04, 0x00,
 /* [15]
  * ______________
- * ______**__*___
- * ________*___*_
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________**__*_
- * _______*__*__*
- * _______**_*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * _______****___
- * _______*_**___
- * ________***___
- * ___*___**_*___
- * ________*_*___
- * __*____**_*___
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ________*_____
+ * _______*______
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0x29, 0xd0, 0xb0, 0x4f, 0x09, 0x1d, 0x04, 0x00,
 };
@@ -1316,307 +1316,307 @@ const uint8_t enemy_raider_mask_img[164] PROGMEM = {
 	0x4f, 0x80, 0x56, 0x80, 0x5e, 0x80, 0x66, 0x80, 0x6d, 0x80, 0x74, 0x80,
 	0x7c, 0x80, 0x86, 0x80, 0x90, 0x80, 0x9a, 0x80,
 /* [0]
- * _____**__*____
- * _______*___*__
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ______**_*_*__
- * ___*__*__*____
- * ___*___***____
- * ____*___***___
- * ____*__****___
- * _____**__**___
- * _____*___**___
- * ________*__*__
- * _______*____**
- * _______*______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [1]
  * ______________
- * _______*_*____
- * _____*_*_*_*__
- * _____*__*_*___
- * ______*_*_*_*_
- * _______***_*__
- * ______*__*_*__
- * ______**_**___
- * ____*_*__*____
- * ____*__***____
- * ____*___***___
- * ____*__****___
- * _____**__**___
- * _____*___**___
- * ________*_*___
- * _________**___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0x29, 0xd0, 0xc0, 0x11, 0xd0, 0x50,
 /* [2]
  * ______________
- * _____**__*____
- * _______*___*__
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ___*__**_*____
- * ___*__*__*____
- * ____*__***____
- * ____*___***___
- * ____*******___
- * _____*___**___
- * _________**___
- * ________*_*___
- * ________*__*__
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0x29, 0xd0, 0xc0, 0x11, 0xd0, 0x50,
 /* [3]
- * _______*_*____
- * _____*_*_*_*__
- * _____*__*_*___
- * ______*_*_*_*_
- * _______***_*__
- * ______*__*_*__
- * ____*_**_**___
- * ____*_*__*____
- * _____*_***____
- * _____*__***___
- * _____******___
- * _____*___**___
- * _________**___
- * ________*__*__
- * _______*___*__
- * ________*___*_
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [4]
- * _____**__*____
- * _______*___*__
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ___*__**_*____
- * ___*__*__*____
- * ____*__***____
- * ____*___***___
- * ____*******___
- * _____*__***___
- * ________***___
- * _______**_*___
- * _______*__*___
- * ______**_**___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [5]
  * ______________
- * ______*__*____
- * ____*__*___*__
- * _____*__*_*___
- * ______*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ______**_*____
- * ______*__*____
- * ___*___***____
- * ____*__****___
- * _____**_***___
- * ________***___
- * _______**_*___
- * _______*__*___
- * ______**_**___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0x29, 0xd0, 0xc0, 0x11, 0xd0, 0x50,
 /* [6]
  * ______________
- * _______*_*_*__
- * _____*__*_*___
- * ______*_*_*_*_
- * _______***_*__
- * _____*_*__*_*_
- * ______**__**__
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * ______*****___
- * ____**_****___
- * __**___****___
- * *____*_****___
- * _*__*__*__*___
- * __**___*__*___
- * ______**__**__
+ * ________**____
+ * ________**____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0xfe, 0x0f, 0xe0, 0xd1, 0x20,
 /* [7]
  * ______________
  * ______________
- * _______*_*_*__
- * _____*__*_*___
- * ______*_*_*_*_
- * __**___***_*__
- * _*__*_**__*_*_
- * *____*_*__**__
- * __**___*__*___
- * ____**__**____
- * ______*****___
- * _______****___
- * _______****___
- * _______*__*___
- * _______*__*___
- * ______**__**__
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ________**____
+ * ________**____
+ * ________**____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0x99, 0xd0, 0xc0, 0x11, 0xd0, 0x40,
 /* [8]
  * ______________
- * _____**__*____
- * _______*___*__
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ______**_*____
- * ______*__*____
- * _______***____
- * _______****___
- * ______*_***___
- * _____*__***___
- * _______**_*___
- * _______*__*___
- * ______**_**___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0x29, 0xd0, 0xc0, 0x11, 0xd0, 0x50,
 /* [9]
- * _____**__*____
- * _______*___*__
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ______**_*____
- * ______*__*____
- * _______***____
- * ________***___
- * _______****___
- * _____**_***___
- * ________***___
- * _______**_*___
- * _______*__*___
- * ______**_**___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [10]
- * _____**__*____
- * _______*___*__
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ______**_*____
- * ______*__*____
- * _______***____
- * ________***___
- * _____*_****___
- * ______*_***___
- * ________***___
- * _______**_*___
- * _______*__*___
- * ______**_**___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0xfa, 0x0f, 0xe0, 0xd1, 0x30,
 /* [11]
  * ______________
- * _____**__*____
- * _______*___*__
- * ____**__*_*___
- * ___*__*_*_*_*_
- * _______***_*__
- * ______*__*__*_
- * ______**_*____
- * ______*__*____
- * _______***____
- * ________***___
- * _______****___
- * ______*_***___
- * _______**_*___
- * _______*__*___
- * ______**_**___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * _______**_____
+ * ________*_____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x70, 0x29, 0xd0, 0xc0, 0x11, 0xd0, 0x50,
 /* [12]
- * ______**__*___
- * ________*___*_
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________**__*_
- * _______*__*__*
- * _______**_*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * _______****___
- * _______*_**___
- * ___*____***___
- * _____*_****___
- * _*______*_*___
- * ________*_*___
- * **_____**_*___
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ________*_____
+ * _______*______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0xfa, 0x0f, 0xe0, 0xd0, 0xb0, 0x57, 0xd0, 0x50,
 /* [13]
- * ______**__*___
- * ________*___*_
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________**__*_
- * _______*__*__*
- * _______**_*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * _______****___
- * _______*_**___
- * ____*___***___
- * __*____****___
- * ________*_*___
- * _*______*_*___
- * *_*____**_*___
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ________*_____
+ * _______*______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0xfa, 0x0f, 0xe0, 0xd0, 0xb0, 0x57, 0xd0, 0x50,
 /* [14]
  * ______________
- * ______**__*___
- * ________*___*_
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________**__*_
- * _______*__*__*
- * _______**_*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * _______****___
- * _______*_**___
- * _____*__***___
- * __*____**_*___
- * ________*_*___
- * *_*____**_*___
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ________*_____
+ * _______*______
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0x29, 0xd0, 0xb0, 0x4f, 0x09, 0x1d, 0x04, 0x00,
 /* [15]
  * ______________
- * ______**__*___
- * ________*___*_
- * _____**__*_*__
- * ____*__*_*_*_*
- * ________**__*_
- * _______*__*__*
- * _______**_*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  * ________**____
- * _______****___
- * _______*_**___
- * ________***___
- * ___*___**_*___
- * ________*_*___
- * __*____**_*___
+ * _________*____
+ * ________**____
+ * ______________
+ * ______________
+ * ________*_____
+ * _______*______
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x80, 0x29, 0xd0, 0xb0, 0x4f, 0x09, 0x1d, 0x04, 0x00,
 };
@@ -2519,19 +2519,19 @@ const uint8_t enemy_grandma_mask_img[108] PROGMEM = {
  * ______________
  * ______________
  * ______________
+ * ______________
+ * _____**_______
+ * ______________
  * _____***______
- * ____*__**_____
- * _***********__
- * ____*___*_____
- * ____**__*_____
- * ____*___*_____
- * _____*****____
- * _______****___
- * ___*__******__
- * ___*********__
- * ___*__******__
- * ___*__******__
- * ___*___*__*___
+ * ______**______
+ * _____***______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x50, 0xf5, 0x0f, 0xd0, 0x9d, 0x0b, 0x01, 0x11, 0xd0, 0x60,
 /* [1]
@@ -2539,37 +2539,37 @@ const uint8_t enemy_grandma_mask_img[108] PROGMEM = {
  * ______________
  * ______________
  * ______________
+ * ______________
+ * _____*________
+ * ______________
  * _____***______
- * ____*_***__*__
- * __*********___
- * _*__*___*_____
- * ____**__*_____
- * ____*___*_____
- * _____*****____
- * __*___*****___
- * ___*********__
- * ___*__******__
- * ____*_******__
- * ____*__*_*____
+ * ______**______
+ * _____***______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x50, 0xfa, 0x06, 0x6d, 0x0b, 0x0f, 0x02, 0xbb, 0xd0, 0x60,
 /* [2]
  * ______________
  * ______________
  * ______________
- * ______***_____
- * __*__*__**____
- * ___********___
- * _____*___*_**_
- * _____**__*____
- * _____*___*____
- * ______****____
- * _______****___
- * ____*_******__
- * ___*********__
- * ___*__******__
- * __*___******__
- * __*_____**____
+ * ______________
+ * ______**______
+ * ______________
+ * ______***_____
+ * _______**_____
+ * ______***_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x60, 0xf5, 0x0f, 0xd0, 0x9d, 0x0b, 0x01, 0x11, 0xd0, 0x50,
 /* [3]
@@ -2577,95 +2577,95 @@ const uint8_t enemy_grandma_mask_img[108] PROGMEM = {
  * ______________
  * ______________
  * ______________
+ * ______________
+ * _____*________
+ * ______________
  * _____***______
- * _*__*_***_____
- * __**********__
- * ____*___*_____
- * ____**__*_____
- * ____*___*_____
- * _____*****____
- * __*___*****___
- * ___*********__
- * ___*__******__
- * ____*_******__
- * ____*__*_*____
+ * ______**______
+ * _____***______
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x50, 0xfa, 0x06, 0x6d, 0x0b, 0x0f, 0x02, 0xbb, 0xd0, 0x60,
 /* [4]
  * ______________
- * _____*________
- * ______*__*____
- * _______****___
- * _______*_***__
- * ______*___***_
- * _____*_*___*__
- * _____*____**__
- * ______*__*__*_
- * ____*__**____*
- * ____*__****___
- * ____*_******__
- * ____********__
- * ____*_******__
- * ____*_******__
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ________*_____
+ * _______***____
+ * ______*_***___
+ * ______****____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x60, 0x9c, 0x03, 0xa0, 0xf0, 0xe0, 0x2d, 0x0a, 0x01, 0x1d, 0x05,
 	0x00,
 /* [5]
- * _____*________
- * ______*__*____
- * _______****___
- * _______*_***__
- * ______*___***_
- * _____*_*___*__
- * _____*____**__
- * ___*__*__*__*_
- * ___*___**____*
- * ___*___****___
- * ____*_******__
- * ____********__
- * ____*_******__
- * ______******__
- * _______*__*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ________*_____
+ * _______***____
+ * ______*_***___
+ * ______****____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x60, 0xc0, 0x46, 0x0d, 0x0f, 0x87, 0x08, 0xd1, 0x10,
 /* [6]
- * _____*________
- * ______*__*____
- * _______****___
- * _______*_***__
- * ______*___***_
- * _____*_*___*__
- * __*__*____**__
- * __*___*__*__*_
- * ___*___**____*
- * ___*___****___
- * ____********__
- * ____*_******__
- * ______******__
- * ______******__
- * _______*__*___
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ________*_____
+ * _______***____
+ * ______*_***___
+ * ______****____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x60, 0xc0, 0x46, 0x0d, 0x0f, 0x87, 0x08, 0xd1, 0x10,
 /* [7]
  * ______________
- * _____*________
- * ______*__*____
- * _______****___
- * _______*_***__
- * ______*___***_
- * _____*_*___*__
- * ___*_*____**__
- * ___*__*__*__*_
- * ___*___**____*
- * ___*___****___
- * ____********__
- * ____*_******__
- * ______******__
- * ______******__
- * _______*__*___
+ * ______________
+ * ______________
+ * ______________
+ * ________*_____
+ * _______***____
+ * ______*_***___
+ * ______****____
+ * _______**_____
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
+ * ______________
  */
 	0xd0, 0x60, 0x9c, 0x03, 0xa0, 0xf0, 0xe0, 0x2d, 0x0a, 0x01, 0x1d, 0x05,
 	0x00,
@@ -2685,25 +2685,25 @@ const uint8_t bomb_explode_mask_img[46] PROGMEM = {
  * ________________________________
  * ________________________________
  * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
- * ________________________________
+ * _______________**_______________
+ * ________*********___***_________
+ * _______******************_______
+ * ______********************______
+ * _____**********************_____
+ * _____***********************____
+ * _____************************___
+ * ____*************************___
+ * ____*************************___
+ * ____**************************__
+ * ___***************************__
+ * ___***************************__
+ * ___***************************__
+ * __*****************************_
+ * _******************************_
+ * _******************************_
+ * _******************************_
+ * __*****************************_
+ * __*****************************_
  */
 	0xd2, 0x40, 0x6c, 0x0a, 0xf0, 0xf8, 0xfc, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe,
 	0xfe, 0xfe, 0x33, 0xe0, 0x3f, 0xce, 0x03, 0xfe, 0xff, 0xcc, 0x04, 0xfc,
@@ -2804,41 +2804,41 @@ const uint8_t enemy_little_girl_mask_img[448] PROGMEM = {
 /* [0]
  * ________________
  * ________________
- * _**_____*_*_*___
- * **_*___*_*_*_*__
- * **_*__*_*_*_*_*_
- * ****_*_*_*_*_*_*
- * _**__*______*_*_
- * __*__*__*____*_*
- * ___*__*_*___*_*_
- * ___*__*______*_*
- * ____*__*_***__*_
- * ____*___*___*__*
- * _____**_*_*_*___
- * _______****__*__
- * ______***__****_
+ * _________*_*____
+ * __*_____*_*_*___
+ * __*____*_*_*_*__
+ * ______*_*_*_*_*_
+ * ______******_*_*
+ * ______**_****_*_
+ * _______*_***_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ___________**___
  * _________**_____
+ * ________________
  */
 	0x00, 0xf1, 0x80, 0x00, 0xc0, 0x9e, 0x0d, 0x06, 0x8d, 0x4e, 0x8d, 0x4a,
 	0x85, 0x0a, 0x02, 0xd0, 0x70, 0xbc, 0x05, 0x06, 0x5b, 0x4b, 0x3b, 0x22,
 	0x1f, 0x02, 0xf0, 0x50,
 /* [1]
- * ___**___________
- * __*_**__________
- * __*_**__________
- * __****__****____
- * ___**__**_*_*___
- * ___*__**_*_*_*__
- * __*__**_*_*_*_*_
- * __*__*___*_*_*__
- * __*__*_*__*_*_*_
- * ___*_*_*___*_*__
- * ___*__*_____*_*_
- * ____*__*_***_*__
- * _____*_**_*_*_*_
- * ______****__*___
- * _______*__***___
- * ________**_*____
+ * ________________
+ * ___*____________
+ * ___*____________
+ * ________________
+ * _________*_*____
+ * ________*_*_*___
+ * _______*_*_*_*__
+ * ______***_*_*_*_
+ * ______*_**_*_*__
+ * ______*_***_*_*_
+ * _______*****_*__
+ * ________*___*_*_
+ * _________*_*____
+ * __________**____
+ * ________**______
+ * __________*_____
  */
 	0x00, 0x0f, 0x06, 0x00, 0x69, 0xc0, 0x5a, 0x05, 0x0a, 0x05, 0x0a, 0x02,
 	0x6d, 0x07, 0x0b, 0x7c, 0x07, 0x4f, 0x57, 0xa6, 0x35, 0x0a, 0x05, 0x0a,
@@ -2846,103 +2846,103 @@ const uint8_t enemy_little_girl_mask_img[448] PROGMEM = {
 /* [2]
  * ________________
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
- * _**___*_*_*_*_*_
- * **_*_*_*_*_*_*_*
- * **_*_*______*_*_
- * ****_*__*____*_*
- * _**___*_*___*_*_
- * __*___*______*_*
- * ___*___*_***__*_
- * ____*___*___*__*
- * _____**_*_*_*___
- * _______****__*__
- * ______***__****_
+ * __*___*_*_*_*_*_
+ * __*___******_*_*
+ * ______**_****_*_
+ * _______*_***_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ___________**___
  * _________**_____
+ * ________________
  */
 	0x00, 0xf6, 0x00, 0x00, 0xc0, 0x9e, 0x0d, 0x06, 0x8d, 0x4e, 0x8d, 0x4a,
 	0x85, 0x0a, 0x02, 0xd0, 0x70, 0xbc, 0x05, 0x06, 0x5b, 0x4b, 0x3b, 0x22,
 	0x1f, 0x02, 0xf0, 0x50,
 /* [3]
- * _**_____________
- * ****____________
- * ****____________
- * ****___****_____
- * _**___**_*_*____
- * _*___**_*_*_*___
- * _*___*_*_*_*_*__
- * __*_*_______*_*_
- * __*_*_*__*___*__
- * ___**_*__*__*_*_
- * ___*_*_______*__
- * ____*_*__***__*_
- * _____*_**_*_*___
- * ______***__**___
- * _______*____*___
- * ________*_**____
- */
-	0xd0, 0x50, 0x69, 0xc0, 0x5a, 0x0d, 0x0a, 0x0d, 0x0a, 0x02, 0x6d, 0x07,
-	0x0b, 0x7c, 0x08, 0x0f, 0x4f, 0xf4, 0x67, 0x57, 0x05, 0x02, 0x05, 0x00,
-/* [4]
  * ________________
  * ________________
- * __**____*_*_*___
- * _**_*__*_*_*_*__
- * _**_*_*_*_*_*_*_
- * _*****_*_*_*_*_*
- * __**_*______*_*_
- * ___*_*__*____*_*
- * ___*__*_*___*_*_
- * ___*__*______*_*
- * ____*__*_***__*_
- * ____*___*___*__*
- * _____**_*_*_*___
- * _______****__*__
- * ______***__****_
+ * ________________
+ * ________________
+ * ________*_*_____
+ * _______*_*_*____
+ * ______*_*_*_*___
+ * _____*******_*__
+ * _____*_**_***_*_
+ * _____*_**_**_*__
+ * ______*******_*_
+ * _______**_______
+ * _________*_*____
+ * _________**_____
+ * ________****____
+ * _________*______
+ */
+	0xd0, 0x50, 0x69, 0xc0, 0x5a, 0x0d, 0x0a, 0x0d, 0x0a, 0x02, 0x6d, 0x07,
+	0x0b, 0x7c, 0x08, 0x0f, 0x4f, 0xf4, 0x67, 0x57, 0x05, 0x02, 0x05, 0x00,
+/* [4]
+ * ________________
+ * ________________
+ * _________*_*____
+ * ___*____*_*_*___
+ * ___*___*_*_*_*__
+ * ______*_*_*_*_*_
+ * ______******_*_*
+ * ______**_****_*_
+ * _______*_***_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ___________**___
  * _________**_____
+ * ________________
  */
 	0x00, 0x0f, 0x18, 0x00, 0xc0, 0x9e, 0x0d, 0x06, 0x8d, 0x4e, 0x8d, 0x4a,
 	0x85, 0x0a, 0x02, 0xd0, 0x70, 0xbc, 0x05, 0x06, 0x5b, 0x4b, 0x3b, 0x22,
 	0x1f, 0x02, 0xf0, 0x50,
 /* [5]
  * ________________
- * _*___*__________
- * *__*__*_*_*_*___
- * *_*____*_*_*_*__
- * ____*_*_*_*_*_*_
- * *__*_***_*_*_*_*
- * _*___*______*_*_
- * _____*_______*_*
- * ______*_**__*_*_
- * _*____*______*_*
- * __*____*_***__*_
- * ___**___*___*__*
- * _____**_*_*_*___
- * _______****__*__
- * ______***__****_
+ * ________________
+ * _________*_*____
+ * ________*_*_*___
+ * _______*_*_*_*__
+ * ________*_*_*_*_
+ * ______******_*_*
+ * ______*******_*_
+ * _______*__**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ___________**___
  * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0x9c, 0x08, 0xd0, 0xe8, 0xd4, 0xe8, 0xd4, 0xa8, 0x50, 0xa0,
 	0x2d, 0x07, 0x0b, 0xc0, 0x50, 0x65, 0xa4, 0xb3, 0xb2, 0x21, 0xf0, 0x2f,
 	0x05,
 /* [6]
- * __*___*_________
- * _*_____*________
- * ________*_*_*___
- * *______***_*_*__
- * *_____*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _*___*_*____*_*_
- * __*__**______*_*
- * ______*_**__*_*_
- * ______*______*_*
- * _______*_***__*_
- * ________*___*__*
- * __*_____*_*_*___
- * ___**__****__*__
- * _____****__****_
+ * ________________
+ * ________________
+ * _________*_*____
+ * __________*_*___
+ * _______*_*_*_*__
+ * ______*_*_*_*_*_
+ * ______*_****_*_*
+ * _______******_*_
+ * _______*__**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ___________**___
  * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0x96, 0x09, 0x0e, 0x0d, 0x4e, 0x8d, 0x4a, 0x85, 0x0a,
 	0x02, 0xd0, 0x70, 0xbc, 0x05, 0x06, 0x5a, 0x4b, 0x3b, 0x22, 0x1f, 0x02,
@@ -2950,20 +2950,20 @@ const uint8_t enemy_little_girl_mask_img[448] PROGMEM = {
 /* [7]
  * ________________
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
  * ______*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _____*______*_*_
- * _____*_______*_*
- * ______*_**__*_*_
- * ______*______*_*
- * _______*_***__*_
- * ________*___*__*
- * ________*_*_*___
- * _______*_**__*__
- * ______***__****_
- * __****___**_____
+ * ______******_*_*
+ * ______*******_*_
+ * _______*__**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ________*__**___
+ * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0x9e, 0x0d, 0x0e, 0x8d, 0x4e, 0x8d, 0x4a, 0x85, 0x0a,
 	0x02, 0xd0, 0x70, 0xbc, 0x05, 0x26, 0x5a, 0x4b, 0x3b, 0x22, 0x1f, 0x02,
@@ -2971,41 +2971,41 @@ const uint8_t enemy_little_girl_mask_img[448] PROGMEM = {
 /* [8]
  * ________________
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
  * ______*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _____*______*_*_
- * _____*__*____*_*
- * ______*__*__*_*_
- * ______*______*_*
- * _______*_***__*_
- * ________*___*__*
- * ________*_*_*___
- * _______*__*__*__
- * ______***__****_
+ * ______******_*_*
+ * ______**_****_*_
+ * _______**_**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ________**_**___
  * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0x9e, 0x0d, 0x06, 0x8d, 0x4e, 0x8d, 0x4a, 0x85, 0x0a,
 	0x02, 0xd0, 0x70, 0xbc, 0x05, 0x27, 0x7a, 0x4b, 0x3b, 0x22, 0x1f, 0x02,
 	0xf0, 0x50,
 /* [9]
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
  * ______*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _____*______*_*_
- * _____*__*____*_*
- * ______**_*__*_*_
- * ______*______*_*
- * ___*___*_***__*_
- * ________*___*__*
- * __*_____*_*_*___
- * ________*_*_*___
- * _______*_____*__
- * ______***__****_
+ * ______******_*_*
+ * ______**_****_*_
+ * ________*_**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * _________*_*____
+ * ________*****___
  * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0xa7, 0x06, 0x8b, 0x46, 0xaf, 0x4e, 0xa5, 0x4a, 0x85,
 	0x0a, 0x0d, 0x07, 0x01, 0xc0, 0x52, 0x37, 0xd6, 0x53, 0xd2, 0x10, 0x1f,
@@ -3013,41 +3013,41 @@ const uint8_t enemy_little_girl_mask_img[448] PROGMEM = {
 /* [10]
  * ________________
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
  * ______*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _____*______*_*_
- * _____**_*____*_*
- * ____*_*__*__*_*_
- * ______*______*_*
- * ___*___*_***__*_
- * ________*___*__*
- * __*_____*_*_*___
- * _______*__*__*__
- * ______***__****_
+ * ______******_*_*
+ * _______*_****_*_
+ * _______**_**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ________**_**___
  * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0x96, 0x0d, 0x06, 0x8d, 0x4e, 0x8d, 0x4a, 0x85, 0x0a,
 	0x02, 0xd0, 0x70, 0xbc, 0x05, 0x27, 0x7a, 0x4b, 0x3b, 0x22, 0x1f, 0x02,
 	0xf0, 0x50,
 /* [11]
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
  * ______*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _____*______*_*_
- * _____*__*____*_*
- * ______**_*__*_*_
- * ___*__*______*_*
- * _______*_***__*_
- * __*_____*___*__*
- * ________*_*_*___
- * __*_____*_*_*___
- * _______*_____*__
- * __*___***__****_
- * _*_*_____**_____
+ * ______******_*_*
+ * ______**_****_*_
+ * ________*_**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * _________*_*____
+ * ________*****___
+ * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0xa7, 0x06, 0x8b, 0x46, 0xaf, 0x4e, 0xa5, 0x4a, 0x85,
 	0x0a, 0x0d, 0x07, 0x01, 0xc0, 0x52, 0x37, 0xd6, 0x53, 0xd2, 0x10, 0x1f,
@@ -3055,41 +3055,41 @@ const uint8_t enemy_little_girl_mask_img[448] PROGMEM = {
 /* [12]
  * ________________
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
  * ______*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _____*______*_*_
- * _____**_*____*_*
- * ____*_*__*__*_*_
- * ___*__*______*_*
- * _______*_***__*_
- * __*_____*___*__*
- * ________*_*_*___
- * __*____*__*__*__
- * ______***__****_
- * _***_____**_____
+ * ______******_*_*
+ * _______*_****_*_
+ * _______**_**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ________**_**___
+ * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0x96, 0x0d, 0x06, 0x8d, 0x4e, 0x8d, 0x4a, 0x85, 0x0a,
 	0x02, 0xd0, 0x70, 0xbc, 0x05, 0x27, 0x7a, 0x4b, 0x3b, 0x22, 0x1f, 0x02,
 	0xf0, 0x50,
 /* [13]
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
  * ______*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _____*______*_*_
- * _____*__*____*_*
- * ______**_*__*_*_
- * ____*_*______*_*
- * ___*___*_***__*_
- * ________*___*__*
- * __*_____*_*_*___
- * ________*_*_*___
- * _______*_____*__
- * ______***__****_
- * _***_____**_____
+ * ______******_*_*
+ * ______**_****_*_
+ * ________*_**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * _________*_*____
+ * ________*****___
+ * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0xa7, 0x06, 0x8b, 0x46, 0xaf, 0x4e, 0xa5, 0x4a, 0x85,
 	0x0a, 0x0d, 0x07, 0x01, 0xc0, 0x52, 0x37, 0xd6, 0x53, 0xd2, 0x10, 0x1f,
@@ -3097,41 +3097,41 @@ const uint8_t enemy_little_girl_mask_img[448] PROGMEM = {
 /* [14]
  * ________________
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
  * ______*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _____*______*_*_
- * _____*__*____*_*
- * ______*__*__*_*_
- * ______*______*_*
- * ___*___*_***__*_
- * ________*___*__*
- * __*_____*_*_*___
- * _______*__*__*__
- * ______***__****_
- * __*______**_____
+ * ______******_*_*
+ * ______**_****_*_
+ * _______**_**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * ________**_**___
+ * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0x9e, 0x0d, 0x06, 0x8d, 0x4e, 0x8d, 0x4a, 0x85, 0x0a,
 	0x02, 0xd0, 0x70, 0xbc, 0x05, 0x27, 0x7a, 0x4b, 0x3b, 0x22, 0x1f, 0x02,
 	0xf0, 0x50,
 /* [15]
  * ________________
+ * _________*_*____
  * ________*_*_*___
  * _______*_*_*_*__
  * ______*_*_*_*_*_
- * _____*_*_*_*_*_*
- * _____*______*_*_
- * _____*__*____*_*
- * ______*__*__*_*_
- * ______*______*_*
- * _______*_***__*_
- * ________*___*__*
- * ________*_*_*___
- * ________*_*_*___
- * _______*_____*__
- * ______***__****_
- * __*______**_____
+ * ______******_*_*
+ * ______**_****_*_
+ * _______**_**_*_*
+ * _______******_*_
+ * ________*______*
+ * _________***____
+ * _________*_*____
+ * _________*_*____
+ * ________*****___
+ * _________**_____
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0xa7, 0x0e, 0x8b, 0x46, 0xaf, 0x4e, 0xa5, 0x4a, 0x85,
 	0x0a, 0x0d, 0x07, 0x01, 0xc0, 0x52, 0x37, 0xd6, 0x53, 0xd2, 0x10, 0x1f,
@@ -3225,242 +3225,242 @@ const uint8_t enemy_hacker_mask_img[223] PROGMEM = {
 	0x1a, 0x80, 0x2d, 0x80, 0x3e, 0x80, 0x52, 0x80, 0x62, 0x80, 0x74, 0x80,
 	0x88, 0x80, 0x99, 0x80, 0xa7, 0x80, 0xb5, 0x80, 0xc4, 0x80, 0xd1, 0x80,
 /* [0]
+ * ________________
  * ______***_______
+ * _____*_***______
  * _____*___*______
- * ____*_*___*_____
- * ____*_***_*_____
- * ____*_*__**_____
- * _____*___*______
- * ______******____
+ * _____*_**_______
+ * ______***_______
+ * ________________
+ * ________**_*____
+ * _______*__***___
  * _______*__*_*___
- * ______*_**___*__
- * ______*_**_*_*__
- * ______**_*_*_*__
- * _______***___*__
- * ________*****___
- * _______*__*_____
- * ________*__*____
- * _______**_**____
+ * ________*_*_*___
+ * __________***___
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x50, 0xc0, 0x51, 0xc2, 0x23, 0x6b, 0x68, 0xc0, 0x6d, 0x0b, 0x0b,
 	0x70, 0xc0, 0x30, 0xf0, 0x90, 0xf0, 0x00,
 /* [1]
+ * ________________
  * _____***________
+ * ____*_***_______
  * ____*___*_______
- * ___*_*___*______
- * ___*_***_*______
- * ___*_*__**______
- * ____*___*_______
- * _____********___
- * _______*_*___*__
- * ______*_**_*_*__
- * ______*_**_*_*__
- * ______**_*___*__
- * _______******___
- * ________**______
- * ________*_*_____
- * _________*______
- * ________**______
+ * ____*_**________
+ * _____***________
+ * ________________
+ * ________*_***___
+ * _______*__*_*___
+ * _______*__*_*___
+ * ________*_***___
+ * ________________
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x40, 0xc0, 0x51, 0xc2, 0x23, 0x63, 0x68, 0xc0, 0x66, 0x6d, 0x0a,
 	0x0b, 0x70, 0xa7, 0xa0, 0x00,
 /* [2]
+ * ________________
  * ________________
  * ______***_______
+ * _____*_***______
  * _____*___*______
- * ____*_*___*_____
- * ____*_***_*_____
- * ____*_*__**_____
- * _____*___*______
- * ______*******___
- * _______*_*___*__
- * ______*_**_*_*__
- * ______*_**_*_*__
- * _______*_*___*__
- * ________*****___
- * _______*_*______
- * ________*_*_____
- * _________**_____
+ * _____*_**_______
+ * ______***_______
+ * ________________
+ * ________*_***___
+ * _______*__*_*___
+ * _______*__*_*___
+ * ________*_***___
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x50, 0xc0, 0x53, 0x84, 0x46, 0xc6, 0xc1, 0x8d, 0x0d, 0x0f, 0x06,
 	0xf0, 0x90, 0xc0, 0x30, 0xf0, 0x90, 0xf0, 0x00,
 /* [3]
- * _______***______
- * ______*___*_____
- * _____*_*___*____
- * _____*_***_*____
- * _____*_*__**____
+ * ________________
+ * _______***______
+ * ______*_***_____
  * ______*___*_____
- * _______***_**___
- * _______*_**__*__
- * ______*_**_*_*__
- * ______*_**_*_*__
- * ______**_*___*__
- * _______******___
- * ________**______
- * _______*__***___
- * _______*____*___
- * ______**________
+ * ______*_**______
+ * _______***______
+ * __________*_____
+ * ________*__**___
+ * _______*__*_*___
+ * _______*__*_*___
+ * ________*_***___
+ * ________________
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0x51, 0xc2, 0x2b, 0x63, 0x64, 0xc6, 0x6d, 0x0a, 0x0b,
 	0x70, 0xa7, 0xa0, 0x00,
 /* [4]
+ * ________________
  * _______***______
+ * ______*_***_____
  * ______*___*_____
- * _____*_*___*____
- * _____*_***_*____
- * _____*_*__**____
- * ______*___*_____
+ * ______*_**______
  * _______***______
- * _____*****______
- * ____*___*_*_____
- * ____**_*_**_____
- * ____**_****_____
- * ____*__****_____
- * _____**_**______
- * ________*_*_____
- * _______*__*_____
- * ______**_**_____
+ * ________________
+ * ________________
+ * _____***_*______
+ * ______*_*_______
+ * ______*_________
+ * _____**_________
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x60, 0xc0, 0x51, 0xc2, 0x23, 0x63, 0x60, 0xcd, 0x0a, 0x0f, 0x09,
 	0xf0, 0xf1, 0xf0, 0x21, 0xd0, 0x60,
 /* [5]
+ * ________________
  * ________________
  * _____***________
+ * ____*_***_______
  * ____*___*_______
- * ___*_*___*______
- * ___*_***_*______
- * ___*_*__**______
- * ____*___*_______
+ * ____*_**________
  * _____***________
- * ___**_***_______
- * __*__**__*______
- * __**_*_****_____
- * __**_*_****_____
- * __*__*__**______
- * ___**__*__*_____
- * _______*___*____
- * ______**__**____
+ * ________________
+ * ________________
+ * ___**__**_______
+ * ____*___________
+ * ____*___________
+ * ___**___________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x40, 0xc0, 0x53, 0x84, 0x46, 0xc6, 0xc1, 0x8d, 0x0a, 0x0f, 0x12,
 	0xf1, 0xe0, 0x0f, 0x02, 0xf0, 0x2d, 0x07, 0x00,
 /* [6]
+ * ________________
  * ________________
  * ________________
  * _____***________
+ * ____*_***_______
  * ____*___*_______
- * ___*_*___*______
- * ___*_***_*______
- * ___*_*__**______
- * ____*___*_______
+ * ____*_**________
  * _____***________
- * ______***_______
- * _***_*_***______
- * *___*__***______
- * *_*_*___**______
- * *_*_*___**______
- * *___*__*__*_____
- * _***__**_**_____
+ * ________________
+ * ________________
+ * ________________
+ * _***____________
+ * _*_*____________
+ * _*_*____________
+ * _***____________
+ * ________________
  */
 	0xd0, 0x40, 0xc0, 0x57, 0x08, 0x8d, 0x8d, 0x83, 0x0d, 0x08, 0x0c, 0x03,
 	0x78, 0x48, 0x78, 0xd0, 0xc0,
 /* [7]
+ * ________________
  * ________________
  * ________________
  * _________***____
+ * ________*_***___
  * ________*___*___
- * _______*_*___*__
- * _______*_***_*__
- * _______*_*__**__
- * ________*___*___
+ * ________*_**____
  * _________***____
- * __________**____
- * _________*_**___
- * ___*____*_***___
- * ____*__*_****___
- * _____***_****___
- * ____*____****___
- * _____*******____
+ * ________________
+ * ________________
+ * __________*_____
+ * _________*______
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x80, 0xc0, 0x57, 0x08, 0x8d, 0x8d, 0x83, 0x0d, 0x0c, 0x05, 0x7d,
 	0x05, 0x00,
 /* [8]
+ * ________________
  * ________________
  * ________________
  * ________***_____
+ * _______*_***____
  * _______*___*____
- * ______*_*___*___
- * ______*_***_*___
- * ______*_*__**___
- * _______*___*____
+ * _______*_**_____
  * ________***_____
- * __________**____
- * _________*_**___
- * ___*__***_***___
- * ____*____****___
- * _____***_****___
- * ____*____****___
- * _____*******____
+ * ________________
+ * ________________
+ * __________*_____
+ * _________*______
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x70, 0xc0, 0x57, 0x08, 0x8d, 0x8d, 0x83, 0x0d, 0x0d, 0x05, 0x7d,
 	0x05, 0x00,
 /* [9]
  * ________________
- * ____________*___
  * ________________
- * ________***___*_
- * _______*___*____
- * ______*_*___*___
- * ______*_***_*___
- * ______*_*__**___
+ * ________________
+ * ________________
+ * ________***_____
+ * _______*_***____
  * _______*___*____
+ * _______*_**_____
  * ________***_____
- * _________****___
- * __*_____*_***___
- * ___*___*_****___
- * ____*_*__****___
- * ____****_****___
- * _____*******____
+ * ________________
+ * ________________
+ * _________*______
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x70, 0xfe, 0x04, 0xfb, 0x0f, 0xb0, 0xf6, 0x0d, 0x0c, 0x01, 0xf0,
 	0x91, 0xd0, 0x50,
 /* [10]
  * ________________
- * ______*_________
+ * ________________
+ * ________________
  * _________***____
- * ___*____*___*___
- * _______*_*___*__
- * _______*_***_*__
- * _______*_*__**__
+ * ________*_***___
  * ________*___*___
+ * ________*_**____
  * _________***____
- * __________**____
- * _________****___
- * __*_____*_***___
- * ___*___*_****___
- * ____*_*__****___
- * ____****_****___
- * _____*******____
+ * ________________
+ * ________________
+ * ________________
+ * _________*______
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x80, 0xc0, 0x57, 0x08, 0x8d, 0x8d, 0x83, 0x0d, 0x0c, 0x05, 0xd0,
 	0x60,
 /* [11]
- * _____________*__
+ * ________________
+ * ________________
  * ________________
  * _________***____
+ * ________*_***___
  * ________*___*___
- * _______*_*___*__
- * _______*_***_*__
- * _______*_*__**__
- * ________*___*___
+ * ________*_**____
  * _________***____
- * __________**____
- * _________*_**___
- * ___*____*_***___
- * ____*__*_****___
- * _____***_****___
- * ____*____****___
- * _____*******____
+ * ________________
+ * ________________
+ * __________*_____
+ * _________*______
+ * ________________
+ * ________________
+ * ________________
+ * ________________
  */
 	0xd0, 0x80, 0xc0, 0x57, 0x08, 0x8d, 0x8d, 0x83, 0x0d, 0x0c, 0x05, 0x7d,
 	0x05, 0x00,
@@ -4852,81 +4852,81 @@ const uint8_t arduboy_logo_img[146] PROGMEM = {
 
 /* assets/enemy_boss.png height = 32 width = 32 */
 const uint8_t enemy_boss_mask_img[475] PROGMEM = {
-	0x20, /* width */
-	0x20, /* height */
-	0x1a, 0x80, 0x42, 0x80, 0x6e, 0x80, 0x96, 0x80, 0xc3, 0x80, 0xeb, 0x80,
-	0x07, 0x81, 0x17, 0x81, 0x27, 0x81, 0x4b, 0x81, 0x7b, 0x81, 0xab, 0x81,
-/* [0]
- * ________________________________
- * ________________________________
- * ________________________________
- * ______________________**________
- * ____________________*****_______
- * _______****_______***_***_______
- * ______******_____***_*_***______
- * _____********____**_*_*_**______
- * _____*********____**_*_*_**_____
- * __________*****___***_*_*_*_____
- * _______**_******___***_*_***____
- * __________******___****_*_**____
- * ______********___**_**_*_*_**___
- * ______******___**___***_*_***___
- * _______***___**______***_***____
- * _______*___******____*****______
- * _________**____***____**________
- * _______***__**__**______________
- * _____****__****_**______________
- * ___**_****_****_**______________
- * _______*******__**______________
- * ________*****__**_______________
- * _________***__***_______________
- * __________*_*****_______________
- * __________*******_______________
- * _________********_______________
- * ________*********_______________
- * ________****_****_______________
- * _______***_____*****____________
- * _______***_____*****____________
- * _____*****________**____________
- * _____*****________**____________
- */
-	0xd1, 0x30, 0x62, 0xfa, 0x02, 0x6d, 0x0e, 0x0c, 0x04, 0x0e, 0x0a, 0x8a,
-	0x8e, 0x92, 0xf6, 0x08, 0xf3, 0x0d, 0x05, 0x01, 0xc0, 0x50, 0x21, 0x52,
-	0xa5, 0x52, 0xa4, 0xd0, 0xd0, 0x17, 0xc0, 0x60, 0xe8, 0x34, 0x16, 0x13,
-	0x31, 0xed, 0x30, 0x00,
-/* [1]
- * _____________________*__________
- * ___________________****_________
- * ________****_____*******________
- * _______******___********________
- * ______********__**_******_______
- * ______*********___*_*****_______
- * _________*******_*_*_*****______
- * _______*_********_*_*_****______
- * _________********_**_******_____
- * _______********___***_*****_____
- * _______******___**_*_*_*****____
- * ________***___**____*_*_***_____
- * ________*___**__**__**_**_______
- * __________**__*****__**_________
- * _______***_**__**_**____________
- * _____***__****_**_**____________
- * ____*****_****_**_**____________
- * ______*******__**_**____________
- * _______*****__**_***____________
- * ________***__******_____________
- * ____________******______________
- * ___________*******______________
- * ___________********_____________
- * ___________*****_**_____________
- * ___________*****_**_____________
- * ___________****_***_____________
- * ___________*******______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * _________*********______________
- * _________****_****______________
+	0x20, /* width */
+	0x20, /* height */
+	0x1a, 0x80, 0x42, 0x80, 0x6e, 0x80, 0x96, 0x80, 0xc3, 0x80, 0xeb, 0x80,
+	0x07, 0x81, 0x17, 0x81, 0x27, 0x81, 0x4b, 0x81, 0x7b, 0x81, 0xab, 0x81,
+/* [0]
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * _____________________*__________
+ * ____________________*_*_________
+ * ___________________*_*_*________
+ * ____________________*_*_*_______
+ * ______****___________*_*_*______
+ * ______*__*____________*_*_______
+ * ______****_____________*_*______
+ * ______________*_______*_*_*_____
+ * ____________***________*_*______
+ * __________***___________*_______
+ * ________***_____________________
+ * ________*__****_________________
+ * __________**__**________________
+ * _________**____*________________
+ * __________*____*________________
+ * ______________**________________
+ * _____________**_________________
+ * ____________**__________________
+ * ___________*____________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ */
+	0xd1, 0x30, 0x62, 0xfa, 0x02, 0x6d, 0x0e, 0x0c, 0x04, 0x0e, 0x0a, 0x8a,
+	0x8e, 0x92, 0xf6, 0x08, 0xf3, 0x0d, 0x05, 0x01, 0xc0, 0x50, 0x21, 0x52,
+	0xa5, 0x52, 0xa4, 0xd0, 0xd0, 0x17, 0xc0, 0x60, 0xe8, 0x34, 0x16, 0x13,
+	0x31, 0xed, 0x30, 0x00,
+/* [1]
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * __________________*_____________
+ * _________________*_*____________
+ * _______**_________*_*___________
+ * ________*__________*_*__________
+ * _______**___________*___________
+ * _______________*_____*__________
+ * _____________***____*_*_________
+ * ___________***__*____*_*________
+ * _________***__**______*_________
+ * _________*__**__________________
+ * _____________**__*______________
+ * ______________*__*______________
+ * ______________*__*______________
+ * _____________**__*______________
+ * ____________**__*_______________
+ * ___________**___________________
+ * ___________*____________________
+ * ________________________________
+ * ________________________________
+ * ________________*_______________
+ * ________________*_______________
+ * _______________*________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd0, 0x70, 0x29, 0xd0, 0x80, 0x8f, 0x50, 0xfa, 0x02, 0x6d, 0x11, 0x01,
 	0x1f, 0x30, 0x4c, 0x05, 0x18, 0x28, 0x6c, 0xd4, 0x16, 0x59, 0x00, 0xc0,
@@ -4936,35 +4936,35 @@ const uint8_t enemy_boss_mask_img[475] PROGMEM = {
  * ________________________________
  * ________________________________
  * ________________________________
- * ______________________**________
- * ____________________*****_______
- * _______****_______***_***_______
- * ______******_____***_*_***______
- * _____********____**_*_*_**______
- * _____*********____**_*_*_**_____
- * __________*****___***_*_*_*_____
- * _______**_******___***_*_***____
- * __________******___****_*_**____
- * ______********___**_**_*_*_**___
- * ______******___**___***_*_***___
- * _______***___**______***_***____
- * _______*___**__**____*****______
- * _________**_**__**____**________
- * _______**__****_**______________
- * _____****__****_**______________
- * ___**_********__**______________
- * _______******__***______________
- * ________****__***_______________
- * _________**__****_______________
- * ____________*****_______________
- * __________*******_______________
- * _________********_______________
- * _________*********______________
- * _________***_*****______________
- * _______***_____******___________
- * _______***_____******___________
- * _____****__________**___________
- * _____****__________**___________
+ * ________________________________
+ * ________________________________
+ * _____________________*__________
+ * ____________________*_*_________
+ * ___________________*_*_*________
+ * ____________________*_*_*_______
+ * ______****___________*_*_*______
+ * ______*__*____________*_*_______
+ * ______****_____________*_*______
+ * ______________*_______*_*_*_____
+ * ____________***________*_*______
+ * __________***___________*_______
+ * ________***__**_________________
+ * ________*__*__**________________
+ * _______________*________________
+ * _______________*________________
+ * ______________**________________
+ * _____________**_________________
+ * ____________**__________________
+ * ___________**___________________
+ * __________**____________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd1, 0x30, 0x62, 0xfa, 0x02, 0x6d, 0x0e, 0x0c, 0x04, 0x0e, 0x0a, 0x8a,
 	0x8e, 0x92, 0xc0, 0x36, 0x0a, 0x0b, 0x0d, 0x05, 0x01, 0xc0, 0x50, 0x21,
@@ -4972,75 +4972,75 @@ const uint8_t enemy_boss_mask_img[475] PROGMEM = {
 	0x19, 0x0f, 0xd3, 0x00,
 /* [3]
  * ________________________________
- * _____________________*__________
- * ________****_______****_________
- * _______******____***_***________
- * ______********__***_*_**________
- * ______*********_****_*_**_______
- * ___________****__****_*_*_______
- * _______***_*****_*****_*_*______
- * ___________*****__*****_**______
- * ______**********__****_*_**_____
- * ______*******___**_****_*_*_____
- * _______****___**___*****_***____
- * ________*___******__*******_____
- * __________***____**_*****_______
- * _______***_*__**__*__**_________
- * ______*****__****_*_____________
- * ____***_****_****_*_____________
- * __**_____*******__*_____________
- * __________*****__**_____________
- * ___________***__***_____________
- * _______________***______________
- * ___________*******______________
- * ___________********_____________
- * ___________********_____________
- * ___________********_____________
- * ___________********_____________
- * ___________**_****______________
- * ___________**_***_______________
- * ___________**_***_______________
- * ___________**_***_______________
- * _________****_***_______________
- * _________********_______________
+ * ________________________________
+ * ________________________________
+ * ____________________*___________
+ * ___________________*_*__________
+ * ____________________*_*_________
+ * ______*****__________*_*________
+ * ______*___*___________*_*_______
+ * ______*****____________*________
+ * ______________________*_*_______
+ * _____________***_______*_*______
+ * ___________***__________*_______
+ * _________***____________________
+ * _________*___****_______________
+ * ____________**__**______________
+ * ___________**____*______________
+ * ____________*____*______________
+ * ________________**______________
+ * _______________**_______________
+ * ______________**________________
+ * ___________****_________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd0, 0x60, 0x92, 0x22, 0x9d, 0x08, 0x04, 0xc0, 0x32, 0x85, 0x0a, 0x02,
 	0x6d, 0x0d, 0x01, 0x11, 0xc0, 0x83, 0x11, 0x19, 0x8c, 0x86, 0xc2, 0x42,
 	0x46, 0x09, 0xd0, 0x40, 0xc0, 0x30, 0x20, 0x50, 0xa7, 0xd1, 0x10, 0x4f,
 	0x11, 0x4c, 0x03, 0x18, 0x0c, 0x06, 0xbd, 0x2e, 0x00,
 /* [4]
- * _______________________**_______
- * _____________________*****______
- * ________****_______***_*_*______
- * _______******_____***_*_***_____
- * ______********____**_*_*_**_____
- * ______*********____**_*_*_**____
- * ______**********___***_*_*_*____
- * _______**********___*_*_*_***___
- * _______**********___**_*_*_**___
- * _______********___**_**_*_*_**__
- * _______******___**___***_*_***__
- * ________***___**______*_*_***___
- * ________*___**__*_____*****_____
- * __________**__****_____**_______
- * _______***_**__*_**_____________
- * _____***__****_*_**_____________
- * ____*****_****_*_**_____________
- * __**__*******__*_**_____________
- * _______*****__*_**______________
- * ________***__*****______________
- * ____________*****_______________
- * __________*******_______________
- * __________*******_______________
- * __________*******_______________
- * __________*******_______________
- * __________********______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * _________*********______________
- * _________****_****______________
+ * ________________________________
+ * ________________________________
+ * ______________________*_*_______
+ * _____________________*_*________
+ * ____________________*_*_*_______
+ * _____________________*_*_*______
+ * ______________________*_*_*_____
+ * _____________________*_*_*______
+ * ______________________*_*_*_____
+ * _______________*_______*_*_*____
+ * _____________***________*_*_____
+ * ___________***_________*_*______
+ * _________***__**________________
+ * _________*__**__________________
+ * __________*__**_*_______________
+ * ______________*_*_______________
+ * ______________*_*_______________
+ * _____________**_*_______________
+ * ____________**_*________________
+ * ___________**___________________
+ * __________**____________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd1, 0x40, 0x4c, 0x05, 0xa8, 0x54, 0xa8, 0x54, 0xa0, 0x2d, 0x0e, 0x0c,
 	0x07, 0x30, 0x50, 0x18, 0x28, 0x6c, 0xd4, 0x16, 0x9d, 0x05, 0x01, 0xc0,
@@ -5050,35 +5050,35 @@ const uint8_t enemy_boss_mask_img[475] PROGMEM = {
  * ________________________________
  * ________________________________
  * ________________________________
- * ______________****______________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  * _____________******_____________
- * ____________********____________
- * ___________*********____________
- * ___________**______*____________
- * __________***_**_*_*____________
- * __________***______*____________
- * __________**********____________
- * _____________*******____________
- * _________***___****_____________
- * ________******___*______________
- * ________***********_____________
- * _______****_*********___________
- * _______****_*********___________
- * _______******__*******__________
- * ________****_**__*_***__________
- * _______________**___***_________
- * ____________***__**_***__**_____
- * ____________*****__****_*****___
- * ____________*****_*__**_*******_
- * ____________*******____*********
- * ____________*******____*********
- * ___________********___*********_
- * ___________***__***___*********_
- * ___________***__****___*******__
- * ___________***___***_____*****__
- * ___________***___***_______**___
- * _________*****___****___________
- * _________*****___****___________
+ * _____________*__*_*_____________
+ * _____________******_____________
+ * ________________________________
+ * ___________**___________________
+ * ____________***_________________
+ * ______________***_*_____________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * _____________**_________________
+ * ____________*__**_*_____________
+ * ____________***__**_____________
+ * _______________**_______________
+ * _________________**_____________
+ * _________________*______________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd0, 0xd0, 0xd0, 0x66, 0xd1, 0x80, 0x5c, 0x07, 0x18, 0x13, 0x32, 0x22,
 	0x23, 0x02, 0x23, 0xd1, 0x90, 0xc0, 0x70, 0xc0, 0xa0, 0xa1, 0x41, 0x46,
@@ -5089,33 +5089,33 @@ const uint8_t enemy_boss_mask_img[475] PROGMEM = {
  * ________________________________
  * ________________________________
  * ________________________________
- * ____________****________________
- * ___________******_______________
- * __________********______________
- * __________*********_____________
- * __________**********____________
- * ___________**********___________
- * ___________**********___________
- * ___****____********_____________
- * __*____*___******__**___________
- * ____________***_******__________
- * ____________*___***_**__________
- * ___****_____**_*****_**_________
- * _**____**__***_*****_**_________
- * *________*_***_*******__________
- * __________***_*******___________
- * _____**___**_*******____________
- * ___*****_***********____________
- * _*******_**__****_**____________
- * *********____****_**_______*___*
- * *********____***_***_______*___*
- * _*********__*********_____*___*_
- * _*********__***___***____*____*_
- * __*******___***___***__**____*__
- * __*****_____***____***_____**___
- * ___**_______***____***___**_____
- * ___________****____****_________
- * ___________****____****_________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ___________________*____________
+ * _________________**_____________
+ * _______________*________________
+ * _____________***___*____________
+ * ______________*_________________
+ * ______________*_________________
+ * ______________*_________________
+ * _____________*__________________
+ * ________________________________
+ * ________________________________
+ * _________________*______________
+ * _________________*______________
+ * ________________*_______________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd2, 0xd0, 0x66, 0x90, 0x88, 0xf9, 0x0d, 0x19, 0x05, 0xa0, 0x09, 0xd1,
 	0xe0, 0x1d, 0x0f, 0x00,
@@ -5125,182 +5125,182 @@ const uint8_t enemy_boss_mask_img[475] PROGMEM = {
  * ________________________________
  * ________________________________
  * ________________________________
- * ____________****________________
- * ___________******_______________
- * __________********______________
- * __________*********_____________
- * __________**********____________
- * ___________**********___________
- * ____**_____**********___________
- * ___________********_____________
- * ___________******__**___________
- * ___****_____***_******__________
- * __*____*____*___***_**__________
- * ____________**_*****_**_________
- * ___________***_*****_**_________
- * ___________***_*******__________
- * __________***_*******___________
- * _____**___**_*******____________
- * ___*****_***********____________
- * _*******_**__****_**____________
- * *********____****_**____________
- * *********____***_***____________
- * _*********__*********___________
- * _*********__***___***___________
- * __*******___***___***__*________
- * __*****_____***____***_____**___
- * ___**_______***____***___**_____
- * ___________****____****_________
- * ___________****____****_________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ___________________*____________
+ * _________________**_____________
+ * _______________*________________
+ * _____________***___*____________
+ * ______________*_________________
+ * ______________*_________________
+ * ______________*_________________
+ * _____________*__________________
+ * ________________________________
+ * ________________________________
+ * _________________*______________
+ * _________________*______________
+ * ________________*_______________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd2, 0xd0, 0x66, 0x90, 0x88, 0xf9, 0x0d, 0x19, 0x05, 0xa0, 0x09, 0xd1,
 	0xe0, 0x1d, 0x0f, 0x00,
 /* [8]
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * __________________*_____________
+ * _________________*_*____________
+ * __________________*_*___________
+ * ___________________*_*__________
+ * ____________________*___________
  * _____________________*__________
- * ___________________****_________
- * _________________*******________
- * ________****____********________
- * _______******___**_******_______
- * ______********____*_*****_______
- * ______*********__*_*_*****______
- * ______**********__*_*_****______
- * _______**********_**_******_____
- * _______**********_***_*****_____
- * _______********_**_*_*_*****____
- * _______******_**____*_*_***_____
- * ________***_**__*___**_**_______
- * ________*_**__****___**_________
- * _______***_**__*_**_____________
- * _____***__****_*_**_____________
- * ____*****_****_*_**_____________
- * __**__*******__*_**_____________
- * _______*****__*_**______________
- * ________***__*****______________
- * ____________*****_______________
- * __________*******_______________
- * __________*****_*_______________
- * __________*****_*_______________
- * __________****_**_______________
- * __________********______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * _________*********______________
- * _________****_****______________
+ * _______________*____*_*_________
+ * _____________*_______*_*________
+ * ___________*__**______*_________
+ * _________*__**__________________
+ * __________*__**_*_______________
+ * ______________*_*_______________
+ * ______________*_*_______________
+ * _____________**_*_______________
+ * ____________**_*________________
+ * ___________**___________________
+ * __________**____________________
+ * ________________________________
+ * _______________*________________
+ * _______________*________________
+ * ______________*_________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd1, 0x10, 0x8f, 0x50, 0xfa, 0x02, 0x6d, 0x13, 0x08, 0x24, 0x8c, 0x03,
 	0x68, 0xd0, 0x14, 0x90, 0x00, 0xc0, 0x30, 0x50, 0xa1, 0x45, 0xd1, 0x20,
 	0x4c, 0x03, 0x18, 0x0c, 0x06, 0xbf, 0xc4, 0xbd, 0x1d, 0x01, 0xd1, 0x10,
 /* [9]
- * ______________________*_________
- * ____________________****________
- * ________****______***_***_______
- * _______******____***_*_**_______
- * ______********___****_*_**______
- * ______*********___****_*_*______
- * ______*______**___*****_*_*_____
- * ______*_*_**_***___*****_**_____
- * ______*______***___****_*_**____
- * ______**********__*_****_*_*____
- * ______*******___**__*****_***___
- * _______****___**_____*******____
- * ________*___**__*____*****______
- * __________**___***____**________
- * ________**__**__*_*_____________
- * ______***__****_*_*_____________
- * ____**_***_****_*_*_____________
- * _______*******__*_*_____________
- * ________*****__*_*______________
- * _________***__****______________
- * _____________****_______________
- * __________*******_______________
- * __________*****_*_______________
- * __________*****_*_______________
- * __________****_**_______________
- * __________********______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * _________*********______________
- * _________****_****______________
+ * ________________________________
+ * ________________________________
+ * _____________________*__________
+ * ____________________*_*_________
+ * _____________________*_*________
+ * ______________________*_*_______
+ * _______******__________*_*______
+ * _______*_*__*___________*_______
+ * _______******__________*_*______
+ * ________________________*_*_____
+ * _____________***_________*______
+ * ___________***__________________
+ * _________***__**________________
+ * _________*__***_________________
+ * __________**__**_*______________
+ * __________*____*_*______________
+ * __________*____*_*______________
+ * ______________**_*______________
+ * _____________**_*_______________
+ * ____________**__________________
+ * __________***___________________
+ * ________________________________
+ * _______________*________________
+ * _______________*________________
+ * ______________*_________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd0, 0x70, 0x92, 0x92, 0x29, 0xd0, 0x70, 0x5c, 0x04, 0x14, 0x28, 0x50,
 	0xa0, 0x2d, 0x0d, 0x01, 0x1c, 0x07, 0x31, 0xd1, 0x59, 0x29, 0x2c, 0x74,
 	0xd4, 0x09, 0xd0, 0x50, 0x1c, 0x03, 0x02, 0x05, 0x02, 0xd0, 0xf0, 0xf1,
 	0x14, 0xc0, 0x41, 0x80, 0xc0, 0x6c, 0x37, 0xbd, 0x1c, 0x01, 0xd1, 0x10,
 /* [10]
- * ______________________*_________
- * ____________________****________
- * __________________***_***_______
- * ________****_____***_*_**_______
- * _______******____****_*_**______
- * ______********____****_*_*______
- * ______*********___*****_*_*_____
- * ______*______**____*****_**_____
- * ______*_*_**_***___****_*_**____
- * ______*______***__*_****_*_*____
- * ______************__*****_***___
- * ______*******_**_____*******____
- * _______****_**__*____*****______
- * ________*_**__****____**________
- * ________**__**__*_*_____________
- * ______***__****_*_*_____________
- * ____**_***_****_*_*_____________
- * _______*******__*_*_____________
- * ________*****__*_*______________
- * _________***__****______________
- * _____________****_______________
- * __________*******_______________
- * __________*****_*_______________
- * __________*****_*_______________
- * __________****_**_______________
- * __________********______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * _________*********______________
- * _________****_****______________
+ * ________________________________
+ * ________________________________
+ * _____________________*__________
+ * ____________________*_*_________
+ * _____________________*_*________
+ * ______________________*_*_______
+ * _______________________*_*______
+ * _______******___________*_______
+ * _______*_*__*__________*_*______
+ * _______******___________*_*_____
+ * _________________________*______
+ * _____________*__________________
+ * ___________*__**________________
+ * _________*__**__________________
+ * __________**__**_*______________
+ * __________*____*_*______________
+ * __________*____*_*______________
+ * ______________**_*______________
+ * _____________**_*_______________
+ * ____________**__________________
+ * __________***___________________
+ * ________________________________
+ * _______________*________________
+ * _______________*________________
+ * ______________*_________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd0, 0x70, 0xd0, 0x66, 0xd0, 0x70, 0x5c, 0x04, 0x14, 0x28, 0x50, 0xa0,
 	0x2d, 0x0d, 0x0b, 0xc0, 0x80, 0x22, 0x3c, 0x25, 0x22, 0x32, 0x85, 0x0d,
 	0x00, 0x9d, 0x05, 0x01, 0xc0, 0x30, 0x20, 0x50, 0x2d, 0x0f, 0x0f, 0x11,
 	0x4c, 0x04, 0x18, 0x0c, 0x06, 0xc3, 0x7b, 0xd1, 0xc0, 0x1d, 0x11, 0x00,
 /* [11]
- * ______________________*_________
- * ____________________****________
- * ________****______***_***_______
- * _______******____***_*_**_______
- * ______********___****_*_**______
- * ______*********___****_*_*______
- * ______*______**___*****_*_*_____
- * ______*_*_**_***___*****_**_____
- * ______*______***___****_*_**____
- * ______**********__*_****_*_*____
- * ______*******___**__*****_***___
- * _______****___**_____*******____
- * ________*___**__*____*****______
- * __________**__****____**________
- * ________**__**__*_*_____________
- * ______***__****_*_*_____________
- * ____**_***_****_*_*_____________
- * _______*******__*_*_____________
- * ________*****__*_*______________
- * _________***__****______________
- * _____________****_______________
- * __________*******_______________
- * __________*****_*_______________
- * __________*****_*_______________
- * __________****_**_______________
- * __________********______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * ___________***_***______________
- * _________*********______________
- * _________****_****______________
+ * ________________________________
+ * ________________________________
+ * _____________________*__________
+ * ____________________*_*_________
+ * _____________________*_*________
+ * ______________________*_*_______
+ * _______******__________*_*______
+ * _______*_*__*___________*_______
+ * _______******__________*_*______
+ * ________________________*_*_____
+ * _____________***_________*______
+ * ___________***__________________
+ * _________***__**________________
+ * _________*__**__________________
+ * __________**__**_*______________
+ * __________*____*_*______________
+ * __________*____*_*______________
+ * ______________**_*______________
+ * _____________**_*_______________
+ * ____________**__________________
+ * __________***___________________
+ * ________________________________
+ * _______________*________________
+ * _______________*________________
+ * ______________*_________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
+ * ________________________________
  */
 	0xd0, 0x70, 0x92, 0x92, 0x29, 0xd0, 0x70, 0x5c, 0x04, 0x14, 0x28, 0x50,
 	0xa0, 0x2d, 0x0d, 0x01, 0x1c, 0x07, 0x31, 0xd1, 0x59, 0x29, 0x2c, 0x54,
@@ -5832,135 +5832,135 @@ const uint8_t powerups_mask_img[75] PROGMEM = {
 	0x1a, 0x00, 0x22, 0x80, 0x27, 0x80, 0x29, 0x80, 0x2e, 0x80, 0x32, 0x80,
 	0x34, 0x80, 0x36, 0x80, 0x38, 0x80, 0x3f, 0x80, 0x44, 0x80, 0x46, 0x80,
 /* [0]
+ * ________
  * ________
  * _**__**_
- * *__**__*
- * *______*
- * *______*
- * _*____*_
- * __*__*__
+ * _******_
+ * _******_
+ * __****__
  * ___**___
+ * ________
  */
 	0x00, 0x1c, 0x3c, 0x78, 0x78, 0x3c, 0x1c, 0x00,
 /* [1]
  * ________
- * ___**___
- * __*_**__
- * __*_**__
- * __*_**__
- * __*_**__
- * __*_*___
- * ___**___
+ * ________
+ * ___*____
+ * ___*____
+ * ___*____
+ * ___*____
+ * ___*____
+ * ________
  */
 	0x00, 0x0f, 0x7c, 0xd0, 0x40,
 /* [2]
  * ________
- * ___**___
- * ___**___
- * ___**___
- * ___**___
- * ___**___
- * ___**___
- * ___**___
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
  */
 	0xd0, 0x80,
 /* [3]
  * ________
- * ___**___
- * __**_*__
- * __**_*__
- * __**_*__
- * __**_*__
- * ___*_*__
- * ___**___
+ * ________
+ * ____*___
+ * ____*___
+ * ____*___
+ * ____*___
+ * ____*___
+ * ________
  */
 	0xd0, 0x40, 0xf7, 0xc0, 0x00,
 /* [4]
- * _*___*__
- * **___**_
- * __***___
- * _*_*_*__
- * _*****__
+ * ________
+ * ________
+ * ________
  * __*_*___
- * **___**_
- * _*___*__
+ * ________
+ * ________
+ * ________
+ * ________
  */
 	0x00, 0x50, 0x50, 0x00,
 /* [5]
- * ____*___
- * __*_*___
- * ___*____
- * __***___
- * __***___
- * ___*____
- * __*_*___
- * ____*___
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
  */
 	0xd0, 0x80,
 /* [6]
- * ___*____
- * ___*____
- * ___*____
- * ___*____
- * ___*____
- * ___*____
- * ___*____
- * ___*____
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
  */
 	0xd0, 0x80,
 /* [7]
- * __*_____
- * __*_*___
- * ___*____
- * __***___
- * __***___
- * ___*____
- * __*_*___
- * __*_____
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
  */
 	0xd0, 0x80,
 /* [8]
- * __****__
- * _***__*_
- * *****__*
- * ******_*
- * ******_*
- * ********
- * _******_
- * __****__
+ * ________
+ * ____**__
+ * _____**_
+ * ______*_
+ * ______*_
+ * ________
+ * ________
+ * ________
  */
 	0xd0, 0x40, 0xc0, 0x30, 0x20, 0x61, 0xc0,
 /* [9]
- * ___**___
- * ___**___
- * __**_*__
- * __**_*__
- * __****__
- * __****__
- * ___**___
- * ___**___
+ * ________
+ * ________
+ * ____*___
+ * ____*___
+ * ________
+ * ________
+ * ________
+ * ________
  */
 	0xd0, 0x40, 0xf0, 0xc0, 0x00,
 /* [10]
- * ___**___
- * ___**___
- * ___**___
- * ___**___
- * ___**___
- * ___**___
- * ___**___
- * ___**___
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
+ * ________
  */
 	0xd0, 0x80,
 /* [11]
- * ___**___
- * ___**___
- * __*_**__
- * __*_**__
- * __****__
- * __****__
- * ___**___
- * ___**___
+ * ________
+ * ________
+ * ___*____
+ * ___*____
+ * ________
+ * ________
+ * ________
+ * ________
  */
 	0x00, 0x0f, 0x0c, 0xd0, 0x40,
 };
@@ -6105,4 +6105,156 @@ const uint8_t menu_drops_img[82] PROGMEM = {
 	0x00, 0x2d, 0x04, 0x00,
 };
 
-/* total size 12600 bytes */
+/* assets/game_background_gray.png height = 46 width = 128 */
+const uint8_t game_background_gray_img[574] PROGMEM = {
+	0x80, /* width */
+	0x2e, /* height */
+	0x06, 0x80, 0x27, 0x81,
+/* [0]
+ * ********____*********_____________***********________*********************_________________*****************_____***********____
+ * ________*__*_________*___________**__________*______**____________________**______________**___*___________***__*___________*___
+ * _________**__________*__________**____________*____**______________________***_____*****_**___**______________**_____________***
+ * ______________________****_____*______________*__**__________________________**___**___***____*_________________________________
+ * __________________________*****_______________*_*_____________________________*****___________*_________________________________
+ * _______________________________________________*______________________________________________*_________________________________
+ * ______________________________________________________________________________________________*_________________________________
+ * _____________________________________________________________________________________________*__________________________________
+ * _____________________________________________________________________________________________*__________________________________
+ * _____________________________________________________________________________________________*__________________________________
+ * _____________________________________________________________________________________________*__________________________________
+ * ____________________________________________________________________________________________*___________________________________
+ * ___________________________________________________________________________________________*____________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * __________***___________________________________________________________________________________________________________________
+ * _________*___*__________________________________________________________________________________________________________________
+ * _________*****__________________________________________________________________________________________________________________
+ * _________________________________*****************_______________*****************_____________*****************________________
+ * __*****************______________*_**______*_*_*_*_______________*_**______*_*_*_*_____________*_**____________*________________
+ * __*_**_____*______*______________**_*______*__*_**_______________**_*______*__*_**_____________**_*____________*________________
+ * __**_*_____*______*______________*_**______*___*_*_______________*_**______*___*_*_____________*_**____________*________________
+ * __*_**_____*______*______________**_*_____**____**_______________**_*_____**____**_____________**_*____________*________________
+ * __**_*_____*______*______________*_**______*_____*_______________*_**______*_____*_____________*_**____________*________________
+ * __*_**_____*______*______________**_*______*_____*_______________**_*______*_____*_____________**_*____________*________________
+ * __**_*_____*______*______________*_**______*_____*_______________*_**______*_____*_____________*_**____________*________________
+ * __*_**_____*______*______________**_**************_______________**_**************_____________**_**************________________
+ * __**_*_____***____*______________*_*_____________*_______________*_*_____________*_____________*_*_____________*________________
+ * __*_**_____*_*____*______________****************________________****************______________****************_________________
+ * __**_*_____*______*_____________________________________________________________________________________________________________
+ * __*_**_____*______*_____________________________________________________________________________________________________________
+ * __**_*_____*______*_____________________________________________________________________________________________________________
+ * __*_**_____*______*_____________________________________________________________________________________________________________
+ * __**_**************_____________________________________________________________________________________________________________
+ * __*_*_____________*__________________________________*******_________________________________________________________*******____
+ * __**______________*__________________________________*_____*_________________________________________________________*_____*____
+ * ********************************************************************************************************************************
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * _______******________******________******________******________******________******________******________******________******___
+ */
+	0xd0, 0x81, 0xf0, 0x27, 0x7f, 0x02, 0xd0, 0x91, 0xf0, 0x6d, 0x04, 0x5d,
+	0x05, 0x45, 0x7f, 0x06, 0xbd, 0x0a, 0x1f, 0x02, 0xf1, 0xc8, 0x45, 0x57,
+	0xf0, 0x6b, 0xd1, 0x41, 0xf0, 0x2f, 0x06, 0x7f, 0x0c, 0xf1, 0x84, 0x44,
+	0xf1, 0x8f, 0x0c, 0x77, 0x7f, 0x0c, 0x5f, 0x0c, 0xf0, 0x6b, 0x1f, 0x81,
+	0xf7, 0xda, 0xd0, 0xb1, 0xbf, 0x02, 0xf0, 0x27, 0x7f, 0x02, 0xd0, 0xb1,
+	0xf0, 0x27, 0x77, 0xd5, 0xb0, 0x45, 0xad, 0x24, 0x0c, 0x04, 0xe0, 0xa0,
+	0x60, 0xe0, 0x88, 0x8c, 0x05, 0x2c, 0x2a, 0xea, 0x2a, 0x2c, 0xd0, 0x48,
+	0xfe, 0x0d, 0x0e, 0x0c, 0x04, 0xf0, 0x50, 0xb0, 0xf0, 0xd0, 0x64, 0xff,
+	0x04, 0xc0, 0x53, 0x05, 0x0b, 0x05, 0x0f, 0x0d, 0x0f, 0x0c, 0x04, 0xf0,
+	0x50, 0xb0, 0xf0, 0xd0, 0x64, 0xff, 0x04, 0xc0, 0x53, 0x05, 0x0b, 0x05,
+	0x0f, 0x0d, 0x0d, 0x0c, 0x04, 0xf0, 0x50, 0xb0, 0xf0, 0xd0, 0xc4, 0xff,
+	0x0d, 0x12, 0x03, 0xfa, 0xaf, 0x55, 0x3d, 0x05, 0x03, 0x8f, 0x60, 0xd0,
+	0x40, 0x3d, 0x0e, 0x0c, 0x11, 0x7f, 0x55, 0x6a, 0x5f, 0x50, 0x50, 0x50,
+	0x50, 0x50, 0x51, 0x5f, 0x50, 0x50, 0x50, 0x50, 0x51, 0x3f, 0xd0, 0xf0,
+	0xc1, 0x17, 0xf5, 0x56, 0xa5, 0xf5, 0x05, 0x05, 0x05, 0x05, 0x05, 0x15,
+	0xf5, 0x05, 0x05, 0x05, 0x05, 0x13, 0xfd, 0x0d, 0x0c, 0x11, 0x7f, 0x55,
+	0x6a, 0x5f, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50,
+	0x50, 0x50, 0x3f, 0xd1, 0x00, 0x22, 0xc1, 0x17, 0xf6, 0xa5, 0x54, 0xf4,
+	0x84, 0x84, 0x84, 0x84, 0x84, 0xf4, 0x84, 0x84, 0x84, 0x84, 0x84, 0x87,
+	0xfd, 0x22, 0x2c, 0x07, 0x70, 0x50, 0x50, 0x50, 0x50, 0x50, 0x70, 0xd3,
+	0x92, 0xc0, 0x77, 0x05, 0x05, 0x05, 0x05, 0x05, 0x07, 0x0d, 0x04, 0x2d,
+	0x07, 0x0d, 0x06, 0x8d, 0x08, 0x0d, 0x06, 0x8d, 0x08, 0x0d, 0x06, 0x8d,
+	0x08, 0x0d, 0x06, 0x8d, 0x08, 0x0d, 0x06, 0x8d, 0x08, 0x0d, 0x06, 0x8d,
+	0x08, 0x0d, 0x06, 0x8d, 0x08, 0x0d, 0x06, 0x8d, 0x08, 0x0d, 0x06, 0x80,
+	0x00,
+/* [1]
+ * ********____*********_____________***********________*********************_________________*****************_____***********____
+ * ________*__*_________*___________**__________*______**____________________**______________**___*___________***__*___________*___
+ * _________**__________*__________**____________*____**______________________***_____*****_**___**______________**_____________***
+ * ______________________****_____*______________*__**__________________________**___**___***____*_________________________________
+ * __________________________*****_______________*_*_____________________________*****___________*_________________________________
+ * _______________________________________________*______________________________________________*_________________________________
+ * ______________________________________________________________________________________________*_________________________________
+ * _____________________________________________________________________________________________*__________________________________
+ * _____________________________________________________________________________________________*__________________________________
+ * _____________________________________________________________________________________________*__________________________________
+ * _____________________________________________________________________________________________*__________________________________
+ * ____________________________________________________________________________________________*___________________________________
+ * ___________________________________________________________________________________________*____________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * ________________________________________________________________________________________________________________________________
+ * __________***___________________________________________________________________________________________________________________
+ * _________*___*__________________________________________________________________________________________________________________
+ * _________*****__________________________________________________________________________________________________________________
+ * _________________________________*****************_______________*****************_____________*****************________________
+ * __*****************______________*_**_************_______________*_**_************_____________*_**_************________________
+ * __*_***************______________**_*_************_______________**_*_************_____________**_*_************________________
+ * __**_**************______________*_**_************_______________*_**_************_____________*_**_************________________
+ * __*_***************______________**_*_************_______________**_*_************_____________**_*_************________________
+ * __**_**************______________*_**_************_______________*_**_************_____________*_**_************________________
+ * __*_***************______________**_*_************_______________**_*_************_____________**_*_************________________
+ * __**_**************______________*_**_************_______________*_**_************_____________*_**_************________________
+ * __*_***************______________**_**************_______________**_**************_____________**_**************________________
+ * __**_**************______________*_*_____________*_______________*_*_____________*_____________*_*_____________*________________
+ * __*_***************______________****************________________****************______________****************_________________
+ * __**_**************_____________________________________________________________________________________________________________
+ * __*_***************_____________________________________________________________________________________________________________
+ * __**_**************_____________________________________________________________________________________________________________
+ * __*_***************_____________________________________________________________________________________________________________
+ * __**_**************_____________________________________________________________________________________________________________
+ * __*_*_____________*__________________________________*******_________________________________________________________*******____
+ * __**______________*__________________________________*_____*_________________________________________________________*_____*____
+ * ********************************************************************************************************************************
+ * ********************************************************************************************************************************
+ * ********************************************************************************************************************************
+ * ********************************************************************************************************************************
+ * ********************************************************************************************************************************
+ * ********************************************************************************************************************************
+ * ********************************************************************************************************************************
+ * _______******________******________******________******________******________******________******________******________******___
+ */
+	0xd0, 0x81, 0xf0, 0x27, 0x7f, 0x02, 0xd0, 0x91, 0xf0, 0x6d, 0x04, 0x5d,
+	0x05, 0x45, 0x7f, 0x06, 0xbd, 0x0a, 0x1f, 0x02, 0xf1, 0xc8, 0x45, 0x57,
+	0xf0, 0x6b, 0xd1, 0x41, 0xf0, 0x2f, 0x06, 0x7f, 0x0c, 0xf1, 0x84, 0x44,
+	0xf1, 0x8f, 0x0c, 0x77, 0x7f, 0x0c, 0x5f, 0x0c, 0xf0, 0x6b, 0x1f, 0x81,
+	0xf7, 0xda, 0xd0, 0xb1, 0xbf, 0x02, 0xf0, 0x27, 0x7f, 0x02, 0xd0, 0xb1,
+	0xf0, 0x27, 0x77, 0xd5, 0xb0, 0x45, 0xad, 0x24, 0x0c, 0x11, 0xe0, 0xa0,
+	0x60, 0xe0, 0xe0, 0xe0, 0xe0, 0xec, 0xea, 0xea, 0xea, 0xec, 0xe0, 0xe0,
+	0xe0, 0xe0, 0xe0, 0xd0, 0xe0, 0xc0, 0x4f, 0x05, 0x0b, 0x0f, 0x04, 0xe0,
+	0xcf, 0x0d, 0x0f, 0x0c, 0x04, 0xf0, 0x50, 0xb0, 0xf0, 0x4e, 0x0c, 0xf0,
+	0xd0, 0xd0, 0xc0, 0x4f, 0x05, 0x0b, 0x0f, 0x04, 0xe0, 0xcf, 0x0d, 0x12,
+	0x03, 0xfa, 0xaf, 0x55, 0xd0, 0xe3, 0xd0, 0xe0, 0xc1, 0x17, 0xf5, 0x56,
+	0xa5, 0xf5, 0x05, 0xf5, 0xf5, 0xf5, 0xf5, 0xf5, 0xf5, 0xf5, 0xf5, 0xf5,
+	0xf5, 0xf3, 0xfd, 0x0f, 0x0c, 0x11, 0x7f, 0x55, 0x6a, 0x5f, 0x50, 0x5f,
+	0x5f, 0x5f, 0x5f, 0x5f, 0x5f, 0x5f, 0x5f, 0x5f, 0x5f, 0x5f, 0x3f, 0xd0,
+	0xd0, 0xc1, 0x17, 0xf5, 0x56, 0xa5, 0xf5, 0x05, 0xf5, 0xf5, 0xf5, 0xf5,
+	0xf5, 0xf5, 0xf5, 0xf5, 0xf5, 0xf5, 0xf3, 0xfd, 0x10, 0x09, 0x93, 0xc0,
+	0xfe, 0xad, 0x5c, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+	0xfc, 0xfc, 0xfc, 0xf3, 0xd2, 0x29, 0xc0, 0x7f, 0x0d, 0x0d, 0x0d, 0x0d,
+	0x0d, 0x0f, 0x0d, 0x39, 0x9c, 0x07, 0xf0, 0xd0, 0xd0, 0xd0, 0xd0, 0xd0,
+	0xf0, 0xd0, 0x49, 0xe0, 0x71, 0xfe, 0x06, 0x3f, 0xe0, 0x81, 0xfe, 0x06,
+	0x3f, 0xe0, 0x81, 0xfe, 0x06, 0x3f, 0xe0, 0x81, 0xfe, 0x06, 0x3f, 0xe0,
+	0x81, 0xfe, 0x06, 0x3f, 0xe0, 0x81, 0xfe, 0x06, 0x3f, 0xe0, 0x81, 0xfe,
+	0x06, 0x3f, 0xe0, 0x81, 0xfe, 0x06, 0x3f, 0xe0, 0x81, 0xfe, 0x06, 0x3f,
+	0xe0, 0x31, 0xf0,
+};
+
+/* total size 14140 bytes */
@@ -37,7 +37,8 @@ extern const uint8_t enemy_raider_img[418];
 extern const uint8_t powerups_img[108];
 extern const uint8_t powerups_mask_img[75];
 extern const uint8_t menu_drops_img[82];
+extern const uint8_t game_background_gray_img[574];
 
-/* total size 12600 bytes */
+/* total size 14140 bytes */
 
 #endif